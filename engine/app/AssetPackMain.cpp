@@ -0,0 +1,39 @@
+// Packs asset folders into the archive AssetFS maps at startup:
+//
+//   g++ -std=c++17 -O2 -Iengine/app/include
+//       engine/app/src/AssetArchive.cpp engine/app/AssetPackMain.cpp -o match_assetpack
+//   match_assetpack assets.pak assets_common assets_linux
+//
+// Files are named relative to their folder; later folders override earlier
+// ones.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "match/app/AssetArchive.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <out.pak> <asset dir>...\n", argv[0]);
+        return 2;
+    }
+    std::vector<std::filesystem::path> roots;
+    for (int i = 2; i < argc; ++i) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(argv[i], ec)) {
+            std::fprintf(stderr, "%s: not a directory: %s\n", argv[0], argv[i]);
+            return 1;
+        }
+        roots.emplace_back(argv[i]);
+    }
+
+    const auto sources = match::app::CollectAssetSources(roots);
+    std::string error;
+    if (!match::app::WriteAssetArchive(argv[1], sources, &error)) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], error.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "%s: packed %zu files\n", argv[1], sources.size());
+    return 0;
+}
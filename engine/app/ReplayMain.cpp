@@ -0,0 +1,94 @@
+// Headless replay checker. Links against engine/core only:
+//
+//   g++ -std=c++17 -O2 -pthread -Iengine/core/include
+//       engine/core/src/*.cpp engine/app/ReplayMain.cpp -o match_replay
+//   match_replay [--repeat N] last.mrpl...
+//
+// Reproduces each recorded game and checks it ends on the recorded board.
+// --repeat plays every file N times and reports the playback rate. Exits
+// with 1 when any replay diverges.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "match/core/Replay.hpp"
+
+namespace {
+
+bool ReadFile(const char* path, std::vector<std::uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int repeat = 1;
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        std::fprintf(stderr, "usage: %s [--repeat N] <replay>...\n", argv[0]);
+        return 2;
+    }
+
+    bool all_ok = true;
+    for (const char* path : paths) {
+        std::vector<std::uint8_t> bytes;
+        match::core::Replay replay;
+        std::string error;
+        if (!ReadFile(path, bytes)) {
+            std::fprintf(stderr, "%s: cannot read\n", path);
+            all_ok = false;
+            continue;
+        }
+        if (!match::core::DecodeReplay(bytes, replay, &error)) {
+            std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+            all_ok = false;
+            continue;
+        }
+
+        match::core::ReplayResult result;
+        double elapsed_ms = 0.0;
+        for (int run = 0; run < repeat; ++run) {
+            result = match::core::PlayReplay(replay);
+            elapsed_ms += result.elapsed_ms;
+        }
+
+        std::string scores;
+        for (std::size_t i = 0; i < result.scores.size(); ++i) {
+            const std::string name = i < replay.players.size() ? replay.players[i] : "Player " + std::to_string(i + 1);
+            scores += (i > 0 ? ", " : "") + name + " " + std::to_string(result.scores[i]);
+        }
+        const double moves = static_cast<double>(result.moves_played) * repeat;
+        std::printf("%s: %s, seed %u, %d/%zu moves, %s\n", path, replay.mode.c_str(), replay.seed,
+                    result.moves_played, replay.moves.size(), scores.c_str());
+        if (elapsed_ms > 0.0) {
+            std::printf("  %.0f moves/s over %d run(s)\n", moves * 1000.0 / elapsed_ms, repeat);
+        }
+        if (result.diverged_at >= 0) {
+            std::printf("  diverged: move %d is not a legal swap\n", result.diverged_at + 1);
+        } else if (!result.digest_matches) {
+            std::printf("  diverged: final board differs from the recording\n");
+        } else if (replay.final_digest == 0) {
+            std::printf("  recording has no final board to check\n");
+        }
+        all_ok = all_ok && result.ok();
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+// Headless AI-vs-AI batch runner for balance sweeps. Links against
+// engine/core only:
+//
+//   g++ -std=c++17 -O2 -pthread -Iengine/core/include
+//       engine/core/src/*.cpp engine/app/SelfPlayMain.cpp -o match_selfplay
+//
+// Per-game stats stream to stdout (or --out) as CSV or JSONL in game order;
+// a summary goes to stderr.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "match/core/Json.hpp"
+#include "match/core/SelfPlay.hpp"
+
+namespace {
+
+struct Options {
+    match::core::SelfPlayBatch batch;
+    std::vector<std::string> seat_ai = {"greedy"};
+    bool jsonl = false;
+    std::string out_path;
+};
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  --games N            games to play (default 1000)\n"
+                 "  --seed S             seed of game 0; game i uses S + i (default 1)\n"
+                 "  --players N          seats per game (default 2)\n"
+                 "  --rounds N           rounds per game (default 5)\n"
+                 "  --moves N            moves per player per round (default 3)\n"
+                 "  --order ORDER        consecutive | round-robin (default consecutive)\n"
+                 "  --cols N --rows N    board size (default 20x20)\n"
+                 "  --tiles N            tile types (default 6)\n"
+                 "  --no-bombs           disable bombs\n"
+                 "  --no-color           disable colour blasts\n"
+                 "  --ai LIST            comma-separated seat AIs: greedy, easy, normal, hard;\n"
+                 "                       the last entry repeats (default greedy)\n"
+                 "  --format FORMAT      csv | jsonl (default csv)\n"
+                 "  --out FILE           write stats to FILE instead of stdout\n",
+                 program);
+}
+
+bool ParseInt(const char* text, int& out) {
+    char* end = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool SeatPolicyFromName(const std::string& name, match::core::SeatPolicy& out) {
+    using match::core::ai::Difficulty;
+    out = {};
+    if (name == "greedy") {
+        return true;
+    }
+    if (name == "easy") {
+        out.search = match::core::ai::SearchOptionsFor(Difficulty::Easy);
+    } else if (name == "normal") {
+        out.search = match::core::ai::SearchOptionsFor(Difficulty::Normal);
+    } else if (name == "hard") {
+        out.search = match::core::ai::SearchOptionsFor(Difficulty::Hard);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseArgs(int argc, char** argv, Options& options) {
+    auto& batch = options.batch;
+    batch.games = 1000;
+    batch.rules.board.bombs_enabled = true;
+    batch.rules.board.color_chain_enabled = true;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        int value = 0;
+        if (arg == "--no-bombs") {
+            batch.rules.board.bombs_enabled = false;
+        } else if (arg == "--no-color") {
+            batch.rules.board.color_chain_enabled = false;
+        } else if (!has_value) {
+            return false;
+        } else if (arg == "--order") {
+            const std::string order = argv[++i];
+            if (order == "consecutive") {
+                batch.rules.turn_order = match::core::TurnOrder::Consecutive;
+            } else if (order == "round-robin") {
+                batch.rules.turn_order = match::core::TurnOrder::RoundRobin;
+            } else {
+                return false;
+            }
+        } else if (arg == "--ai") {
+            options.seat_ai = SplitList(argv[++i]);
+            if (options.seat_ai.empty()) {
+                return false;
+            }
+        } else if (arg == "--format") {
+            const std::string format = argv[++i];
+            if (format != "csv" && format != "jsonl") {
+                return false;
+            }
+            options.jsonl = format == "jsonl";
+        } else if (arg == "--out") {
+            options.out_path = argv[++i];
+        } else if (!ParseInt(argv[++i], value) || value < 0) {
+            return false;
+        } else if (arg == "--games") {
+            batch.games = static_cast<std::size_t>(value);
+        } else if (arg == "--seed") {
+            batch.first_seed = static_cast<std::uint32_t>(value);
+        } else if (arg == "--players") {
+            batch.rules.players = std::max(1, value);
+        } else if (arg == "--rounds") {
+            batch.rules.rounds = std::max(1, value);
+        } else if (arg == "--moves") {
+            batch.rules.moves_per_round = std::max(1, value);
+        } else if (arg == "--cols") {
+            batch.rules.board.cols = std::max(1, value);
+        } else if (arg == "--rows") {
+            batch.rules.board.rows = std::max(1, value);
+        } else if (arg == "--tiles") {
+            batch.rules.board.tile_types = std::max(1, value);
+        } else {
+            return false;
+        }
+    }
+
+    batch.seats.clear();
+    for (int seat = 0; seat < batch.rules.players; ++seat) {
+        const auto& name = options.seat_ai[std::min<std::size_t>(static_cast<std::size_t>(seat),
+                                                                 options.seat_ai.size() - 1)];
+        match::core::SeatPolicy policy;
+        if (!SeatPolicyFromName(name, policy)) {
+            return false;
+        }
+        batch.seats.push_back(policy);
+    }
+    return true;
+}
+
+std::string JoinScores(const std::vector<int>& scores) {
+    std::string joined;
+    for (std::size_t i = 0; i < scores.size(); ++i) {
+        if (i > 0) {
+            joined += ';';
+        }
+        joined += std::to_string(scores[i]);
+    }
+    return joined;
+}
+
+void WriteCsvHeader(std::ostream& out) {
+    out << "game,seed,scores,winner,rounds_played,moves,chains,longest_chain,tiles_cleared,"
+           "bombs_triggered,color_chains,best_move_score,stalled,elapsed_ms\n";
+}
+
+void WriteCsvRow(std::ostream& out, const match::core::SelfPlayGame& game) {
+    out << game.index << ',' << game.seed << ',' << JoinScores(game.scores) << ',' << game.winner << ','
+        << game.rounds_played << ',' << game.moves << ',' << game.chains << ',' << game.longest_chain
+        << ',' << game.tiles_cleared << ',' << game.bombs_triggered << ',' << game.color_chains << ','
+        << game.best_move_score << ',' << (game.stalled ? 1 : 0) << ',' << game.elapsed_ms << '\n';
+}
+
+void WriteJsonLine(std::ostream& out, const match::core::SelfPlayGame& game) {
+    match::core::Json json;
+    json["game"] = game.index;
+    json["seed"] = game.seed;
+    json["scores"] = game.scores;
+    json["winner"] = game.winner;
+    json["rounds_played"] = game.rounds_played;
+    json["moves"] = game.moves;
+    json["chains"] = game.chains;
+    json["longest_chain"] = game.longest_chain;
+    json["tiles_cleared"] = game.tiles_cleared;
+    json["bombs_triggered"] = game.bombs_triggered;
+    json["color_chains"] = game.color_chains;
+    json["best_move_score"] = game.best_move_score;
+    json["stalled"] = game.stalled;
+    json["elapsed_ms"] = game.elapsed_ms;
+    out << json.dump() << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::ofstream file;
+    if (!options.out_path.empty()) {
+        file.open(options.out_path, std::ios::out | std::ios::trunc);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", options.out_path.c_str());
+            return 1;
+        }
+    }
+    std::ostream& out = options.out_path.empty() ? std::cout : file;
+    if (!options.jsonl) {
+        WriteCsvHeader(out);
+    }
+
+    const auto& batch = options.batch;
+    std::vector<long long> total_scores(static_cast<std::size_t>(batch.rules.players), 0);
+    std::vector<std::size_t> wins(static_cast<std::size_t>(batch.rules.players), 0);
+    std::size_t ties = 0;
+    std::size_t stalled = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    match::core::RunSelfPlayBatch(batch, [&](const match::core::SelfPlayGame& game) {
+        if (options.jsonl) {
+            WriteJsonLine(out, game);
+        } else {
+            WriteCsvRow(out, game);
+        }
+        for (std::size_t seat = 0; seat < game.scores.size(); ++seat) {
+            total_scores[seat] += game.scores[seat];
+        }
+        if (game.winner >= 0) {
+            ++wins[static_cast<std::size_t>(game.winner)];
+        } else {
+            ++ties;
+        }
+        stalled += game.stalled ? 1 : 0;
+    });
+    out.flush();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double games = static_cast<double>(std::max<std::size_t>(1, batch.games));
+    std::fprintf(stderr, "%zu games in %.2fs (%.0f games/s), %zu ties, %zu stalled\n", batch.games,
+                 seconds, seconds > 0.0 ? static_cast<double>(batch.games) / seconds : 0.0, ties, stalled);
+    for (std::size_t seat = 0; seat < total_scores.size(); ++seat) {
+        std::fprintf(stderr, "  seat %zu (%s): mean score %.1f, win rate %.1f%%\n", seat,
+                     options.seat_ai[std::min(seat, options.seat_ai.size() - 1)].c_str(),
+                     static_cast<double>(total_scores[seat]) / games,
+                     100.0 * static_cast<double>(wins[seat]) / games);
+    }
+    return out ? 0 : 1;
+}
@@ -6,15 +6,18 @@
 #include <cmath>
 #include <cctype>
 #include <cstdint>
+#include <cstdio>
 #include <ctime>
 #include <limits>
 #include <iomanip>
+#include <iterator>
 #include <filesystem>
+#include <fstream>
 #include <map>
+#include <memory>
 #include <optional>
 #include <random>
 #include <numeric>
-#include <set>
 #include <string>
 #include <sstream>
 #include <utility>
@@ -27,17 +30,28 @@
 #include <SDL2/SDL_image.h>
 
 #include "match/core/Board.hpp"
+#include "match/core/BoardPool.hpp"
 #include "match/core/AI.hpp"
-#include "match/core/SavePayload.hpp"
+#include "match/core/AllocTracker.hpp"
+#include "match/core/AsyncSearch.hpp"
+#include "match/core/LegalMoveIndex.hpp"
+#include "match/core/MatchSession.hpp"
+#include "match/core/Profiler.hpp"
+#include "match/core/Replay.hpp"
+#include "match/core/SaveGame.hpp"
 #include "match/app/AssetFS.hpp"
+#include "match/app/FrameScheduler.hpp"
 #include "match/platform/AudioSystem.hpp"
 #include "match/platform/SdlInput.hpp"
 #include "match/platform/SdlSaveService.hpp"
+#include "match/render/FontLibrary.hpp"
+#include "match/render/RetainedTarget.hpp"
 #include "match/render/SceneRenderer.hpp"
+#include "match/render/TextCache.hpp"
+#include "match/render/TextureStats.hpp"
 #include "match/ui/Screens.hpp"
 
-using match::app::AssetPath;
-using match::app::FileExists;
+using match::app::OpenAsset;
 using match::platform::AudioSystem;
 using match::platform::SdlInput;
 using match::platform::InputEventType;
@@ -45,18 +59,19 @@ using match::platform::MouseButton;
 using match::platform::KeyCode;
 using match::platform::ControllerButton;
 using match::platform::ControllerAxis;
-using match::render::LoadFonts;
-using match::render::DestroyFonts;
+using match::render::FontLibrary;
 using match::render::ComputeLayout;
 using match::render::Animation;
+using match::render::AnimationPool;
+using match::render::HiddenCells;
 using match::render::MakeSwapAnimation;
 using match::render::MakePopAnimation;
 using match::render::MakeFallAnimation;
 using match::render::MakeSpawnAnimation;
 using match::render::UpdateAnimations;
-using match::render::DrawBoard;
-using match::render::DrawAnimations;
+using match::render::DrawBoardScene;
 using match::render::DrawPanel;
+using match::render::ReleasePanelCache;
 using match::render::BoardRenderData;
 using match::render::PanelInfo;
 using match::render::PanelPlayerEntry;
@@ -72,6 +87,9 @@ struct GameContext;
 
 constexpr int kBoardCols = 20;
 constexpr int kBoardRows = 20;
+// Bounds for `--board`.
+constexpr int kMinBoardSide = 4;
+constexpr int kMaxBoardSide = 512;
 
 constexpr int kLogicalWidth = 1920;
 constexpr int kLogicalHeight = 1080;
@@ -246,30 +264,89 @@ int DrawTextCentered(SDL_Renderer* renderer,
     if (!font || text.empty()) {
         return 0;
     }
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surface) {
-        return 0;
+    const auto line = match::render::SharedTextCache().get(renderer, font, text, color);
+    if (line.texture) {
+        SDL_Rect dst;
+        dst.w = line.w;
+        dst.h = line.h;
+        dst.x = center_x - dst.w / 2;
+        dst.y = y;
+        SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
     }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        int height = surface->h;
-        SDL_FreeSurface(surface);
-        return height;
-    }
-    SDL_Rect dst;
-    dst.w = surface->w;
-    dst.h = surface->h;
-    dst.x = center_x - dst.w / 2;
-    dst.y = y;
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    int height = surface->h;
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
-    return height;
+    return line.h;
 }
 
 std::string ActivePlayerLabel(const GameContext& ctx);
 int ActivePlayerMoves(const GameContext& ctx);
+
+#if MATCH_PROFILING
+// F3 overlay: frame time first, then every timed phase with its average and
+// 99th percentile over the profiler's recent window, then heap and texture
+// counts. frame_allocs is the last frame's allocation count.
+void DrawProfilerHud(SDL_Renderer* renderer, const Fonts& fonts, std::uint64_t frame_allocs) {
+    TTF_Font* font = fonts.small ? fonts.small : fonts.body;
+    if (!font) {
+        return;
+    }
+    const auto stats = match::core::Profiler::Instance().phaseStats();
+    std::vector<std::string> lines;
+    lines.reserve(stats.size() + 3 + match::core::kAllocDomainCount);
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "%-20s %8s %8s", "phase (F4 dumps)", "avg ms", "p99 ms");
+    lines.emplace_back(buffer);
+    for (const auto& phase : stats) {
+        std::snprintf(buffer, sizeof(buffer), "%-20s %8.2f %8.2f", phase.name.c_str(), phase.average_ms,
+                      phase.p99_ms);
+        lines.emplace_back(buffer);
+    }
+
+    const auto textures = match::render::TextureStats();
+    std::snprintf(buffer, sizeof(buffer), "%-20s %8lld %8llu", "textures live/made",
+                  static_cast<long long>(textures.live), static_cast<unsigned long long>(textures.created));
+    lines.emplace_back(buffer);
+    if (match::core::kAllocTracking) {
+        std::snprintf(buffer, sizeof(buffer), "%-20s %8llu", "allocs/frame",
+                      static_cast<unsigned long long>(frame_allocs));
+        lines.emplace_back(buffer);
+        for (std::size_t i = 0; i < match::core::kAllocDomainCount; ++i) {
+            const auto domain = static_cast<match::core::AllocDomain>(i);
+            const auto counters = match::core::AllocStats(domain);
+            std::snprintf(buffer, sizeof(buffer), "  %-18s %8llu %6lld KB", match::core::AllocDomainName(domain),
+                          static_cast<unsigned long long>(counters.allocations),
+                          static_cast<long long>(counters.live_bytes / 1024));
+            lines.emplace_back(buffer);
+        }
+    } else {
+        lines.emplace_back("allocs/frame: build with MATCH_ALLOC_TRACKING=1");
+    }
+
+    const int line_h = TTF_FontLineSkip(font);
+    int width = 0;
+    for (const auto& line : lines) {
+        width = std::max(width, MeasureText(font, line).first);
+    }
+    const int pad = 8;
+    SDL_Rect backdrop{pad, pad, width + 2 * pad, line_h * static_cast<int>(lines.size()) + 2 * pad};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 190);
+    SDL_RenderFillRect(renderer, &backdrop);
+    int y = backdrop.y + pad;
+    for (const auto& line : lines) {
+        // Numbers change every frame, so these bypass the text cache.
+        SDL_Surface* surface = TTF_RenderUTF8_Blended(font, line.c_str(), SDL_Color{200, 255, 200, 255});
+        if (surface) {
+            SDL_Texture* texture = match::render::CreateTextureFromSurface(renderer, surface);
+            if (texture) {
+                SDL_Rect dst{backdrop.x + pad, y, surface->w, surface->h};
+                SDL_RenderCopy(renderer, texture, nullptr, &dst);
+                match::render::DestroyTexture(texture);
+            }
+            SDL_FreeSurface(surface);
+        }
+        y += line_h;
+    }
+}
+#endif
 std::string WinnersSubtitle(const GameContext& ctx);
 void AnnounceRoundStart(const GameContext& ctx);
 void AnnounceTurnStart(const GameContext& ctx);
@@ -295,10 +372,8 @@ void DrawBanner(SDL_Renderer* renderer,
         return;
     }
 
-    const float board_width = layout.cell_size * kBoardCols;
-    const float board_height = layout.cell_size * kBoardRows;
-    const float center_x = layout.board_left + board_width * 0.5f;
-    const float center_y = layout.board_top + board_height * 0.5f;
+    const float center_x = layout.view_left + layout.view_width * 0.5f;
+    const float center_y = layout.view_top + layout.view_height * 0.5f;
 
     TTF_Font* title_font = fonts.heading ? fonts.heading : fonts.body;
     TTF_Font* subtitle_font = fonts.body ? fonts.body : fonts.heading;
@@ -339,8 +414,8 @@ void DrawBanner(SDL_Renderer* renderer,
 
     SDL_Rect rect;
     rect.w = std::clamp(content_width + padding * 2,
-                        static_cast<int>(board_width * 0.4f),
-                        static_cast<int>(board_width * 0.9f));
+                        static_cast<int>(layout.view_width * 0.4f),
+                        static_cast<int>(layout.view_width * 0.9f));
     rect.h = std::max(dynamic_height + padding * 2,
                       static_cast<int>(layout.cell_size * 2.0f));
     rect.x = static_cast<int>(center_x - rect.w / 2.0f);
@@ -539,11 +614,11 @@ void ApplyWindowIcon(SDL_Window* window) {
     }
     const char* last_error = nullptr;
     auto try_load = [&](const std::string& name) -> SDL_Surface* {
-        std::filesystem::path path = AssetPath(name);
-        if (!FileExists(path)) {
+        SDL_RWops* stream = OpenAsset(name);
+        if (!stream) {
             return nullptr;
         }
-        SDL_Surface* surf = IMG_Load(path.string().c_str());
+        SDL_Surface* surf = IMG_Load_RW(stream, 1);
         if (!surf) {
             last_error = IMG_GetError();
         }
@@ -578,6 +653,10 @@ bool CellFromPoint(const Layout& layout,
                    int x,
                    int y,
                    match::core::Cell& out) {
+    if (x < layout.view_left || y < layout.view_top || x >= layout.view_left + layout.view_width ||
+        y >= layout.view_top + layout.view_height) {
+        return false;
+    }
     const float rel_x = static_cast<float>(x) - layout.board_left;
     const float rel_y = static_cast<float>(y) - layout.board_top;
     if (rel_x < 0.0f || rel_y < 0.0f) {
@@ -610,6 +689,7 @@ struct GameContext {
     std::string turn_order = "Consecutive";
     bool bombs_enabled = true;
     bool color_blast_enabled = true;
+    match::ui::AiDifficultyOption ai_difficulty = match::ui::AiDifficultyOption::Normal;
     int active_player = 0;
     int total_moves = 0;
     bool game_over = false;
@@ -623,6 +703,8 @@ struct GameContext {
     bool autosave_dirty = false;
     float autosave_cooldown_ms = 0.0f;
     bool loaded_from_save = false;
+    // Moves of the game in progress; idle for games resumed from a save.
+    match::core::ReplayRecorder replay;
     match::ui::TimeModeOption time_mode = match::ui::TimeModeOption::Classic;
     int blitz_turn_minutes = 2;
     int blitz_between_seconds = 10;
@@ -965,28 +1047,6 @@ void ResetMovesForNewRound(GameContext& ctx) {
               ctx.moves_per_round_setting);
 }
 
-bool RoundComplete(const GameContext& ctx) {
-    if (ctx.moves_left_per_player.empty()) {
-        return true;
-    }
-    return std::all_of(ctx.moves_left_per_player.begin(), ctx.moves_left_per_player.end(),
-                       [](int value) { return value <= 0; });
-}
-
-int NextPlayerWithMoves(const GameContext& ctx, int from_player) {
-    if (ctx.moves_left_per_player.empty() || ctx.players_count <= 0) {
-        return -1;
-    }
-    const int count = std::min<int>(ctx.players_count, static_cast<int>(ctx.moves_left_per_player.size()));
-    for (int step = 1; step <= count; ++step) {
-        int candidate = (from_player + step) % count;
-        if (ctx.moves_left_per_player[static_cast<std::size_t>(candidate)] > 0) {
-            return candidate;
-        }
-    }
-    return -1;
-}
-
 std::string BuildGameOverStatus(const GameContext& ctx) {
     if (ctx.player_scores.empty() || ctx.player_names.empty()) {
         return "Game over";
@@ -1033,6 +1093,34 @@ void SyncTurnOrderLabel(GameContext& ctx) {
     ctx.turn_order = TurnOrderToString(ctx.turn_order_mode);
 }
 
+match::core::MatchRules MatchRulesForContext(const GameContext& ctx) {
+    match::core::MatchRules rules;
+    rules.players = ctx.players_count;
+    rules.rounds = ctx.round_total;
+    rules.moves_per_round = ctx.moves_per_round_setting;
+    rules.turn_order = ctx.turn_order_mode == match::ui::TurnOrderOption::RoundRobin
+                           ? match::core::TurnOrder::RoundRobin
+                           : match::core::TurnOrder::Consecutive;
+    return rules;
+}
+
+// Passes the turn on by the core rules, the same ones hosted and self-play
+// sessions follow, and refreshes the status line.
+void EndActiveTurn(GameContext& ctx, bool forfeit) {
+    SyncPlayerVectors(ctx);
+    match::core::TurnState turns;
+    turns.round = ctx.round_current;
+    turns.active_player = ctx.active_player;
+    turns.moves_left = std::move(ctx.moves_left_per_player);
+    turns.game_over = ctx.game_over;
+    match::core::EndTurn(MatchRulesForContext(ctx), turns, forfeit);
+    ctx.round_current = turns.round;
+    ctx.active_player = turns.active_player;
+    ctx.moves_left_per_player = std::move(turns.moves_left);
+    ctx.game_over = turns.game_over;
+    ctx.status = BuildTurnStatus(ctx);
+}
+
 void UpdateAiPending(GameContext& ctx) {
     if (ctx.game_over) {
         ctx.ai_pending = false;
@@ -1254,6 +1342,118 @@ std::string GameModeToken(match::ui::GameMode mode) {
     return "unknown";
 }
 
+std::string DifficultyToken(match::ui::AiDifficultyOption difficulty) {
+    switch (difficulty) {
+        case match::ui::AiDifficultyOption::Easy:
+            return "easy";
+        case match::ui::AiDifficultyOption::Normal:
+            return "normal";
+        case match::ui::AiDifficultyOption::Hard:
+            return "hard";
+    }
+    return "normal";
+}
+
+match::ui::AiDifficultyOption DifficultyFromToken(const std::string& token) {
+    if (token == "easy") {
+        return match::ui::AiDifficultyOption::Easy;
+    }
+    if (token == "hard") {
+        return match::ui::AiDifficultyOption::Hard;
+    }
+    return match::ui::AiDifficultyOption::Normal;
+}
+
+match::core::ai::SearchOptions SearchOptionsForDifficulty(match::ui::AiDifficultyOption difficulty) {
+    switch (difficulty) {
+        case match::ui::AiDifficultyOption::Easy:
+            return match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Easy);
+        case match::ui::AiDifficultyOption::Normal:
+            return match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Normal);
+        case match::ui::AiDifficultyOption::Hard:
+            return match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Hard);
+    }
+    return match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Normal);
+}
+
+// Background search for the computer's next move. The pending result is tied
+// to the board it was started from, so a search launched speculatively while
+// a cascade plays out is only used if the computer ends up facing that board.
+struct AiWorkState {
+    std::unique_ptr<match::core::ai::AsyncMoveSearch> search;
+    std::shared_future<match::core::ai::AsyncSearchResult> pending;
+    match::core::Board snapshot;
+};
+
+AiWorkState g_ai_work;
+
+bool HasComputerPlayer(const GameContext& ctx) {
+    for (int i = 0; i < static_cast<int>(ctx.player_names.size()); ++i) {
+        if (IsComputerPlayer(ctx, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SameCells(const match::core::Board& a, const match::core::Board& b) {
+    if (a.cols() != b.cols() || a.rows() != b.rows()) {
+        return false;
+    }
+    for (int col = 0; col < a.cols(); ++col) {
+        for (int row = 0; row < a.rows(); ++row) {
+            if (a.get(col, row) != b.get(col, row)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void StartAiSearch(const match::core::Board& board,
+                   const match::core::LegalMoveIndex& legal_moves,
+                   const GameContext& ctx) {
+    if (!g_ai_work.search) {
+        g_ai_work.search = std::make_unique<match::core::ai::AsyncMoveSearch>();
+    }
+    g_ai_work.snapshot = board;
+    g_ai_work.pending = g_ai_work.search->start(board, legal_moves,
+                                                SearchOptionsForDifficulty(ctx.ai_difficulty));
+}
+
+void CancelAiSearch() {
+    if (g_ai_work.search) {
+        g_ai_work.search->cancel();
+    }
+    g_ai_work.pending = {};
+}
+
+// Makes sure a search for board is running and reports whether its result is
+// ready to take.
+bool PollAiSearch(const match::core::Board& board,
+                  const match::core::LegalMoveIndex& legal_moves,
+                  const GameContext& ctx) {
+    MATCH_PROFILE_SCOPE("update.ai_poll");
+    if (!g_ai_work.pending.valid() || !SameCells(g_ai_work.snapshot, board)) {
+        StartAiSearch(board, legal_moves, ctx);
+        return false;
+    }
+    if (g_ai_work.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    if (g_ai_work.pending.get().cancelled) {
+        StartAiSearch(board, legal_moves, ctx);
+        return false;
+    }
+    return true;
+}
+
+std::optional<match::core::ai::BestMoveResult> TakeAiSearchResult() {
+    auto best = g_ai_work.pending.get().best;
+    g_ai_work.pending = {};
+    return best;
+}
+
 match::ui::GameMode GameModeFromToken(const std::string& token) {
     std::string lower = token;
     std::transform(lower.begin(), lower.end(), lower.begin(),
@@ -1267,52 +1467,41 @@ match::ui::GameMode GameModeFromToken(const std::string& token) {
     return match::ui::GameMode::PvC;
 }
 
-match::core::Json SerializeGameSettings(const match::ui::GameSettings& settings) {
-    match::core::Json json = match::core::Json::object();
-    json["mode"] = GameModeToken(settings.mode);
-    json["player_count"] = settings.player_count;
-    json["player_names"] = settings.player_names;
-    json["turn_order"] = TurnOrderToString(settings.turn_order);
-    json["moves_per_round"] = settings.moves_per_round;
-    json["total_rounds"] = settings.total_rounds;
-    json["bombs_enabled"] = settings.bombs_enabled;
-    json["color_blast_enabled"] = settings.color_blast_enabled;
-    json["time_mode"] =
+match::core::SaveSettings SerializeGameSettings(const match::ui::GameSettings& settings) {
+    match::core::SaveSettings saved;
+    saved.mode = GameModeToken(settings.mode);
+    saved.player_count = settings.player_count;
+    saved.player_names = settings.player_names;
+    saved.turn_order = TurnOrderToString(settings.turn_order);
+    saved.moves_per_round = settings.moves_per_round;
+    saved.total_rounds = settings.total_rounds;
+    saved.bombs_enabled = settings.bombs_enabled;
+    saved.color_blast_enabled = settings.color_blast_enabled;
+    saved.time_mode =
         (settings.time_mode == match::ui::TimeModeOption::Classic) ? "classic" : "blitz";
-    json["blitz_turn_minutes"] = settings.blitz_turn_minutes;
-    json["blitz_between_seconds"] = settings.blitz_between_seconds;
-    return json;
+    saved.blitz_turn_minutes = settings.blitz_turn_minutes;
+    saved.blitz_between_seconds = settings.blitz_between_seconds;
+    saved.ai_difficulty = DifficultyToken(settings.ai_difficulty);
+    return saved;
 }
 
-match::ui::GameSettings DeserializeGameSettings(const match::core::Json& json,
-                                                const match::ui::GameSettings& defaults) {
-    match::ui::GameSettings settings = defaults;
-    if (json.contains("mode") && json["mode"].is_string()) {
-        settings.mode = GameModeFromToken(json["mode"].get<std::string>());
-    }
-    settings.player_count = json.value("player_count", settings.player_count);
-    if (json.contains("player_names") && json["player_names"].is_array()) {
-        settings.player_names = json["player_names"].get<std::vector<std::string>>();
-    }
-    std::string order =
-        json.value("turn_order", TurnOrderToString(settings.turn_order));
-    settings.turn_order = TurnOrderFromString(order);
-    settings.moves_per_round = json.value("moves_per_round", settings.moves_per_round);
-    settings.total_rounds = json.value("total_rounds", settings.total_rounds);
-    settings.bombs_enabled = json.value("bombs_enabled", settings.bombs_enabled);
-    settings.color_blast_enabled =
-        json.value("color_blast_enabled", settings.color_blast_enabled);
-    std::string time_mode =
-        json.value("time_mode",
-                   (settings.time_mode == match::ui::TimeModeOption::Classic) ? "classic"
-                                                                              : "blitz");
-    settings.time_mode =
-        (time_mode == "blitz") ? match::ui::TimeModeOption::Blitz
-                               : match::ui::TimeModeOption::Classic;
-    settings.blitz_turn_minutes =
-        json.value("blitz_turn_minutes", settings.blitz_turn_minutes);
-    settings.blitz_between_seconds =
-        json.value("blitz_between_seconds", settings.blitz_between_seconds);
+match::ui::GameSettings DeserializeGameSettings(const match::core::SaveSettings& saved) {
+    match::ui::GameSettings settings;
+    settings.mode = GameModeFromToken(saved.mode);
+    settings.player_count = saved.player_count;
+    if (!saved.player_names.empty()) {
+        settings.player_names = saved.player_names;
+    }
+    settings.turn_order = TurnOrderFromString(saved.turn_order);
+    settings.moves_per_round = saved.moves_per_round;
+    settings.total_rounds = saved.total_rounds;
+    settings.bombs_enabled = saved.bombs_enabled;
+    settings.color_blast_enabled = saved.color_blast_enabled;
+    settings.time_mode = (saved.time_mode == "blitz") ? match::ui::TimeModeOption::Blitz
+                                                      : match::ui::TimeModeOption::Classic;
+    settings.blitz_turn_minutes = saved.blitz_turn_minutes;
+    settings.blitz_between_seconds = saved.blitz_between_seconds;
+    settings.ai_difficulty = DifficultyFromToken(saved.ai_difficulty);
     settings.EnsureConstraints();
     return settings;
 }
@@ -1365,24 +1554,24 @@ struct IntroState {
 
 void DestroyIntroResources(IntroState& state) {
     if (state.logo_texture) {
-        SDL_DestroyTexture(state.logo_texture);
+        match::render::DestroyTexture(state.logo_texture);
         state.logo_texture = nullptr;
     }
 }
 
 void TryLoadIntroLogo(SDL_Renderer* renderer, IntroState& state) {
-    std::filesystem::path logo_path = AssetPath("logo.png");
-    if (!FileExists(logo_path)) {
+    SDL_RWops* logo_stream = OpenAsset("logo.png");
+    if (!logo_stream) {
         state.active = false;
         return;
     }
-    SDL_Surface* surface = IMG_Load(logo_path.string().c_str());
+    SDL_Surface* surface = IMG_Load_RW(logo_stream, 1);
     if (!surface) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to load logo.png: %s", IMG_GetError());
         state.active = false;
         return;
     }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_Texture* texture = match::render::CreateTextureFromSurface(renderer, surface);
     state.logo_w = surface->w;
     state.logo_h = surface->h;
     SDL_FreeSurface(surface);
@@ -1429,135 +1618,151 @@ void RenderIntro(SDL_Renderer* renderer,
     }
 }
 
-match::ui::SaveSummary BuildSaveSummary(match::platform::SdlSaveService& service,
-                                        const match::platform::SaveSlotInfo& slot) {
+// Enough for the header, session and a typical tournament bracket.
+constexpr std::size_t kSaveSummaryPrefixBytes = 4096;
+
+match::ui::SaveSummary ReadSaveSummary(match::platform::SdlSaveService& service,
+                                       const match::platform::SaveSlotInfo& slot) {
     match::ui::SaveSummary summary;
     summary.slot = slot;
     summary.title = slot.name;
     summary.is_new_entry = false;
     std::vector<std::uint8_t> bytes;
-    if (!service.Load(slot.name, bytes)) {
+    if (!service.LoadPrefix(slot.name, kSaveSummaryPrefixBytes, bytes)) {
         summary.valid = false;
         summary.error = "Unable to read save file";
         return summary;
     }
-    try {
-        auto payload = match::core::SavePayload::DeserializeBinary(bytes);
-        const auto& data = payload.data;
-        const match::core::Json* tournament_json = nullptr;
-        auto tour_it = data.find("tournament");
-        if (tour_it != data.end() && tour_it->is_object()) {
-            tournament_json = &(*tour_it);
-        }
-        bool is_tournament = (payload.mode == "Tournament");
-        if (tournament_json) {
-            is_tournament =
-                is_tournament || tournament_json->value("active", false);
-        }
-        if (is_tournament && tournament_json) {
-            summary.detail_lines.clear();
-            summary.title = slot.name + " (Tournament)";
-            auto players = tournament_json->value("players", std::vector<std::string>{});
-            summary.detail_lines.push_back("Players: " + std::to_string(players.size()));
-            auto rounds_json = tournament_json->value("rounds", match::core::Json::array());
-            int round_count = rounds_json.is_array() ? static_cast<int>(rounds_json.size()) : 0;
-            summary.detail_lines.push_back("Rounds: " + std::to_string(std::max(1, round_count)));
-            auto name_for = [&](int idx) -> std::string {
-                if (idx >= 0 && static_cast<std::size_t>(idx) < players.size()) {
-                    return players[static_cast<std::size_t>(idx)];
-                }
-                return "TBD";
-            };
-            int next_a = -1;
-            int next_b = -1;
-            if (rounds_json.is_array()) {
-                for (const auto& round_entry : rounds_json) {
-                    if (!round_entry.is_array()) {
-                        continue;
-                    }
-                    for (const auto& match_entry : round_entry) {
-                        if (!match_entry.is_object()) {
-                            continue;
-                        }
-                        int player_a = match_entry.value("player_a", -1);
-                        int player_b = match_entry.value("player_b", -1);
-                        int winner = match_entry.value("winner", -1);
-                        if (winner == -1 && next_a == -1 && player_a >= 0 && player_b >= 0) {
-                            next_a = player_a;
-                            next_b = player_b;
-                        }
-                    }
-                }
-            }
-            if (next_a >= 0 && next_b >= 0) {
-                summary.detail_lines.push_back("Next: " + name_for(next_a) + " vs " + name_for(next_b));
-            } else {
-                int final_winner = -1;
-                if (rounds_json.is_array() && !rounds_json.empty()) {
-                    const auto& final_round = rounds_json.back();
-                    if (final_round.is_array() && !final_round.empty()) {
-                        const auto& final_match = final_round.back();
-                        if (final_match.is_object()) {
-                            final_winner = final_match.value("winner", -1);
-                        }
-                    }
-                }
-                if (final_winner >= 0) {
-                    summary.detail_lines.push_back("Winner: " + name_for(final_winner));
-                } else {
-                    summary.detail_lines.push_back("Bracket pending");
-                }
+    match::core::SaveGame save;
+    std::string error;
+    auto read = match::core::DecodeSaveSummary(bytes.data(), bytes.size(), save, &error);
+    if ((read == match::core::SaveRead::Truncated && bytes.size() == kSaveSummaryPrefixBytes) ||
+        read == match::core::SaveRead::Unsupported) {
+        // A bracket too large for the prefix, or a version 1 file: read it all.
+        if (!service.Load(slot.name, bytes)) {
+            summary.valid = false;
+            summary.error = "Unable to read save file";
+            return summary;
+        }
+        read = match::core::DecodeSaveGame(bytes, save, &error) ? match::core::SaveRead::Ok
+                                                                : match::core::SaveRead::Invalid;
+    }
+    if (read != match::core::SaveRead::Ok) {
+        summary.valid = false;
+        summary.error = "Corrupt save: " + error;
+        return summary;
+    }
+    const match::core::SaveTournament* tournament =
+        save.tournament ? &(*save.tournament) : nullptr;
+    bool is_tournament = (save.header.mode == "Tournament");
+    if (tournament) {
+        is_tournament = is_tournament || tournament->active;
+    }
+    if (is_tournament && tournament) {
+        summary.detail_lines.clear();
+        summary.title = slot.name + " (Tournament)";
+        const auto& players = tournament->players;
+        summary.detail_lines.push_back("Players: " + std::to_string(players.size()));
+        const auto& rounds = tournament->rounds;
+        int round_count = static_cast<int>(rounds.size());
+        summary.detail_lines.push_back("Rounds: " + std::to_string(std::max(1, round_count)));
+        auto name_for = [&](int idx) -> std::string {
+            if (idx >= 0 && static_cast<std::size_t>(idx) < players.size()) {
+                return players[static_cast<std::size_t>(idx)];
             }
-            if (tournament_json->contains("last_summary") &&
-                (*tournament_json)["last_summary"].is_string()) {
-                std::string standings = (*tournament_json)["last_summary"].get<std::string>();
-                if (!standings.empty()) {
-                    summary.detail_lines.push_back(standings);
+            return "TBD";
+        };
+        int next_a = -1;
+        int next_b = -1;
+        for (const auto& round_entry : rounds) {
+            for (const auto& match_entry : round_entry) {
+                if (match_entry.winner == -1 && next_a == -1 && match_entry.player_a >= 0 &&
+                    match_entry.player_b >= 0) {
+                    next_a = match_entry.player_a;
+                    next_b = match_entry.player_b;
                 }
             }
-            summary.detail_lines.push_back("Saved " + FormatTimestamp(slot.modified_time));
-            return summary;
         }
-        auto names = data.value("player_names", std::vector<std::string>{});
-        auto scores = data.value("player_scores", std::vector<int>{});
-        int round = data.value("round_current", 1);
-        int total_rounds = data.value("round_total", 1);
-        std::string time_mode = data.value("time_mode", std::string("classic"));
-        std::ostringstream line0;
-        if (names.size() >= 2) {
-            line0 << names[0] << " vs " << names[1];
-        } else if (!names.empty()) {
-            line0 << names.front();
+        if (next_a >= 0 && next_b >= 0) {
+            summary.detail_lines.push_back("Next: " + name_for(next_a) + " vs " + name_for(next_b));
         } else {
-            line0 << "Unknown players";
-        }
-        summary.detail_lines.push_back(line0.str());
-
-        std::ostringstream line1;
-        if (scores.size() >= 2) {
-            line1 << "Score: " << scores[0] << " / ";
-            if (scores.size() > 1) {
-                line1 << scores[1];
+            int final_winner = -1;
+            if (!rounds.empty() && !rounds.back().empty()) {
+                final_winner = rounds.back().back().winner;
+            }
+            if (final_winner >= 0) {
+                summary.detail_lines.push_back("Winner: " + name_for(final_winner));
             } else {
-                line1 << "0";
+                summary.detail_lines.push_back("Bracket pending");
             }
         }
-        line1 << "  Round " << round << "/" << total_rounds;
-        summary.detail_lines.push_back(line1.str());
+        if (!tournament->last_summary.empty()) {
+            summary.detail_lines.push_back(tournament->last_summary);
+        }
+        summary.detail_lines.push_back("Saved " + FormatTimestamp(slot.modified_time));
+        return summary;
+    }
+    const auto& names = save.header.players;
+    const auto& scores = save.session.player_scores;
+    std::ostringstream line0;
+    if (names.size() >= 2) {
+        line0 << names[0] << " vs " << names[1];
+    } else if (!names.empty()) {
+        line0 << names.front();
+    } else {
+        line0 << "Unknown players";
+    }
+    summary.detail_lines.push_back(line0.str());
 
-        std::ostringstream line2;
-        line2 << (time_mode == "blitz" ? "Blitz mode" : "Classic mode") << "  Saved "
-              << FormatTimestamp(slot.modified_time);
-        summary.detail_lines.push_back(line2.str());
-    } catch (const std::exception& ex) {
-        summary.valid = false;
-        summary.error = std::string("Corrupt save: ") + ex.what();
+    std::ostringstream line1;
+    if (scores.size() >= 2) {
+        line1 << "Score: " << scores[0] << " / " << scores[1];
     }
+    line1 << "  Round " << save.session.round_current << "/" << save.session.round_total;
+    summary.detail_lines.push_back(line1.str());
+
+    std::ostringstream line2;
+    line2 << (save.session.time_mode == "blitz" ? "Blitz mode" : "Classic mode") << "  Saved "
+          << FormatTimestamp(slot.modified_time);
+    summary.detail_lines.push_back(line2.str());
     return summary;
 }
 
-PanelInfo BuildPanelInfo(const GameContext& ctx) {
-    PanelInfo panel;
+struct CachedSaveSummary {
+    std::uintmax_t size_bytes = 0;
+    std::time_t modified_time = 0;
+    match::ui::SaveSummary summary;
+};
+
+// Summaries by file, reused while the file's size and time are unchanged, so
+// reopening the save browser reads nothing that has not been rewritten.
+std::map<std::filesystem::path, CachedSaveSummary>& SaveSummaryCache() {
+    static std::map<std::filesystem::path, CachedSaveSummary> cache;
+    return cache;
+}
+
+// Called when a slot is rewritten or deleted; both can leave the size and
+// the one-second timestamp unchanged.
+void ForgetSaveSummary(const std::filesystem::path& path) {
+    SaveSummaryCache().erase(path);
+}
+
+match::ui::SaveSummary BuildSaveSummary(match::platform::SdlSaveService& service,
+                                        const match::platform::SaveSlotInfo& slot) {
+    auto& cache = SaveSummaryCache();
+    auto cached = cache.find(slot.path);
+    if (cached != cache.end() && cached->second.size_bytes == slot.size_bytes &&
+        cached->second.modified_time == slot.modified_time) {
+        return cached->second.summary;
+    }
+    CachedSaveSummary entry{slot.size_bytes, slot.modified_time, ReadSaveSummary(service, slot)};
+    cache[slot.path] = entry;
+    return entry.summary;
+}
+
+// Refills panel in place so its strings and vectors keep their capacity from
+// one frame to the next.
+void BuildPanelInfo(const GameContext& ctx, PanelInfo& panel) {
     panel.mode = ctx.mode;
     panel.round = std::to_string(ctx.round_current) + "/" + std::to_string(ctx.round_total);
     panel.order = ctx.turn_order;
@@ -1569,36 +1774,44 @@ PanelInfo BuildPanelInfo(const GameContext& ctx) {
         moves_left_current = ctx.moves_left_per_player[static_cast<std::size_t>(ctx.active_player)];
     }
     panel.moves_left = moves_left_current;
-    panel.status = ctx.status.empty() ? "Ready" : ctx.status;
+    if (ctx.status.empty()) {
+        panel.status = "Ready";
+    } else {
+        panel.status = ctx.status;
+    }
 
-    panel.players.reserve(ctx.player_names.size());
+    panel.players.resize(ctx.player_names.size());
     for (std::size_t i = 0; i < ctx.player_names.size(); ++i) {
-        PanelPlayerEntry entry;
+        PanelPlayerEntry& entry = panel.players[i];
         entry.name = ctx.player_names[i];
         entry.score = (i < ctx.player_scores.size()) ? ctx.player_scores[i] : 0;
         entry.active = static_cast<int>(i) == ctx.active_player;
-        if (i < ctx.moves_left_per_player.size()) {
-            entry.moves_left = ctx.moves_left_per_player[i];
-        }
-        panel.players.push_back(entry);
+        entry.moves_left = (i < ctx.moves_left_per_player.size()) ? ctx.moves_left_per_player[i] : -1;
     }
 
-    if (ctx.last_input == InputMode::Controller) {
-        panel.controls = {
-            "Left stick or D-pad: move cursor",
-            "A button: select / swap",
-            "B button: cancel selection",
-            "X button: decrease value",
-            "Y button: increase value",
-            "Menu button: exit game",
-        };
-    } else {
-        panel.controls = {
-            "Mouse: left click to select tile",
-            "Click adjacent tile to swap",
-            "Keyboard: ESC to exit game",
-        };
+    static const std::vector<std::string> kControllerControls{
+        "Left stick or D-pad: move cursor",
+        "A button: select / swap",
+        "B button: cancel selection",
+        "X button: decrease value",
+        "Y button: increase value",
+        "Menu button: exit game",
+    };
+    static const std::vector<std::string> kMouseControls{
+        "Mouse: left click to select tile",
+        "Click adjacent tile to swap",
+        "Keyboard: ESC to exit game",
+    };
+    const auto& controls = ctx.last_input == InputMode::Controller ? kControllerControls : kMouseControls;
+    if (panel.controls != controls) {
+        panel.controls = controls;
     }
+
+    panel.show_pre_turn = false;
+    panel.pre_turn_seconds = 0;
+    panel.show_turn_timer = false;
+    panel.turn_timer_ms = 0.0f;
+    panel.turn_timer_total_ms = 0.0f;
     if (ctx.time_mode == match::ui::TimeModeOption::Blitz) {
         if (ctx.blitz_pre_turn_active) {
             panel.show_pre_turn = true;
@@ -1611,7 +1824,6 @@ PanelInfo BuildPanelInfo(const GameContext& ctx) {
             panel.turn_timer_total_ms = ctx.blitz_turn_total_ms;
         }
     }
-    return panel;
 }
 
 
@@ -1620,12 +1832,19 @@ struct CascadeState {
 
     Phase phase = Phase::Idle;
     bool active = false;
-    std::vector<match::core::SimulationResult::ChainEvent> chains;
+    // The simulation runs one chain ahead of the screen: sim_board is the
+    // layout after `pending`, the chain the next pop will show, while
+    // `current` is the chain being animated on BoardState::board.
+    match::core::Board sim_board;
+    match::core::SimulationScratch scratch;
+    match::core::CascadeTotals totals;
+    match::core::SimulationResult::ChainEvent current;
+    match::core::SimulationResult::ChainEvent pending;
+    bool has_pending = false;
     std::size_t chain_index = 0;
-    match::core::Board working_board;
-    match::core::Board final_board;
     match::core::Move move{};
-    match::core::SimulationResult result{};
+    // Every cell the cascade has touched so far, for the legal-move index.
+    std::vector<match::core::Cell> changed;
 };
 
 struct BoardState {
@@ -1633,10 +1852,17 @@ struct BoardState {
     std::optional<match::core::Cell> selected;
     std::optional<match::core::Cell> hover;
     std::optional<match::core::Cell> controller_cursor;
-    std::vector<Animation> animations;
-    std::set<match::core::Cell> hidden_cells;
+    AnimationPool animations;
+    HiddenCells hidden_cells;
     CascadeState cascade;
+    // Legal swaps on board; rebuilt when the board is replaced and updated
+    // from each finished cascade.
+    match::core::LegalMoveIndex legal_moves;
     Layout layout{};
+    // Pan and zoom for boards too big to play at fit-to-window size: the
+    // wheel zooms around the pointer and a right drag pans.
+    match::render::Camera camera;
+    std::optional<SDL_Point> pan_anchor;
     int controller_axis_horizontal = 0;
     int controller_axis_vertical = 0;
     Uint32 controller_axis_horizontal_tick = 0;
@@ -1804,31 +2030,7 @@ void ForceTurnTimeout(BoardState& state, GameContext& ctx) {
     int previous_round = ctx.round_current;
     int previous_player = ctx.active_player;
     bool previous_game_over = ctx.game_over;
-    SyncPlayerVectors(ctx);
-    if (ctx.active_player >= 0 &&
-        ctx.active_player < static_cast<int>(ctx.moves_left_per_player.size())) {
-        ctx.moves_left_per_player[static_cast<std::size_t>(ctx.active_player)] = 0;
-    }
-    ctx.status = "Time expired";
-    if (RoundComplete(ctx)) {
-        ctx.round_current += 1;
-        if (ctx.round_current > ctx.round_total) {
-            ctx.game_over = true;
-            ctx.status = BuildGameOverStatus(ctx);
-        } else {
-            ResetMovesForNewRound(ctx);
-            ctx.active_player = 0;
-            ctx.status = BuildTurnStatus(ctx);
-        }
-    } else {
-        int next = NextPlayerWithMoves(ctx, ctx.active_player);
-        if (next >= 0) {
-            ctx.active_player = next;
-        }
-        if (!ctx.game_over) {
-            ctx.status = BuildTurnStatus(ctx);
-        }
-    }
+    EndActiveTurn(ctx, true);
     HandleStateFeedback(ctx, previous_round, previous_player, previous_game_over);
     UpdateAiPending(ctx);
 }
@@ -1911,83 +2113,62 @@ void HandleStateFeedback(GameContext& ctx,
     }
 }
 
-match::core::SavePayload BuildSavePayload(const BoardState& state, const GameContext& ctx) {
-    match::core::SavePayload payload;
-    payload.version = 1;
-    payload.mode = ctx.mode;
-    payload.meta = match::core::Json::object();
-    payload.meta["timestamp"] = static_cast<std::int64_t>(std::time(nullptr));
-    payload.meta["save_name"] = ctx.save_slot_display;
-    payload.meta["players"] = ctx.player_names;
-
-    match::core::Json data = match::core::Json::object();
-    match::core::Json board_json = match::core::Json::object();
-    board_json["cols"] = state.board.cols();
-    board_json["rows"] = state.board.rows();
-    board_json["tile_types"] = state.board.tileTypes();
-    board_json["bombs_enabled"] = state.board.bombsEnabled();
-    board_json["color_chain_enabled"] = state.board.colorChainEnabled();
-
-    match::core::Json rows = match::core::Json::array();
-    for (int r = 0; r < state.board.rows(); ++r) {
-        match::core::Json row = match::core::Json::array();
-        for (int c = 0; c < state.board.cols(); ++c) {
-            row.push_back(state.board.get(c, r));
-        }
-        rows.push_back(row);
-    }
-    board_json["cells"] = rows;
-    data["board"] = board_json;
-
-    data["player_names"] = ctx.player_names;
-    data["player_scores"] = ctx.player_scores;
-    data["player_count"] =
+// Everything but the board, which EncodeSaveGame reads from BoardState
+// directly.
+struct SaveSections {
+    match::core::SaveHeader header;
+    match::core::SaveSession session;
+    std::optional<match::core::SaveTournament> tournament;
+};
+
+void BuildSaveSections(const GameContext& ctx, SaveSections& out) {
+    match::core::SaveHeader& header = out.header;
+    header.mode = ctx.mode;
+    header.timestamp = static_cast<std::int64_t>(std::time(nullptr));
+    header.save_name = ctx.save_slot_display;
+    header.players = ctx.player_names;
+
+    match::core::SaveSession& session = out.session;
+    session.player_scores = ctx.player_scores;
+    session.player_count =
         ctx.players_count > 0 ? ctx.players_count
                               : static_cast<int>(ctx.player_names.size());
-    data["active_player"] = ctx.active_player;
-    data["moves_left_per_player"] = ctx.moves_left_per_player;
-    data["round_current"] = ctx.round_current;
-    data["round_total"] = ctx.round_total;
-    data["total_moves"] = ctx.total_moves;
-    data["turn_order"] = ctx.turn_order;
-    data["bombs_enabled"] = ctx.bombs_enabled;
-    data["color_blast_enabled"] = ctx.color_blast_enabled;
-    data["moves_per_round"] = ctx.moves_per_round_setting;
-    data["status"] = ctx.status;
-    data["time_mode"] = (ctx.time_mode == match::ui::TimeModeOption::Classic) ? "classic" : "blitz";
-    data["blitz_turn_minutes"] = ctx.blitz_turn_minutes;
-    data["blitz_between_seconds"] = ctx.blitz_between_seconds;
-    data["blitz_turn_remaining_ms"] = ctx.blitz_turn_remaining_ms;
-    data["blitz_turn_total_ms"] = ctx.blitz_turn_total_ms;
-    data["blitz_pre_turn_ms"] = ctx.blitz_pre_turn_ms;
-    data["blitz_pre_turn_active"] = ctx.blitz_pre_turn_active;
-    data["blitz_turn_active"] = ctx.blitz_turn_active;
-    data["game_over"] = ctx.game_over;
+    session.active_player = ctx.active_player;
+    session.moves_left_per_player = ctx.moves_left_per_player;
+    session.round_current = ctx.round_current;
+    session.round_total = ctx.round_total;
+    session.total_moves = ctx.total_moves;
+    session.turn_order = ctx.turn_order;
+    session.bombs_enabled = ctx.bombs_enabled;
+    session.color_blast_enabled = ctx.color_blast_enabled;
+    session.ai_difficulty = DifficultyToken(ctx.ai_difficulty);
+    session.moves_per_round = ctx.moves_per_round_setting;
+    session.time_mode = (ctx.time_mode == match::ui::TimeModeOption::Classic) ? "classic" : "blitz";
+    session.blitz_turn_minutes = ctx.blitz_turn_minutes;
+    session.blitz_between_seconds = ctx.blitz_between_seconds;
+    session.blitz_turn_remaining_ms = ctx.blitz_turn_remaining_ms;
+    session.blitz_turn_total_ms = ctx.blitz_turn_total_ms;
+    session.blitz_pre_turn_ms = ctx.blitz_pre_turn_ms;
+    session.blitz_pre_turn_active = ctx.blitz_pre_turn_active;
+    session.blitz_turn_active = ctx.blitz_turn_active;
+    session.game_over = ctx.game_over;
+
+    out.tournament.reset();
     if (ctx.mode == "Tournament" || g_tournament.active) {
-        match::core::Json tour = match::core::Json::object();
-        tour["active"] = g_tournament.active;
-        tour["players"] = g_tournament.players;
-        match::core::Json rounds = match::core::Json::array();
+        match::core::SaveTournament& tour = out.tournament.emplace();
+        tour.active = g_tournament.active;
+        tour.players = g_tournament.players;
         for (const auto& round : g_tournament.rounds) {
-            match::core::Json round_entry = match::core::Json::array();
+            auto& round_entry = tour.rounds.emplace_back();
             for (const auto& match : round.matches) {
-                match::core::Json obj = match::core::Json::object();
-                obj["player_a"] = match.player_a;
-                obj["player_b"] = match.player_b;
-                obj["winner"] = match.winner;
-                round_entry.push_back(obj);
+                round_entry.push_back({match.player_a, match.player_b, match.winner});
             }
-            rounds.push_back(round_entry);
-        }
-        tour["rounds"] = rounds;
-        tour["current_round"] = g_tournament.current_round;
-        tour["current_match"] = g_tournament.current_match;
-        match::core::Json active_pair = match::core::Json::array();
-        active_pair.push_back(g_tournament.active_pair[0]);
-        active_pair.push_back(g_tournament.active_pair[1]);
-        tour["active_pair"] = active_pair;
-        tour["awaiting_next_match"] = g_tournament.awaiting_next_match;
-        tour["last_summary"] = g_tournament.last_summary;
+        }
+        tour.current_round = g_tournament.current_round;
+        tour.current_match = g_tournament.current_match;
+        tour.active_pair = {g_tournament.active_pair[0], g_tournament.active_pair[1]};
+        tour.awaiting_next_match = g_tournament.awaiting_next_match;
+        tour.last_summary = g_tournament.last_summary;
         match::ui::GameSettings serialized_settings = g_tournament.base_settings;
         if (serialized_settings.player_names.empty()) {
             serialized_settings.player_names = ctx.player_names;
@@ -1998,205 +2179,169 @@ match::core::SavePayload BuildSavePayload(const BoardState& state, const GameCon
             serialized_settings.total_rounds = ctx.round_total;
             serialized_settings.bombs_enabled = ctx.bombs_enabled;
             serialized_settings.color_blast_enabled = ctx.color_blast_enabled;
+            serialized_settings.ai_difficulty = ctx.ai_difficulty;
             serialized_settings.time_mode = ctx.time_mode;
             serialized_settings.blitz_turn_minutes = ctx.blitz_turn_minutes;
             serialized_settings.blitz_between_seconds = ctx.blitz_between_seconds;
             serialized_settings.EnsureConstraints();
         }
-        tour["base_settings"] = SerializeGameSettings(serialized_settings);
-        data["tournament"] = tour;
+        tour.base_settings = SerializeGameSettings(serialized_settings);
     }
-    payload.data = data;
-    return payload;
 }
 
-bool ApplySavePayload(const match::core::SavePayload& payload,
-                      BoardState& state,
-                      GameContext& ctx,
-                      match::ui::GameSettings& ui_settings) {
-    try {
-        const match::core::Json& data = payload.data;
-        if (!data.contains("board")) {
-            return false;
-        }
-        const match::core::Json& board_json = data["board"];
-        match::core::Board::Rules rules;
-        rules.cols = board_json.value("cols", state.board.cols());
-        rules.rows = board_json.value("rows", state.board.rows());
-        rules.tile_types = board_json.value("tile_types", state.board.tileTypes());
-        rules.bombs_enabled = board_json.value("bombs_enabled", ctx.bombs_enabled);
-        rules.color_chain_enabled = board_json.value("color_chain_enabled", ctx.color_blast_enabled);
-
-        match::core::Board board(rules);
-        if (board_json.contains("cells") && board_json["cells"].is_array()) {
-            const auto& rows = board_json["cells"];
-            for (int r = 0; r < rules.rows && r < static_cast<int>(rows.size()); ++r) {
-                const auto& row = rows[r];
-                for (int c = 0; c < rules.cols && c < static_cast<int>(row.size()); ++c) {
-                    int value = row[c].get<int>();
-                    board.set(c, r, value);
-                }
-            }
-        }
-
-        state.board = board;
-        state.cascade = CascadeState{};
-        state.animations.clear();
-        state.hidden_cells.clear();
-        state.selected.reset();
-        state.hover.reset();
-        state.controller_cursor.reset();
-
-        ctx.mode = payload.mode.empty() ? ctx.mode : payload.mode;
-        ctx.player_names = data.value("player_names", ctx.player_names);
-        ctx.player_scores = data.value("player_scores", ctx.player_scores);
-        ctx.players_count =
-            data.value("player_count",
-                       ctx.player_names.empty() ? ctx.players_count
-                                                : static_cast<int>(ctx.player_names.size()));
-        ctx.active_player = data.value("active_player", ctx.active_player);
-        ctx.last_player_index = ctx.active_player;
-        ctx.round_current = data.value("round_current", ctx.round_current);
-        ctx.round_total = data.value("round_total", ctx.round_total);
-        ctx.total_moves = data.value("total_moves", ctx.total_moves);
-        ctx.turn_order = data.value("turn_order", ctx.turn_order);
-        ctx.turn_order_mode = TurnOrderFromString(ctx.turn_order);
-        ctx.bombs_enabled = data.value("bombs_enabled", ctx.bombs_enabled);
-        ctx.color_blast_enabled = data.value("color_blast_enabled", ctx.color_blast_enabled);
-        ctx.moves_per_round_setting = data.value("moves_per_round", ctx.moves_per_round_setting);
-        ctx.moves_left_per_player = data.value("moves_left_per_player", ctx.moves_left_per_player);
-        ctx.status = "Resumed game";
-        std::string time_mode_str = data.value("time_mode", std::string("classic"));
-        ctx.time_mode = (time_mode_str == "blitz") ? match::ui::TimeModeOption::Blitz
-                                                   : match::ui::TimeModeOption::Classic;
-        ctx.blitz_turn_minutes = data.value("blitz_turn_minutes", ctx.blitz_turn_minutes);
-        ctx.blitz_between_seconds = data.value("blitz_between_seconds", ctx.blitz_between_seconds);
-        ctx.blitz_turn_total_ms =
-            data.value("blitz_turn_total_ms", ctx.blitz_turn_minutes * 60.0f * 1000.0f);
-        ctx.blitz_turn_remaining_ms =
-            data.value("blitz_turn_remaining_ms", ctx.blitz_turn_total_ms);
-        ctx.blitz_pre_turn_ms = data.value("blitz_pre_turn_ms", 0.0f);
-        ctx.blitz_pre_turn_active = data.value("blitz_pre_turn_active", false);
-        ctx.blitz_turn_active = data.value("blitz_turn_active", false);
-        ctx.game_over = data.value("game_over", ctx.game_over);
-        SyncPlayerVectors(ctx);
-        if (ctx.moves_left_per_player.empty()) {
-            ctx.moves_left_per_player.assign(ctx.players_count, ctx.moves_per_round_setting);
-        } else if (ctx.moves_left_per_player.size() < static_cast<std::size_t>(ctx.players_count)) {
-            ctx.moves_left_per_player.resize(static_cast<std::size_t>(ctx.players_count),
-                                             ctx.moves_per_round_setting);
-        }
-        SyncTurnOrderLabel(ctx);
-        ctx.ai_pending = false;
-        ctx.ai_timer_ms = 0.0f;
-        ctx.autosave_enabled = true;
-        ctx.autosave_dirty = false;
-        ctx.autosave_cooldown_ms = 0.0f;
-        ctx.loaded_from_save = true;
+bool ApplySaveGame(match::core::SaveGame& save,
+                   BoardState& state,
+                   GameContext& ctx,
+                   match::ui::GameSettings& ui_settings) {
+    CancelAiSearch();
+    const match::core::SaveSession& session = save.session;
+    state.board = std::move(save.board);
+    state.legal_moves.rebuild(state.board);
+    state.cascade = CascadeState{};
+    state.animations.clear();
+    state.hidden_cells.clear();
+    state.selected.reset();
+    state.hover.reset();
+    state.controller_cursor.reset();
+
+    ctx.mode = save.header.mode.empty() ? ctx.mode : save.header.mode;
+    if (!save.header.players.empty()) {
+        ctx.player_names = save.header.players;
+    }
+    ctx.player_scores = session.player_scores;
+    ctx.players_count = session.player_count > 0
+                            ? session.player_count
+                            : static_cast<int>(ctx.player_names.size());
+    ctx.active_player = session.active_player;
+    ctx.last_player_index = ctx.active_player;
+    ctx.round_current = session.round_current;
+    ctx.round_total = session.round_total;
+    ctx.total_moves = session.total_moves;
+    ctx.turn_order = session.turn_order;
+    ctx.turn_order_mode = TurnOrderFromString(ctx.turn_order);
+    ctx.bombs_enabled = session.bombs_enabled;
+    ctx.color_blast_enabled = session.color_blast_enabled;
+    ctx.ai_difficulty = DifficultyFromToken(session.ai_difficulty);
+    ctx.moves_per_round_setting = session.moves_per_round;
+    ctx.moves_left_per_player = session.moves_left_per_player;
+    ctx.status = "Resumed game";
+    ctx.time_mode = (session.time_mode == "blitz") ? match::ui::TimeModeOption::Blitz
+                                               : match::ui::TimeModeOption::Classic;
+    ctx.blitz_turn_minutes = session.blitz_turn_minutes;
+    ctx.blitz_between_seconds = session.blitz_between_seconds;
+    ctx.blitz_turn_total_ms = session.blitz_turn_total_ms;
+    ctx.blitz_turn_remaining_ms = session.blitz_turn_remaining_ms;
+    ctx.blitz_pre_turn_ms = session.blitz_pre_turn_ms;
+    ctx.blitz_pre_turn_active = session.blitz_pre_turn_active;
+    ctx.blitz_turn_active = session.blitz_turn_active;
+    ctx.game_over = session.game_over;
+    SyncPlayerVectors(ctx);
+    if (ctx.moves_left_per_player.empty()) {
+        ctx.moves_left_per_player.assign(ctx.players_count, ctx.moves_per_round_setting);
+    } else if (ctx.moves_left_per_player.size() < static_cast<std::size_t>(ctx.players_count)) {
+        ctx.moves_left_per_player.resize(static_cast<std::size_t>(ctx.players_count),
+                                         ctx.moves_per_round_setting);
+    }
+    SyncTurnOrderLabel(ctx);
+    ctx.ai_pending = false;
+    ctx.ai_timer_ms = 0.0f;
+    ctx.autosave_enabled = true;
+    ctx.autosave_dirty = false;
+    ctx.autosave_cooldown_ms = 0.0f;
+    ctx.loaded_from_save = true;
+    ctx.replay.stop();
 
-        if (payload.meta.contains("save_name") && payload.meta["save_name"].is_string()) {
-            ctx.save_slot_display = payload.meta["save_name"].get<std::string>();
-        }
+    if (!save.header.save_name.empty()) {
+        ctx.save_slot_display = save.header.save_name;
+    }
 
-        if (ctx.player_scores.size() != ctx.player_names.size()) {
-            ctx.player_scores.assign(ctx.player_names.size(), 0);
-        }
+    if (ctx.player_scores.size() != ctx.player_names.size()) {
+        ctx.player_scores.assign(ctx.player_names.size(), 0);
+    }
 
-        if (ctx.mode == "PvP") {
-            ui_settings.mode = match::ui::GameMode::PvP;
-        } else if (ctx.mode == "Tournament") {
-            ui_settings.mode = match::ui::GameMode::Tournament;
-        } else {
-            ui_settings.mode = match::ui::GameMode::PvC;
-        }
-        ui_settings.player_count = ctx.players_count;
-        ui_settings.player_names = ctx.player_names;
-        ui_settings.turn_order = ctx.turn_order_mode;
-        ui_settings.moves_per_round = ctx.moves_per_round_setting;
-        ui_settings.total_rounds = ctx.round_total;
-        ui_settings.bombs_enabled = ctx.bombs_enabled;
-        ui_settings.color_blast_enabled = ctx.color_blast_enabled;
-        ui_settings.time_mode = ctx.time_mode;
-        ui_settings.blitz_turn_minutes = ctx.blitz_turn_minutes;
-        ui_settings.blitz_between_seconds = ctx.blitz_between_seconds;
-        ui_settings.EnsureConstraints();
+    if (ctx.mode == "PvP") {
+        ui_settings.mode = match::ui::GameMode::PvP;
+    } else if (ctx.mode == "Tournament") {
+        ui_settings.mode = match::ui::GameMode::Tournament;
+    } else {
+        ui_settings.mode = match::ui::GameMode::PvC;
+    }
+    ui_settings.player_count = ctx.players_count;
+    ui_settings.player_names = ctx.player_names;
+    ui_settings.turn_order = ctx.turn_order_mode;
+    ui_settings.moves_per_round = ctx.moves_per_round_setting;
+    ui_settings.total_rounds = ctx.round_total;
+    ui_settings.bombs_enabled = ctx.bombs_enabled;
+    ui_settings.color_blast_enabled = ctx.color_blast_enabled;
+    ui_settings.ai_difficulty = ctx.ai_difficulty;
+    ui_settings.time_mode = ctx.time_mode;
+    ui_settings.blitz_turn_minutes = ctx.blitz_turn_minutes;
+    ui_settings.blitz_between_seconds = ctx.blitz_between_seconds;
+    ui_settings.EnsureConstraints();
 
-        ResetTournamentState();
-        auto tour_it = data.find("tournament");
-        if (tour_it != data.end() && tour_it->is_object()) {
-            const auto& tour = *tour_it;
-            g_tournament.active = tour.value("active", payload.mode == "Tournament");
-            g_tournament.players = tour.value("players", ctx.player_names);
-            g_tournament.rounds.clear();
-            if (tour.contains("rounds") && tour["rounds"].is_array()) {
-                for (const auto& round_entry : tour["rounds"]) {
-                    if (!round_entry.is_array()) {
-                        continue;
-                    }
-                    TournamentRound round;
-                    for (const auto& match_entry : round_entry) {
-                        if (!match_entry.is_object()) {
-                            continue;
-                        }
-                        TournamentMatch match;
-                        match.player_a = match_entry.value("player_a", -1);
-                        match.player_b = match_entry.value("player_b", -1);
-                        match.winner = match_entry.value("winner", -1);
-                        round.matches.push_back(match);
-                    }
-                    g_tournament.rounds.push_back(std::move(round));
-                }
+    ResetTournamentState();
+    if (save.tournament) {
+        const match::core::SaveTournament& tour = *save.tournament;
+        g_tournament.active = tour.active;
+        g_tournament.players = tour.players.empty() ? ctx.player_names : tour.players;
+        g_tournament.rounds.clear();
+        for (const auto& round_entry : tour.rounds) {
+            TournamentRound round;
+            for (const auto& match_entry : round_entry) {
+                TournamentMatch match;
+                match.player_a = match_entry.player_a;
+                match.player_b = match_entry.player_b;
+                match.winner = match_entry.winner;
+                round.matches.push_back(match);
             }
-            g_tournament.current_round = tour.value("current_round", -1);
-            g_tournament.current_match = tour.value("current_match", -1);
-            g_tournament.active_pair = {-1, -1};
-            if (tour.contains("active_pair") && tour["active_pair"].is_array()) {
-                const auto& arr = tour["active_pair"];
-                if (arr.size() >= 2) {
-                    g_tournament.active_pair[0] = arr[0].get<int>();
-                    g_tournament.active_pair[1] = arr[1].get<int>();
-                }
-            }
-            g_tournament.awaiting_next_match = tour.value("awaiting_next_match", false);
-            g_tournament.last_summary = tour.value("last_summary", std::string{});
-            if (tour.contains("base_settings") && tour["base_settings"].is_object()) {
-                g_tournament.base_settings =
-                    DeserializeGameSettings(tour["base_settings"], ui_settings);
-            } else {
-                g_tournament.base_settings = ui_settings;
-            }
-            g_tournament.base_settings.mode = match::ui::GameMode::Tournament;
-            if (g_tournament.players.empty()) {
-                g_tournament.players = g_tournament.base_settings.player_names;
-            }
-            ui_settings = g_tournament.base_settings;
-            ui_settings.mode = match::ui::GameMode::Tournament;
+            g_tournament.rounds.push_back(std::move(round));
+        }
+        g_tournament.current_round = tour.current_round;
+        g_tournament.current_match = tour.current_match;
+        g_tournament.active_pair = {tour.active_pair[0], tour.active_pair[1]};
+        g_tournament.awaiting_next_match = tour.awaiting_next_match;
+        g_tournament.last_summary = tour.last_summary;
+        if (tour.base_settings) {
+            g_tournament.base_settings = DeserializeGameSettings(*tour.base_settings);
         } else {
-            ResetTournamentState();
+            g_tournament.base_settings = ui_settings;
         }
-
-        ctx.status = ctx.game_over ? BuildGameOverStatus(ctx) : BuildTurnStatus(ctx);
-        UpdateAiPending(ctx);
-        return true;
-    } catch (...) {
-        return false;
+        g_tournament.base_settings.mode = match::ui::GameMode::Tournament;
+        if (g_tournament.players.empty()) {
+            g_tournament.players = g_tournament.base_settings.player_names;
+        }
+        ui_settings = g_tournament.base_settings;
+        ui_settings.mode = match::ui::GameMode::Tournament;
+    } else {
+        ResetTournamentState();
     }
+
+    ctx.status = ctx.game_over ? BuildGameOverStatus(ctx) : BuildTurnStatus(ctx);
+    UpdateAiPending(ctx);
+    return true;
 }
 
-bool WriteAutomaticSave(match::platform::SdlSaveService& service,
+// Snapshots the game and hands it to the save thread. Clears autosave_dirty
+// right away; a failed write reported through PollCompletion sets it again.
+bool QueueAutomaticSave(match::platform::SdlSaveService& service,
                         const BoardState& state,
                         GameContext& ctx) {
     if (!ctx.autosave_enabled || ctx.save_slot_file.empty()) {
         return false;
     }
-    match::core::SavePayload payload = BuildSavePayload(state, ctx);
-    std::vector<std::uint8_t> bytes = payload.SerializeBinary();
-    bool ok_primary = service.Save(ctx.save_slot_file, bytes);
-    if (ok_primary) {
-        ctx.autosave_dirty = false;
-        ctx.autosave_cooldown_ms = 0.0f;
-    }
-    return ok_primary;
+    MATCH_PROFILE_SCOPE("save.autosave");
+    MATCH_ALLOC_SCOPE(Save);
+    SaveSections sections;
+    BuildSaveSections(ctx, sections);
+    service.QueueSave(ctx.save_slot_file,
+                      [sections = std::move(sections), board = state.board](std::vector<std::uint8_t>& out) {
+                          match::core::EncodeSaveGame(sections.header, board, sections.session,
+                                                      sections.tournament ? &(*sections.tournament) : nullptr,
+                                                      out);
+                      });
+    ctx.autosave_dirty = false;
+    ctx.autosave_cooldown_ms = 0.0f;
+    return true;
 }
 
 bool BeginPlayerMove(BoardState& state, GameContext& ctx, const match::core::Move& move);
@@ -2222,6 +2367,7 @@ void MoveControllerCursor(BoardState& state, int dc, int dr) {
     cursor.col = std::clamp(cursor.col + dc, 0, state.board.cols() - 1);
     cursor.row = std::clamp(cursor.row + dr, 0, state.board.rows() - 1);
     state.controller_cursor = cursor;
+    match::render::RevealCell(state.camera, state.layout, cursor);
 }
 
 void ControllerSelect(BoardState& state, GameContext& ctx) {
@@ -2297,58 +2443,21 @@ void FinishCascade(BoardState& state, GameContext& ctx) {
     const int previous_round = ctx.round_current;
     const int previous_player = ctx.active_player;
     const bool previous_game_over = ctx.game_over;
-    state.board = cascade.final_board;
+    state.board = std::move(cascade.sim_board);
+    state.legal_moves.update(state.board, cascade.changed);
     state.animations.clear();
     state.hidden_cells.clear();
     cascade.active = false;
     cascade.phase = CascadeState::Phase::Idle;
-    cascade.chains.clear();
+    cascade.has_pending = false;
     if (!ctx.player_scores.empty()) {
         ctx.player_scores[static_cast<std::size_t>(
             std::clamp(ctx.active_player, 0,
                        static_cast<int>(ctx.player_scores.size()) - 1))] +=
-            cascade.result.score;
-    }
-
-    SyncPlayerVectors(ctx);
-    if (ctx.active_player < 0 ||
-        ctx.active_player >= static_cast<int>(ctx.moves_left_per_player.size())) {
-        ctx.active_player = 0;
-    }
-    if (!ctx.moves_left_per_player.empty()) {
-        auto& moves = ctx.moves_left_per_player[static_cast<std::size_t>(ctx.active_player)];
-        moves = std::max(0, moves - 1);
-    }
-
-    bool round_finished = RoundComplete(ctx);
-    if (round_finished) {
-        ctx.round_current += 1;
-        if (ctx.round_current > ctx.round_total) {
-            ctx.game_over = true;
-            ctx.status = BuildGameOverStatus(ctx);
-        } else {
-            ResetMovesForNewRound(ctx);
-            ctx.active_player = 0;
-            ctx.status = BuildTurnStatus(ctx);
-        }
-    } else {
-        bool stay_on_player = (ctx.turn_order_mode == match::ui::TurnOrderOption::Consecutive &&
-                               ctx.active_player >= 0 &&
-                               ctx.active_player <
-                                   static_cast<int>(ctx.moves_left_per_player.size()) &&
-                               ctx.moves_left_per_player[static_cast<std::size_t>(ctx.active_player)] >
-                                   0);
-        if (!stay_on_player) {
-            int next = NextPlayerWithMoves(ctx, ctx.active_player);
-            if (next >= 0) {
-                ctx.active_player = next;
-            }
-        }
-        if (!ctx.game_over) {
-            ctx.status = BuildTurnStatus(ctx);
-        }
+            cascade.totals.score();
     }
 
+    EndActiveTurn(ctx, false);
     UpdateAiPending(ctx);
 
     if (ctx.autosave_enabled) {
@@ -2361,13 +2470,15 @@ void FinishCascade(BoardState& state, GameContext& ctx) {
 void StartCascadePop(BoardState& state) {
     auto& cascade = state.cascade;
     const Layout& layout = state.layout;
-    if (cascade.chain_index >= cascade.chains.size()) {
+    if (!cascade.has_pending) {
         return;
     }
 
-    const auto& chain = cascade.chains[cascade.chain_index];
+    std::swap(cascade.current, cascade.pending);
+    cascade.has_pending = false;
+    const auto& chain = cascade.current;
     state.animations.clear();
-    state.hidden_cells.clear();
+    state.hidden_cells.reset(state.board.cols(), state.board.rows());
 
     bool has_clear = false;
     bool triggered_bomb = false;
@@ -2388,43 +2499,36 @@ void StartCascadePop(BoardState& state) {
         PlayBombSound();
     }
 
-    std::set<match::core::Cell> unique;
     for (const auto& evt : chain.clears) {
         for (const auto& cell : evt.cells) {
-            if (!unique.insert(cell.position).second) {
+            if (state.hidden_cells.contains(cell.position)) {
                 continue;
             }
             state.hidden_cells.insert(cell.position);
-            cascade.working_board.set(cell.position.col, cell.position.row,
-                                      match::core::kEmptyCell);
-            state.animations.push_back(
+            state.board.set(cell.position.col, cell.position.row, match::core::kEmptyCell);
+            state.animations.push(
                 MakePopAnimation(layout, cell.position, cell.tile, kPopDurationMs));
         }
     }
 
     cascade.phase = CascadeState::Phase::Pop;
-    state.board = cascade.working_board;
 }
 bool StartCascadeFall(BoardState& state) {
     auto& cascade = state.cascade;
     const Layout& layout = state.layout;
-    if (cascade.chain_index >= cascade.chains.size()) {
-        return false;
-    }
-
-    const auto& chain = cascade.chains[cascade.chain_index];
+    const auto& chain = cascade.current;
     state.animations.clear();
-    state.hidden_cells.clear();
+    state.hidden_cells.reset(state.board.cols(), state.board.rows());
 
     bool has_animation = false;
     for (const auto& fall : chain.falls) {
-        cascade.working_board.set(fall.from.col, fall.from.row, match::core::kEmptyCell);
-        cascade.working_board.set(fall.to.col, fall.to.row, fall.tile);
+        state.board.set(fall.from.col, fall.from.row, match::core::kEmptyCell);
+        state.board.set(fall.to.col, fall.to.row, fall.tile);
         state.hidden_cells.insert(fall.to);
         const int distance = std::abs(fall.to.row - fall.from.row);
         const float duration =
             std::max(kFallDurationMinMs, distance * kFallDurationPerCellMs);
-        state.animations.push_back(
+        state.animations.push(
             MakeFallAnimation(layout, fall.from, fall.to, fall.tile, duration));
         has_animation = true;
     }
@@ -2432,7 +2536,7 @@ bool StartCascadeFall(BoardState& state) {
     std::map<int, std::vector<const match::core::SimulationResult::SpawnEvent*>> by_column;
     for (const auto& spawn : chain.spawns) {
         by_column[spawn.position.col].push_back(&spawn);
-        cascade.working_board.set(spawn.position.col, spawn.position.row, spawn.tile);
+        state.board.set(spawn.position.col, spawn.position.row, spawn.tile);
         state.hidden_cells.insert(spawn.position);
     }
 
@@ -2445,7 +2549,7 @@ bool StartCascadeFall(BoardState& state) {
             const int distance_cells = std::max(1, total - idx);
             const float duration =
                 std::max(kFallDurationMinMs, distance_cells * kFallDurationPerCellMs);
-            state.animations.push_back(
+            state.animations.push(
                 MakeSpawnAnimation(layout, spawn->position, spawn->tile, distance_cells, duration));
             has_animation = true;
         }
@@ -2455,10 +2559,55 @@ bool StartCascadeFall(BoardState& state) {
     if (!has_animation) {
         state.hidden_cells.clear();
     }
-    state.board = cascade.working_board;
     return has_animation;
 }
 
+void AppendChangedCells(const match::core::SimulationResult::ChainEvent& chain,
+                        std::vector<match::core::Cell>& changed) {
+    for (const auto& clear : chain.clears) {
+        for (const auto& cell : clear.cells) {
+            changed.push_back(cell.position);
+        }
+    }
+    for (const auto& fall : chain.falls) {
+        changed.push_back(fall.from);
+        changed.push_back(fall.to);
+    }
+    for (const auto& spawn : chain.spawns) {
+        changed.push_back(spawn.position);
+    }
+}
+
+// Resolves the chain after the one now on screen, so the simulation cost of a
+// long cascade is spread over its animations. Once the board settles the
+// final layout is known and the AI can start thinking while the last
+// animation plays.
+void ResolveNextChain(BoardState& state, const GameContext& ctx) {
+    auto& cascade = state.cascade;
+    MATCH_PROFILE_SCOPE("game.resolve_chain");
+    cascade.has_pending =
+        match::core::StepChain(cascade.sim_board, cascade.scratch, cascade.totals, &cascade.pending);
+    if (cascade.has_pending) {
+        AppendChangedCells(cascade.pending, cascade.changed);
+        return;
+    }
+    if (HasComputerPlayer(ctx)) {
+        match::core::LegalMoveIndex next_moves = state.legal_moves;
+        next_moves.update(cascade.sim_board, cascade.changed);
+        StartAiSearch(cascade.sim_board, next_moves, ctx);
+    }
+}
+
+void StartNextChainOrFinish(BoardState& state, GameContext& ctx) {
+    auto& cascade = state.cascade;
+    if (!cascade.has_pending) {
+        FinishCascade(state, ctx);
+        return;
+    }
+    StartCascadePop(state);
+    ResolveNextChain(state, ctx);
+}
+
 void AdvanceCascade(BoardState& state, GameContext& ctx) {
     auto& cascade = state.cascade;
     if (!cascade.active) {
@@ -2471,34 +2620,20 @@ void AdvanceCascade(BoardState& state, GameContext& ctx) {
     switch (cascade.phase) {
         case CascadeState::Phase::Swap: {
             state.board.swapCells(cascade.move);
-            cascade.working_board = state.board;
-            if (!cascade.chains.empty()) {
-                cascade.chain_index = 0;
-                StartCascadePop(state);
-            } else {
-                cascade.final_board = state.board;
-                FinishCascade(state, ctx);
-            }
+            cascade.chain_index = 0;
+            StartNextChainOrFinish(state, ctx);
             break;
         }
         case CascadeState::Phase::Pop: {
             if (!StartCascadeFall(state)) {
                 cascade.chain_index++;
-                if (cascade.chain_index < cascade.chains.size()) {
-                    StartCascadePop(state);
-                } else {
-                    FinishCascade(state, ctx);
-                }
+                StartNextChainOrFinish(state, ctx);
             }
             break;
         }
         case CascadeState::Phase::Fall: {
             cascade.chain_index++;
-            if (cascade.chain_index < cascade.chains.size()) {
-                StartCascadePop(state);
-            } else {
-                FinishCascade(state, ctx);
-            }
+            StartNextChainOrFinish(state, ctx);
             break;
         }
         case CascadeState::Phase::Idle:
@@ -2508,6 +2643,7 @@ void AdvanceCascade(BoardState& state, GameContext& ctx) {
 }
 
 bool BeginPlayerMove(BoardState& state, GameContext& ctx, const match::core::Move& move) {
+    MATCH_PROFILE_SCOPE("game.begin_move");
     if (ctx.game_over) {
         ctx.status = BuildGameOverStatus(ctx);
         PlayErrorSound();
@@ -2530,46 +2666,52 @@ bool BeginPlayerMove(BoardState& state, GameContext& ctx, const match::core::Mov
         return false;
     }
 
-    match::core::Board validation_board = state.board;
-    if (!match::core::LegalSwap(validation_board, move)) {
+    if (!match::core::LegalSwapLocal(state.board, move)) {
         ctx.status = "Illegal swap";
         PlayErrorSound();
         return false;
     }
 
-    match::core::Board simulation_board = state.board;
-    match::core::SimulationResult result = match::core::SimulateFullChain(simulation_board, move);
-    if (result.chain_events.empty()) {
+    // Only the first chain is resolved now; the rest follow one per
+    // animation in AdvanceCascade.
+    auto& cascade = state.cascade;
+    cascade.sim_board = state.board;
+    cascade.sim_board.swapCells(move);
+    cascade.totals = match::core::CascadeTotals{};
+    cascade.has_pending =
+        match::core::StepChain(cascade.sim_board, cascade.scratch, cascade.totals, &cascade.pending);
+    if (!cascade.has_pending) {
         ctx.status = "No match";
         PlayErrorSound();
         return false;
     }
+    cascade.changed.clear();
+    cascade.changed.push_back(move.a);
+    cascade.changed.push_back(move.b);
+    AppendChangedCells(cascade.pending, cascade.changed);
 
+    ctx.replay.record(move, ctx.active_player);
     ctx.total_moves += 1;
     ctx.status = "Resolving...";
 
-    state.cascade.active = true;
-    state.cascade.phase = CascadeState::Phase::Swap;
-    state.cascade.chains = result.chain_events;
-    state.cascade.chain_index = 0;
-    state.cascade.working_board = state.board;
-    state.cascade.final_board = simulation_board;
-    state.cascade.result = result;
-    state.cascade.move = move;
+    cascade.active = true;
+    cascade.phase = CascadeState::Phase::Swap;
+    cascade.chain_index = 0;
+    cascade.move = move;
 
     state.animations.clear();
-    state.hidden_cells.clear();
+    state.hidden_cells.reset(state.board.cols(), state.board.rows());
     state.hidden_cells.insert(move.a);
     state.hidden_cells.insert(move.b);
 
     auto anim_ab =
         MakeSwapAnimation(state.layout, move.a, move.b, state.board.get(move.a.col, move.a.row), kSwapDurationMs);
     anim_ab.reveal_cell = move.b;
-    state.animations.push_back(anim_ab);
+    state.animations.push(anim_ab);
     auto anim_ba =
         MakeSwapAnimation(state.layout, move.b, move.a, state.board.get(move.b.col, move.b.row), kSwapDurationMs);
     anim_ba.reveal_cell = move.a;
-    state.animations.push_back(anim_ba);
+    state.animations.push(anim_ba);
     PlaySwapSound();
     TriggerRumble(0.5f, 180);
     return true;
@@ -2630,9 +2772,111 @@ bool HandleMouseDown(BoardState& state, GameContext& ctx, int mouse_x, int mouse
     return BeginPlayerMove(state, ctx, move);
 }
 
+match::core::MatchRules ReplayRulesForGame(const BoardState& state, const GameContext& ctx) {
+    match::core::MatchRules rules = MatchRulesForContext(ctx);
+    rules.board = state.board.rules();
+    return rules;
+}
+
+bool WriteReplayFile(const std::filesystem::path& path, const match::core::Replay& replay) {
+    std::vector<std::uint8_t> bytes;
+    match::core::EncodeReplay(replay, bytes);
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return out.good();
+}
+
+bool ReadReplayFile(const std::filesystem::path& path, match::core::Replay& out, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path.string();
+        return false;
+    }
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return match::core::DecodeReplay(bytes, out, &error);
+}
+
+struct ReplayPlayback {
+    bool active = false;
+    match::core::Replay replay;
+    std::size_t next_move = 0;
+};
+
+// Moves applied per frame while a replay fast-forwards.
+constexpr int kReplayMovesPerFrame = 4;
+
+// Plays out the current cascade through the same steps as the animated
+// path, so the board ends up exactly where AdvanceCascade would leave it.
+void SkipCascadeAnimations(BoardState& state, GameContext& ctx) {
+    while (state.cascade.active) {
+        state.animations.clear();
+        AdvanceCascade(state, ctx);
+    }
+}
+
+// Feeds recorded moves through BeginPlayerMove with animations, banners and
+// sounds skipped. Each move is played by the seat that recorded it, which
+// covers turns the live game skipped. Playback stops at the end of the
+// replay or the first move that no longer applies, and the game carries on
+// from there.
+void StepReplayPlayback(BoardState& state, GameContext& ctx, ReplayPlayback& playback) {
+    MATCH_PROFILE_SCOPE("update.replay");
+    AudioSystem* audio = std::exchange(g_audio, nullptr);
+    SdlInput* input = std::exchange(g_input, nullptr);
+    for (int step = 0; step < kReplayMovesPerFrame && playback.active; ++step) {
+        const auto& moves = playback.replay.moves;
+        if (playback.next_move >= moves.size()) {
+            playback.active = false;
+            const std::uint64_t digest = playback.replay.final_digest;
+            if (digest != 0 && match::core::BoardDigest(state.board) != digest) {
+                ctx.status = "Replay finished on a different board";
+            } else if (!ctx.game_over) {
+                ctx.status = "Replay finished";
+            }
+            break;
+        }
+        const auto& entry = moves[playback.next_move];
+        ResetBannerOverlay();
+        ctx.active_player = entry.player;
+        if (ctx.game_over || !BeginPlayerMove(state, ctx, entry.move)) {
+            playback.active = false;
+            ctx.status = "Replay diverged at move " + std::to_string(playback.next_move + 1);
+            break;
+        }
+        SkipCascadeAnimations(state, ctx);
+        ++playback.next_move;
+    }
+    CancelAiSearch();
+    g_audio = audio;
+    g_input = input;
+}
+
 }  // namespace
 
-int main(int /*argc*/, char* /*argv*/[]) {
+// `--replay <file>` starts straight into a recorded game and fast-forwards
+// through it; the game stays playable from wherever the recording ends.
+// `--board <cols>x<rows>` sets the size of new boards, e.g. 200x200 for
+// event play; larger boards are played zoomed in.
+int main(int argc, char* argv[]) {
+    std::filesystem::path replay_arg;
+    int board_cols = kBoardCols;
+    int board_rows = kBoardRows;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--replay") {
+            replay_arg = argv[i + 1];
+        } else if (arg == "--board") {
+            int cols = 0;
+            int rows = 0;
+            if (std::sscanf(argv[i + 1], "%dx%d", &cols, &rows) == 2) {
+                board_cols = std::clamp(cols, kMinBoardSide, kMaxBoardSide);
+                board_rows = std::clamp(rows, kMinBoardSide, kMaxBoardSide);
+            }
+        }
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) != 0) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init failed: %s", SDL_GetError());
         return 1;
@@ -2785,11 +3029,13 @@ int main(int /*argc*/, char* /*argv*/[]) {
         return true;
     };
     SDL_ShowCursor(SDL_ENABLE);
-    float font_scale = ComputeUiScale(base_width, base_height);
-    Fonts fonts = LoadFonts(font_scale);
+    FontLibrary font_library;
+    int font_bucket = FontLibrary::BucketIndex(ComputeUiScale(base_width, base_height));
+    float font_scale = FontLibrary::BucketScale(font_bucket);
+    Fonts fonts = font_library.open() ? font_library.acquire(font_bucket) : Fonts{};
     if (!fonts.heading || !fonts.body || !fonts.small) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load required fonts.");
-        DestroyFonts(fonts);
+        font_library.shutdown();
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         if (audio_ready) {
@@ -2803,6 +3049,18 @@ int main(int /*argc*/, char* /*argv*/[]) {
         SDL_Quit();
         return 1;
     }
+    // Sizes a resize or a fullscreen toggle is likely to ask for next.
+    auto prefetch_font_neighbours = [&font_library](int bucket) {
+        font_library.prefetch(bucket - 1);
+        font_library.prefetch(bucket + 1);
+    };
+    {
+        SDL_DisplayMode desktop{};
+        if (SDL_GetDesktopDisplayMode(SDL_GetWindowDisplayIndex(window), &desktop) == 0) {
+            font_library.prefetch(FontLibrary::BucketIndex(ComputeUiScale(desktop.w, desktop.h)));
+        }
+        prefetch_font_neighbours(font_bucket);
+    }
     IntroState intro_state;
     intro_state.min_duration_ms = kIntroMinimumDurationMs;
     bool music_started = false;
@@ -2942,19 +3200,36 @@ int main(int /*argc*/, char* /*argv*/[]) {
         current_screen = AppScreen::MainMenu;
         set_main_menu_title();
     }
-    auto start_new_game = [&]() {
+    auto current_board_rules = [&]() {
         match::core::Board::Rules rules;
-        rules.cols = kBoardCols;
-        rules.rows = kBoardRows;
+        rules.cols = board_cols;
+        rules.rows = board_rows;
         rules.tile_types = 6;
         rules.bombs_enabled = ui_settings.bombs_enabled;
         rules.color_chain_enabled = ui_settings.color_blast_enabled;
+        return rules;
+    };
+    // Boards for the default settings are generated while the intro and menus
+    // run, so the first game starts without waiting.
+    match::core::SharedBoardPool().prefill(current_board_rules());
+
+    // With a replay the board, seed and seating come from the recording; the
+    // caller sets the round options in ui_settings to match it.
+    auto start_new_game = [&](const match::core::Replay* replay = nullptr) {
+        match::core::Board::Rules rules = current_board_rules();
+        if (replay) {
+            rules = replay->rules.board;
+        }
 
-        match::core::Board new_board = match::core::NewBoard(rules, std::random_device{}());
+        match::core::BoardPool::Entry pooled =
+            replay ? match::core::BoardPool::Entry{replay->seed, match::core::NewBoard(rules, replay->seed)}
+                   : match::core::SharedBoardPool().take(rules);
+        const std::uint32_t seed = pooled.seed;
+        match::core::Board new_board = std::move(pooled.board);
+        CancelAiSearch();
         board_state = BoardState{};
         board_state.board = new_board;
-        board_state.cascade.working_board = new_board;
-        board_state.cascade.final_board = new_board;
+        board_state.legal_moves.rebuild(new_board);
 
         ui_settings.EnsureConstraints();
 
@@ -2975,13 +3250,16 @@ int main(int /*argc*/, char* /*argv*/[]) {
         SyncTurnOrderLabel(game_ctx);
         game_ctx.bombs_enabled = ui_settings.bombs_enabled;
         game_ctx.color_blast_enabled = ui_settings.color_blast_enabled;
+        game_ctx.ai_difficulty = ui_settings.ai_difficulty;
         game_ctx.moves_per_round_setting = ui_settings.moves_per_round;
-        game_ctx.player_names = ui_settings.player_names;
+        game_ctx.player_names = replay ? replay->players : ui_settings.player_names;
         game_ctx.players_count = static_cast<int>(game_ctx.player_names.size());
         game_ctx.player_scores.assign(game_ctx.players_count, 0);
         game_ctx.moves_left_per_player.assign(game_ctx.players_count, ui_settings.moves_per_round);
         SyncPlayerVectors(game_ctx);
-        RandomizePlayerOrder(game_ctx);
+        if (!replay) {
+            RandomizePlayerOrder(game_ctx);
+        }
         ResetMovesForNewRound(game_ctx);
         game_ctx.total_moves = 0;
         game_ctx.game_over = false;
@@ -3002,6 +3280,8 @@ int main(int /*argc*/, char* /*argv*/[]) {
         game_ctx.blitz_pre_turn_active = false;
         game_ctx.blitz_turn_active = false;
         game_ctx.last_player_index = -1;
+        game_ctx.replay.start(seed, ReplayRulesForGame(board_state, game_ctx), game_ctx.mode,
+                              game_ctx.player_names);
 
         board_state.selected.reset();
         board_state.hover.reset();
@@ -3132,7 +3412,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
 
     auto reinitialize_save_service = [&](match::ui::GameMode mode) {
         std::filesystem::path target = base_save_root / ModeFolder(mode);
-        save_service = match::platform::SdlSaveService(target);
+        save_service.SetRoot(target);
         save_service.Initialize();
         save_slots_dirty = true;
     };
@@ -3143,27 +3423,64 @@ int main(int /*argc*/, char* /*argv*/[]) {
         }
         save_setup_state.slots = save_service.ListSlots();
         SortSlotsNewestFirst(save_setup_state.slots);
+        // Rows start as directory entries; fill_visible_summaries reads them
+        // as they come into view.
         save_setup_state.summaries.clear();
         for (const auto& slot : save_setup_state.slots) {
-            save_setup_state.summaries.push_back(BuildSaveSummary(save_service, slot));
+            match::ui::SaveSummary placeholder;
+            placeholder.slot = slot;
+            placeholder.title = slot.name;
+            placeholder.pending = true;
+            save_setup_state.summaries.push_back(std::move(placeholder));
         }
         save_slots_dirty = false;
     };
 
+    constexpr int kSummariesPerFrame = 4;
+    bool save_summaries_pending = false;
+    auto fill_visible_summaries = [&]() {
+        auto& summaries = save_setup_state.summaries;
+        const int count = static_cast<int>(summaries.size());
+        int budget = kSummariesPerFrame;
+        auto fill = [&](int index) {
+            if (index < 0 || index >= count) {
+                return;
+            }
+            auto& summary = summaries[static_cast<std::size_t>(index)];
+            if (!summary.pending) {
+                return;
+            }
+            if (budget <= 0) {
+                save_summaries_pending = true;
+                return;
+            }
+            summary = BuildSaveSummary(save_service, summary.slot);
+            --budget;
+        };
+        save_summaries_pending = false;
+        // List entry 0 is "new save", so summary i is entry i + 1.
+        fill(save_setup_state.selected_index - 1);
+        const int rows = save_setup_state.visible_count > 0 ? save_setup_state.visible_count : 8;
+        // One row either side so scrolling never shows a bare filename.
+        for (int index = save_setup_state.first_visible - 2; index < save_setup_state.first_visible + rows;
+             ++index) {
+            fill(index);
+        }
+    };
+
     auto load_save_slot = [&](const match::platform::SaveSlotInfo& slot, bool use_controller) -> bool {
         std::vector<std::uint8_t> bytes;
         if (!save_service.Load(slot.name, bytes)) {
             save_setup_state.error = "Failed to load slot";
             return false;
         }
-        match::core::SavePayload payload;
-        try {
-            payload = match::core::SavePayload::DeserializeBinary(bytes);
-        } catch (const std::exception& ex) {
-            save_setup_state.error = std::string("Corrupt save: ") + ex.what();
+        match::core::SaveGame save;
+        std::string error;
+        if (!match::core::DecodeSaveGame(bytes, save, &error)) {
+            save_setup_state.error = "Corrupt save: " + error;
             return false;
         }
-        if (!ApplySavePayload(payload, board_state, game_ctx, ui_settings)) {
+        if (!ApplySaveGame(save, board_state, game_ctx, ui_settings)) {
             save_setup_state.error = "Unable to apply save";
             return false;
         }
@@ -3215,12 +3532,9 @@ int main(int /*argc*/, char* /*argv*/[]) {
                 std::filesystem::remove(parent, ec);
             }
         }
+        ForgetSaveSummary(slot.path);
         save_slots_dirty = true;
         refresh_save_slots();
-        save_setup_state.summaries.clear();
-        for (const auto& entry : save_setup_state.slots) {
-            save_setup_state.summaries.push_back(BuildSaveSummary(save_service, entry));
-        }
         save_setup_state.selected_index =
             std::clamp(save_setup_state.selected_index, 0, static_cast<int>(save_setup_state.slots.size()));
         save_setup_state.error.clear();
@@ -3248,7 +3562,11 @@ int main(int /*argc*/, char* /*argv*/[]) {
             }
             save_detail_state.is_new = false;
             save_detail_state.slot = save_setup_state.slots[static_cast<std::size_t>(slot_index)];
-            save_detail_state.summary = save_setup_state.summaries[static_cast<std::size_t>(slot_index)];
+            auto& summary = save_setup_state.summaries[static_cast<std::size_t>(slot_index)];
+            if (summary.pending) {
+                summary = BuildSaveSummary(save_service, summary.slot);
+            }
+            save_detail_state.summary = summary;
             save_detail_state.info_lines = save_detail_state.summary.detail_lines;
             if (!save_detail_state.summary.error.empty()) {
                 save_detail_state.info_lines.push_back(save_detail_state.summary.error);
@@ -3296,10 +3614,6 @@ int main(int /*argc*/, char* /*argv*/[]) {
         save_setup_state.first_visible = 0;
         save_setup_state.error.clear();
         save_setup_state.entry_bounds.clear();
-        save_setup_state.summaries.clear();
-        for (const auto& slot : save_setup_state.slots) {
-            save_setup_state.summaries.push_back(BuildSaveSummary(save_service, slot));
-        }
         save_setup_cancel_target = cancel_target;
         save_setup_intent = intent;
         deactivate_osk();
@@ -3313,7 +3627,176 @@ int main(int /*argc*/, char* /*argv*/[]) {
         current_screen = AppScreen::SaveSetup;
         set_save_setup_title();
     };
+
+    // Anything that changes on screen without input: animations, timers
+    // that count down, a computer turn in progress. Without it the loop
+    // sleeps until the next event.
+    ReplayPlayback replay_playback;
+    auto frame_is_active = [&]() {
+        if (current_screen == AppScreen::Intro) {
+            return true;
+        }
+        if (font_library.pending()) {
+            return true;
+        }
+        if (save_service.Busy()) {
+            return true;
+        }
+        if (replay_playback.active) {
+            return true;
+        }
+        if (current_screen == AppScreen::SaveSetup && save_summaries_pending) {
+            return true;
+        }
+        if (g_banner.visible && !g_banner.persistent) {
+            return true;
+        }
+        if (current_screen != AppScreen::Gameplay || pause_menu_active) {
+            return false;
+        }
+        if (board_state.cascade.active || !board_state.animations.empty()) {
+            return true;
+        }
+        if (game_ctx.game_over) {
+            return false;
+        }
+        if (game_ctx.ai_pending || IsComputerPlayer(game_ctx, game_ctx.active_player)) {
+            return true;
+        }
+        if (game_ctx.time_mode == match::ui::TimeModeOption::Blitz) {
+            return true;
+        }
+        return game_ctx.autosave_enabled && game_ctx.autosave_dirty;
+    };
+    // The text caret blinks on a 450 ms period while text entry is open.
+    auto next_idle_deadline = [&](Uint64 now_ms) -> std::optional<std::uint64_t> {
+        if (text_input_active || osk_state.active) {
+            return now_ms + (450 - now_ms % 450);
+        }
+        return std::nullopt;
+    };
+
+    bool profiler_hud_visible = false;
+    // Heap allocations counted at the top of the current frame; only moves
+    // when built with MATCH_ALLOC_TRACKING.
+    std::uint64_t frame_alloc_start = 0;
+    // SDL timestamp of the oldest input not yet reflected on screen, or 0.
+    std::uint32_t unpresented_input_ms = 0;
+    // Every screen ends its frame here, so the HUD overlays all of them.
+    auto present_frame = [&]() {
+#if MATCH_PROFILING
+        if (profiler_hud_visible) {
+            DrawProfilerHud(renderer, fonts, match::core::AllocTotals().allocations - frame_alloc_start);
+        }
+        {
+            MATCH_PROFILE_SCOPE("render.present");
+            SDL_RenderPresent(renderer);
+        }
+        auto& profiler = match::core::Profiler::Instance();
+        if (unpresented_input_ms != 0 && profiler.enabled()) {
+            const std::uint64_t latency_us =
+                static_cast<std::uint64_t>(SDL_GetTicks() - unpresented_input_ms) * 1000u;
+            profiler.record("input.latency", match::core::Profiler::NowMicros() - latency_us, latency_us);
+        }
+        profiler.markFrame();
+#else
+        SDL_RenderPresent(renderer);
+#endif
+        unpresented_input_ms = 0;
+    };
+    (void)profiler_hud_visible;
+    (void)frame_alloc_start;
+
+    match::app::FrameScheduler frame_scheduler;
+    {
+        SDL_DisplayMode display_mode{};
+        if (SDL_GetWindowDisplayMode(window, &display_mode) == 0) {
+            frame_scheduler.setRefreshRate(display_mode.refresh_rate);
+        }
+    }
+
+    PanelInfo panel_info;
+    // Menu screens that draw only from their own state are kept in one
+    // window-sized target and redrawn when that state, the window or the fonts
+    // change.
+    match::render::RetainedTarget screen_target;
+    auto draw_retained_screen = [&](int width, int height, match::render::ContentKey key, auto&& draw) {
+        key.add(static_cast<int>(current_screen))
+            .add(width)
+            .add(height)
+            .add(static_cast<const void*>(fonts.heading))
+            .add(static_cast<const void*>(fonts.body))
+            .add(static_cast<const void*>(fonts.small));
+        if (screen_target.begin(renderer, SDL_Rect{0, 0, width, height}, key.value())) {
+            draw();
+        }
+        screen_target.end(renderer);
+    };
+
+    const std::filesystem::path replay_path = base_save_root / "replays" / "last.mrpl";
+    if (!replay_arg.empty()) {
+        std::string replay_error;
+        if (ReadReplayFile(replay_arg, replay_playback.replay, replay_error)) {
+            const match::core::MatchRules& rules = replay_playback.replay.rules;
+            ui_settings.mode = GameModeFromToken(replay_playback.replay.mode);
+            if (ui_settings.mode == match::ui::GameMode::Tournament) {
+                // A single match is replayed outside its bracket.
+                ui_settings.mode = match::ui::GameMode::PvP;
+            }
+            ui_settings.total_rounds = rules.rounds;
+            ui_settings.moves_per_round = rules.moves_per_round;
+            ui_settings.turn_order = rules.turn_order == match::core::TurnOrder::RoundRobin
+                                         ? match::ui::TurnOrderOption::RoundRobin
+                                         : match::ui::TurnOrderOption::Consecutive;
+            // Turn timers would run out while the moves fast-forward.
+            ui_settings.time_mode = match::ui::TimeModeOption::Classic;
+            reinitialize_save_service(ui_settings.mode);
+            intro_state.active = false;
+            start_new_game(&replay_playback.replay);
+            // Re-recording would overwrite last.mrpl, often the file being
+            // replayed.
+            game_ctx.replay.stop();
+            replay_playback.active = true;
+            game_ctx.status = "Replaying...";
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot play replay %s: %s",
+                         replay_arg.string().c_str(), replay_error.c_str());
+        }
+    }
+    // Keeps the last finished game, or the one in progress at exit, for
+    // `--replay`.
+    auto write_replay = [&]() {
+        if (!game_ctx.replay.recording()) {
+            return;
+        }
+        if (board_state.cascade.active) {
+            game_ctx.replay.stop();
+        } else {
+            game_ctx.replay.finish(board_state.board);
+        }
+        if (!WriteReplayFile(replay_path, game_ctx.replay.replay())) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to write replay to %s",
+                        replay_path.string().c_str());
+        }
+    };
+
     while (running) {
+        frame_alloc_start = match::core::AllocTotals().allocations;
+        {
+            const bool active = frame_is_active();
+            const Uint64 now_ms = SDL_GetTicks64();
+            const Uint32 wait_ms = frame_scheduler.waitMs(now_ms, active, next_idle_deadline(now_ms));
+            if (wait_ms > 0) {
+                input.WaitForEvent(wait_ms);
+            }
+            if (!active) {
+                // Time spent asleep is not frame time; a move started by the
+                // waking input must not see it as a huge delta.
+                last_counter = SDL_GetPerformanceCounter();
+            }
+            frame_scheduler.beginFrame(SDL_GetTicks64());
+        }
+
         int current_w = 0;
         int current_h = 0;
         SDL_GetWindowSize(window, &current_w, &current_h);
@@ -3333,15 +3816,15 @@ int main(int /*argc*/, char* /*argv*/[]) {
             }
         }
 
-        const float desired_font_scale = ComputeUiScale(current_w, current_h);
-        if (std::abs(desired_font_scale - font_scale) > 0.05f) {
-            Fonts new_fonts = LoadFonts(desired_font_scale);
-            if (new_fonts.heading && new_fonts.body && new_fonts.small) {
-                DestroyFonts(fonts);
-                fonts = new_fonts;
-                font_scale = desired_font_scale;
-            } else {
-                DestroyFonts(new_fonts);
+        const int desired_font_bucket = FontLibrary::BucketIndex(ComputeUiScale(current_w, current_h));
+        if (desired_font_bucket != font_bucket) {
+            // Keep drawing with the current fonts until the new size is open.
+            auto ready = font_library.tryAcquire(desired_font_bucket);
+            if (ready && ready->heading && ready->body && ready->small) {
+                fonts = *ready;
+                font_bucket = desired_font_bucket;
+                font_scale = FontLibrary::BucketScale(font_bucket);
+                prefetch_font_neighbours(font_bucket);
             }
         }
 
@@ -3349,16 +3832,33 @@ int main(int /*argc*/, char* /*argv*/[]) {
             static_cast<int>(std::lround(420.0f * font_scale));
         const int margin_px =
             static_cast<int>(std::lround(60.0f * font_scale));
-        Layout layout = ComputeLayout(current_w, current_h, board_state.board.cols(),
-                                      board_state.board.rows(), panel_px, margin_px);
+        const int board_cols = board_state.board.cols();
+        const int board_rows = board_state.board.rows();
+        Layout layout = ComputeLayout(current_w, current_h, board_cols, board_rows, panel_px, margin_px);
+        match::render::ClampCamera(board_state.camera, layout, board_cols, board_rows);
+        if (board_state.camera.zoom > 1.0f) {
+            layout = ComputeLayout(current_w, current_h, board_cols, board_rows, panel_px, margin_px,
+                                   board_state.camera);
+        }
         board_state.layout = layout;
 
-        auto polled_events = input.Poll();
+        const auto& polled_events = [&]() -> const match::platform::InputQueue& {
+            MATCH_PROFILE_SCOPE("input.poll");
+            return input.Poll();
+        }();
+        if (!polled_events.empty() && unpresented_input_ms == 0) {
+            unpresented_input_ms = polled_events.oldestTimestamp();
+        }
         for (const auto& evt : polled_events) {
             if (evt.type == InputEventType::Quit) {
                 running = false;
                 break;
             }
+            if (evt.type == InputEventType::RenderTargetsReset) {
+                ReleasePanelCache();
+                screen_target.release();
+                continue;
+            }
             if (evt.type == InputEventType::WindowRestored) {
                 if (!window_mode.fullscreen) {
                     if (window_mode.want_maximized) {
@@ -3372,6 +3872,23 @@ int main(int /*argc*/, char* /*argv*/[]) {
                 continue;
             }
 
+#if MATCH_PROFILING
+            if (evt.type == InputEventType::KeyDown && evt.key == match::platform::KeyCode::F3) {
+                profiler_hud_visible = !profiler_hud_visible;
+                continue;
+            }
+            if (evt.type == InputEventType::KeyDown && evt.key == match::platform::KeyCode::F4) {
+                const std::filesystem::path trace_path = base_save_root / "match_trace.json";
+                if (match::core::Profiler::Instance().writeChromeTrace(trace_path.string())) {
+                    SDL_Log("Wrote profiler trace to %s", trace_path.string().c_str());
+                } else {
+                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to write profiler trace to %s",
+                                trace_path.string().c_str());
+                }
+                continue;
+            }
+#endif
+
             switch (evt.type) {
                 case InputEventType::MouseMove:
                 case InputEventType::MouseButtonDown:
@@ -3440,6 +3957,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
                 } else {
                     pause_menu_active = true;
                     pause_menu_state.selected = 0;
+                    CancelAiSearch();
                     PlayClickSound();
                 }
                 continue;
@@ -3847,6 +4365,8 @@ int main(int /*argc*/, char* /*argv*/[]) {
                                 break;
                             case PauseMenuAction::MainMenu:
                                 pause_menu_active = false;
+                                replay_playback.active = false;
+                                CancelAiSearch();
                                 current_screen = AppScreen::MainMenu;
                                 set_main_menu_title();
                                 SDL_ShowCursor(SDL_ENABLE);
@@ -3868,16 +4388,39 @@ int main(int /*argc*/, char* /*argv*/[]) {
                     }
                     switch (evt.type) {
                         case InputEventType::MouseMove:
+                            // Animations hold screen positions, so the camera
+                            // stays put until they finish. The anchor follows
+                            // the pointer regardless, so a drag held across a
+                            // cascade does not jump when it ends.
+                            if (board_state.pan_anchor) {
+                                if (board_state.animations.empty()) {
+                                    match::render::PanCamera(board_state.camera, board_state.layout,
+                                                             static_cast<float>(evt.x - board_state.pan_anchor->x),
+                                                             static_cast<float>(evt.y - board_state.pan_anchor->y));
+                                }
+                                board_state.pan_anchor = SDL_Point{evt.x, evt.y};
+                            }
                             UpdateHoverCell(board_state, evt.x, evt.y);
                             break;
                         case InputEventType::MouseButtonDown:
-                            if (evt.mouse_button == MouseButton::Left &&
+                            if (evt.mouse_button == MouseButton::Left && !replay_playback.active &&
                                 !board_state.cascade.active && board_state.animations.empty()) {
                                 HandleMouseDown(board_state, game_ctx, evt.x, evt.y);
+                            } else if (evt.mouse_button == MouseButton::Right) {
+                                board_state.pan_anchor = SDL_Point{evt.x, evt.y};
                             }
                             break;
                         case InputEventType::MouseButtonUp:
+                            if (evt.mouse_button == MouseButton::Right) {
+                                board_state.pan_anchor.reset();
+                            }
+                            break;
                         case InputEventType::MouseWheel:
+                            if (evt.wheel_y != 0 && board_state.animations.empty()) {
+                                match::render::ZoomCamera(board_state.camera, board_state.layout,
+                                                          std::pow(1.25f, static_cast<float>(evt.wheel_y)),
+                                                          static_cast<float>(evt.x), static_cast<float>(evt.y));
+                            }
                             break;
                         case InputEventType::KeyDown:
                             if (evt.key == KeyCode::Escape) {
@@ -3900,7 +4443,8 @@ int main(int /*argc*/, char* /*argv*/[]) {
                                     MoveControllerCursor(board_state, 1, 0);
                                     break;
                                 case ControllerButton::A:
-                                    if (!board_state.cascade.active && board_state.animations.empty()) {
+                                    if (!replay_playback.active && !board_state.cascade.active &&
+                                        board_state.animations.empty()) {
                                         ControllerSelect(board_state, game_ctx);
                                     }
                                     break;
@@ -3979,6 +4523,17 @@ int main(int /*argc*/, char* /*argv*/[]) {
         last_counter = now;
         UpdateBannerOverlay(delta_ms);
 
+        match::platform::SaveCompletion save_done;
+        while (save_service.PollCompletion(save_done)) {
+            ForgetSaveSummary(save_done.path);
+            if (save_done.ok) {
+                save_slots_dirty = true;
+            } else if (save_done.slot_name == game_ctx.save_slot_file) {
+                game_ctx.status = "Autosave failed";
+                game_ctx.autosave_dirty = true;
+            }
+        }
+
         if (current_screen == AppScreen::Intro) {
             UpdateIntroState(intro_state, delta_ms);
             if (!intro_state.active) {
@@ -3994,11 +4549,21 @@ int main(int /*argc*/, char* /*argv*/[]) {
         if (current_screen == AppScreen::Gameplay && !pause_menu_active) {
         UpdateAnimations(board_state.animations, board_state.hidden_cells, delta_ms);
         UpdateBlitzTimers(board_state, game_ctx, delta_ms);
-            AdvanceCascade(board_state, game_ctx);
+            {
+                MATCH_PROFILE_SCOPE("update.cascade");
+                AdvanceCascade(board_state, game_ctx);
+            }
+            if (replay_playback.active && !board_state.cascade.active) {
+                StepReplayPlayback(board_state, game_ctx, replay_playback);
+            }
+            if (game_ctx.game_over) {
+                write_replay();
+            }
 
             bool banner_blocking = BannerBlocksInput();
             bool can_ai_move = !board_state.cascade.active && board_state.animations.empty() && !banner_blocking;
-            if (IsComputerPlayer(game_ctx, game_ctx.active_player)) {
+            // While a replay plays, the recording moves for every seat.
+            if (!replay_playback.active && IsComputerPlayer(game_ctx, game_ctx.active_player)) {
                 if (banner_blocking) {
                     game_ctx.ai_pending = false;
                     game_ctx.ai_timer_ms = 0.0f;
@@ -4008,9 +4573,11 @@ int main(int /*argc*/, char* /*argv*/[]) {
                         game_ctx.ai_timer_ms = 0.0f;
                     }
                     if (can_ai_move) {
+                        const bool ai_ready =
+                            PollAiSearch(board_state.board, board_state.legal_moves, game_ctx);
                         game_ctx.ai_timer_ms += delta_ms;
-                        if (game_ctx.ai_timer_ms >= 350.0f) {
-                            auto best = match::core::ai::BestMove(board_state.board);
+                        if (game_ctx.ai_timer_ms >= 350.0f && ai_ready) {
+                            auto best = TakeAiSearchResult();
                             if (best.has_value()) {
                                 if (BeginPlayerMove(board_state, game_ctx, best->move)) {
                                     mark_controller();
@@ -4026,34 +4593,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
                                 const int previous_round = game_ctx.round_current;
                                 const int previous_player = game_ctx.active_player;
                                 const bool previous_game_over = game_ctx.game_over;
-                                SyncPlayerVectors(game_ctx);
-                                if (!game_ctx.moves_left_per_player.empty() &&
-                                    game_ctx.active_player >= 0 &&
-                                    game_ctx.active_player <
-                                        static_cast<int>(game_ctx.moves_left_per_player.size())) {
-                                    game_ctx.moves_left_per_player[static_cast<std::size_t>(
-                                        game_ctx.active_player)] = 0;
-                                }
-
-                                if (RoundComplete(game_ctx)) {
-                                    game_ctx.round_current += 1;
-                                    if (game_ctx.round_current > game_ctx.round_total) {
-                                        game_ctx.game_over = true;
-                                        game_ctx.status = BuildGameOverStatus(game_ctx);
-                                    } else {
-                                        ResetMovesForNewRound(game_ctx);
-                                        game_ctx.active_player = 0;
-                                        game_ctx.status = BuildTurnStatus(game_ctx);
-                                    }
-                                } else {
-                                    int next = NextPlayerWithMoves(game_ctx, game_ctx.active_player);
-                                    if (next >= 0) {
-                                        game_ctx.active_player = next;
-                                    }
-                                    if (!game_ctx.game_over) {
-                                        game_ctx.status = BuildTurnStatus(game_ctx);
-                                    }
-                                }
+                                EndActiveTurn(game_ctx, true);
                                 HandleStateFeedback(game_ctx, previous_round, previous_player, previous_game_over);
                                 UpdateAiPending(game_ctx);
                             }
@@ -4074,11 +4614,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
                 if (game_ctx.autosave_dirty) {
                     game_ctx.autosave_cooldown_ms += delta_ms;
                     if (game_ctx.autosave_cooldown_ms >= 300.0f) {
-                        if (!WriteAutomaticSave(save_service, board_state, game_ctx)) {
-                            game_ctx.status = "Autosave failed";
-                        } else {
-                            save_slots_dirty = true;
-                        }
+                        QueueAutomaticSave(save_service, board_state, game_ctx);
                     }
                 } else {
                     game_ctx.autosave_cooldown_ms = 0.0f;
@@ -4089,36 +4625,42 @@ int main(int /*argc*/, char* /*argv*/[]) {
         SDL_SetRenderDrawColor(renderer, 10, 10, 12, 255);
         SDL_RenderClear(renderer);
 
+        MATCH_ALLOC_SCOPE(UI);
         const bool render_using_controller = (last_input_mode == InputMode::Controller);
 
         if (current_screen == AppScreen::Intro) {
             RenderIntro(renderer, fonts, current_w, current_h, intro_state);
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::MainMenu) {
-            match::ui::RenderMenu(renderer, fonts, current_w, current_h, menu_state,
-                                  render_using_controller);
-            SDL_RenderPresent(renderer);
+            draw_retained_screen(current_w, current_h,
+                                 match::render::ContentKey{}.add(menu_state.selected).add(render_using_controller),
+                                 [&] {
+                                     match::ui::RenderMenu(renderer, fonts, current_w, current_h, menu_state,
+                                                           render_using_controller);
+                                 });
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::SaveSetup) {
             refresh_save_slots();
+            fill_visible_summaries();
             match::ui::RenderSaveSetup(renderer, fonts, current_w, current_h, save_setup_state,
                                        render_using_controller);
             if (osk_state.active && osk_state.show_keyboard) {
                 match::ui::RenderOsk(renderer, fonts, current_w, current_h, osk_state, render_using_controller);
             }
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::SaveDetail) {
             match::ui::RenderSaveDetail(renderer, fonts, current_w, current_h, save_detail_state,
                                         render_using_controller);
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
@@ -4128,26 +4670,48 @@ int main(int /*argc*/, char* /*argv*/[]) {
                 match::ui::RenderOsk(renderer, fonts, current_w, current_h, osk_state,
                                      last_input_mode == InputMode::Controller);
             }
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::TimeMode) {
-            match::ui::RenderTimeMode(renderer, fonts, current_w, current_h, time_mode_state, render_using_controller);
-            SDL_RenderPresent(renderer);
+            draw_retained_screen(
+                current_w, current_h,
+                match::render::ContentKey{}.add(time_mode_state.selected).add(render_using_controller), [&] {
+                    match::ui::RenderTimeMode(renderer, fonts, current_w, current_h, time_mode_state,
+                                              render_using_controller);
+                });
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::BlitzSettings) {
-            match::ui::RenderBlitzSettings(renderer, fonts, current_w, current_h, blitz_state, render_using_controller);
-            SDL_RenderPresent(renderer);
+            draw_retained_screen(current_w, current_h,
+                                 match::render::ContentKey{}
+                                     .add(blitz_state.selected)
+                                     .add(blitz_state.minutes)
+                                     .add(blitz_state.between_seconds)
+                                     .add(render_using_controller),
+                                 [&] {
+                                     match::ui::RenderBlitzSettings(renderer, fonts, current_w, current_h,
+                                                                    blitz_state, render_using_controller);
+                                 });
+            present_frame();
             continue;
         }
 
         if (current_screen == AppScreen::Settings) {
-            match::ui::RenderDisplaySettings(renderer, fonts, current_w, current_h, display_settings_state,
-                                             render_using_controller);
-            SDL_RenderPresent(renderer);
+            draw_retained_screen(current_w, current_h,
+                                 match::render::ContentKey{}
+                                     .add(display_settings_state.fullscreen)
+                                     .add(display_settings_state.selected)
+                                     .add(render_using_controller),
+                                 [&] {
+                                     match::ui::RenderDisplaySettings(renderer, fonts, current_w, current_h,
+                                                                      display_settings_state,
+                                                                      render_using_controller);
+                                 });
+            present_frame();
             continue;
         }
 
@@ -4158,7 +4722,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
             if (osk_state.active && osk_state.show_keyboard) {
                 match::ui::RenderOsk(renderer, fonts, current_w, current_h, osk_state, render_using_controller);
             }
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
@@ -4167,7 +4731,7 @@ int main(int /*argc*/, char* /*argv*/[]) {
             tournament_bracket_state.start_enabled = view.next_match_ready;
             match::ui::RenderTournamentBracket(renderer, fonts, current_w, current_h, tournament_bracket_state, view,
                                                render_using_controller);
-            SDL_RenderPresent(renderer);
+            present_frame();
             continue;
         }
 
@@ -4177,25 +4741,30 @@ int main(int /*argc*/, char* /*argv*/[]) {
             board_state.selected,
             board_state.hover,
             board_state.controller_cursor};
-        DrawBoard(renderer, board_render, layout);
-        DrawBoard(renderer, board_render, layout);
-        DrawAnimations(renderer, board_state.animations, layout);
-        PanelInfo panel = BuildPanelInfo(game_ctx);
-        DrawPanel(renderer, layout, fonts, panel);
+        DrawBoardScene(renderer, board_render, board_state.animations, layout);
+        BuildPanelInfo(game_ctx, panel_info);
+        DrawPanel(renderer, layout, fonts, panel_info);
         DrawBanner(renderer, fonts, layout, g_banner, render_using_controller);
         if (pause_menu_active) {
             RenderPauseMenu(renderer, fonts, current_w, current_h, pause_menu_state);
         }
 
-        SDL_RenderPresent(renderer);
+        present_frame();
     }
 
+    write_replay();
+    // The search thread must be joined here: SharedWorkerPool() is a static
+    // first built on that thread, so it is destroyed before g_ai_work.
+    CancelAiSearch();
+    g_ai_work.search.reset();
     input.Shutdown();
     g_input = nullptr;
     SDL_ShowCursor(SDL_ENABLE);
 
+    screen_target.release();
+    ReleasePanelCache();
     DestroyIntroResources(intro_state);
-    DestroyFonts(fonts);
+    font_library.shutdown();
     if (audio_ready) {
         audio.Shutdown();
         g_audio = nullptr;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace match::app {
+
+// Packed asset file written by match_assetpack:
+//
+//   "MPAK" u32 version u32 entry_count u32 names_bytes
+//   entry_count x { u64 name_hash, u64 offset, u64 size, u32 name_offset, u32 name_length }
+//   names, then file data, each file 16-byte aligned
+//
+// Integers are little-endian. Entries are sorted by (hash, name) so lookups
+// binary-search the mapped manifest in place. Names are relative paths with
+// '/' separators, lower-cased so lookups behave like the case-insensitive
+// Windows and macOS file systems the loose assets are shipped on.
+inline constexpr std::uint32_t kAssetArchiveVersion = 1;
+
+std::string NormalizeAssetName(std::string_view name);
+std::uint64_t HashAssetName(std::string_view normalized) noexcept;
+
+struct AssetBlob {
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+    explicit operator bool() const noexcept { return data != nullptr; }
+};
+
+// A read-only memory mapping of an archive. Blobs point into the mapping
+// and stay valid until close().
+class AssetArchive {
+public:
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::filesystem::path& path);
+    void close();
+    bool isOpen() const noexcept { return base_ != nullptr; }
+
+    AssetBlob find(std::string_view name) const;
+    std::size_t entryCount() const noexcept { return entry_count_; }
+
+private:
+    bool validate();
+    std::string_view entryName(std::size_t index) const;
+
+    const std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t entry_count_ = 0;
+    const std::uint8_t* entries_ = nullptr;
+    const std::uint8_t* names_ = nullptr;
+    std::size_t names_bytes_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+struct AssetSource {
+    std::string name;
+    std::filesystem::path path;
+};
+
+// Every regular file under each root, named relative to its root. A later
+// root's file replaces an earlier one with the same name, so platform
+// folders can override assets_common.
+std::vector<AssetSource> CollectAssetSources(const std::vector<std::filesystem::path>& roots);
+
+bool WriteAssetArchive(const std::filesystem::path& out_path,
+                       const std::vector<AssetSource>& sources,
+                       std::string* error = nullptr);
+
+}  // namespace match::app
@@ -4,13 +4,29 @@
 #include <string>
 #include <vector>
 
+#include "match/app/AssetArchive.hpp"
+
+struct SDL_RWops;
+
 namespace match::app {
 
 bool FileExists(const std::filesystem::path& path);
 
+// Loose asset folders, harvested on first use. Only consulted for files the
+// mounted archive does not contain.
 const std::vector<std::filesystem::path>& AssetRoots();
 
+// Resolved once per name; later calls do not touch the file system.
 std::filesystem::path AssetPath(const std::string& filename);
 
+// assets.pak from $MATCH_ASSETS, next to the executable or in the working
+// directory, mapped on first use. Null when none of those has one.
+const AssetArchive* PackedAssets();
+AssetBlob FindPackedAsset(const std::string& filename);
+
+// A read stream for SDL loaders: the archive's bytes when the file is packed,
+// otherwise the loose file. Null when neither exists.
+SDL_RWops* OpenAsset(const std::string& filename);
+
 }  // namespace match::app
 
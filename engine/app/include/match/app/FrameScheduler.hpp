@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace match::app {
+
+// Decides how long the main loop may block on input before drawing its next
+// frame. Active frames (anything animating or counting down) are paced to
+// the display refresh; idle frames sleep until input arrives or the next
+// known deadline, capped at kIdleWaitMs.
+class FrameScheduler {
+public:
+    static constexpr std::uint32_t kIdleWaitMs = 500;
+
+    void setRefreshRate(int hz) noexcept;
+    int refreshRate() const noexcept { return refresh_hz_; }
+
+    // Marks the start of a frame; waits are measured from here.
+    void beginFrame(std::uint64_t now_ms) noexcept;
+
+    std::uint32_t waitMs(std::uint64_t now_ms,
+                         bool active,
+                         std::optional<std::uint64_t> deadline_ms = std::nullopt) const noexcept;
+
+private:
+    int refresh_hz_ = 60;
+    std::uint64_t frame_start_ms_ = 0;
+    bool started_ = false;
+};
+
+}  // namespace match::app
@@ -0,0 +1,334 @@
+#include "match/app/AssetArchive.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace match::app {
+
+namespace {
+
+constexpr std::uint8_t kMagic[4] = {'M', 'P', 'A', 'K'};
+constexpr std::size_t kHeaderBytes = 16;
+constexpr std::size_t kEntryBytes = 32;
+constexpr std::size_t kDataAlignment = 16;
+
+std::uint32_t ReadU32(const std::uint8_t* at) noexcept {
+    return static_cast<std::uint32_t>(at[0]) | (static_cast<std::uint32_t>(at[1]) << 8) |
+           (static_cast<std::uint32_t>(at[2]) << 16) | (static_cast<std::uint32_t>(at[3]) << 24);
+}
+
+std::uint64_t ReadU64(const std::uint8_t* at) noexcept {
+    return static_cast<std::uint64_t>(ReadU32(at)) | (static_cast<std::uint64_t>(ReadU32(at + 4)) << 32);
+}
+
+void AppendU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void AppendU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    AppendU32(out, static_cast<std::uint32_t>(value));
+    AppendU32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+bool Fail(std::string* error, std::string message) {
+    if (error) {
+        *error = std::move(message);
+    }
+    return false;
+}
+
+}  // namespace
+
+std::string NormalizeAssetName(std::string_view name) {
+    std::string normalized;
+    normalized.reserve(name.size());
+    for (char ch : name) {
+        if (ch == '\\') {
+            ch = '/';
+        }
+        if (ch == '/' && (normalized.empty() || normalized.back() == '/')) {
+            continue;
+        }
+        normalized.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
+    }
+    return normalized;
+}
+
+std::uint64_t HashAssetName(std::string_view normalized) noexcept {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char ch : normalized) {
+        hash ^= ch;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::filesystem::path& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    base_ = static_cast<const std::uint8_t*>(view);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    // Everything is read at startup; let the kernel stream it in one go.
+    madvise(view, static_cast<std::size_t>(info.st_size), MADV_WILLNEED);
+    size_ = static_cast<std::size_t>(info.st_size);
+    base_ = static_cast<const std::uint8_t*>(view);
+#endif
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    if (base_) {
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+#else
+        munmap(const_cast<std::uint8_t*>(base_), size_);
+#endif
+    }
+#ifdef _WIN32
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+        file_ = nullptr;
+    }
+#endif
+    base_ = nullptr;
+    size_ = 0;
+    entry_count_ = 0;
+    entries_ = nullptr;
+    names_ = nullptr;
+    names_bytes_ = 0;
+}
+
+// Checks every entry once at open so find() can trust the manifest.
+bool AssetArchive::validate() {
+    if (size_ < kHeaderBytes || std::memcmp(base_, kMagic, sizeof(kMagic)) != 0 ||
+        ReadU32(base_ + 4) != kAssetArchiveVersion) {
+        return false;
+    }
+    entry_count_ = ReadU32(base_ + 8);
+    names_bytes_ = ReadU32(base_ + 12);
+    const std::size_t manifest_end = kHeaderBytes + entry_count_ * kEntryBytes + names_bytes_;
+    if (manifest_end > size_) {
+        return false;
+    }
+    entries_ = base_ + kHeaderBytes;
+    names_ = entries_ + entry_count_ * kEntryBytes;
+    for (std::size_t i = 0; i < entry_count_; ++i) {
+        const std::uint8_t* entry = entries_ + i * kEntryBytes;
+        const std::uint64_t offset = ReadU64(entry + 8);
+        const std::uint64_t length = ReadU64(entry + 16);
+        const std::uint64_t name_offset = ReadU32(entry + 24);
+        const std::uint64_t name_length = ReadU32(entry + 28);
+        if (offset < manifest_end || offset > size_ || length > size_ - offset ||
+            name_offset + name_length > names_bytes_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view AssetArchive::entryName(std::size_t index) const {
+    const std::uint8_t* entry = entries_ + index * kEntryBytes;
+    return std::string_view(reinterpret_cast<const char*>(names_ + ReadU32(entry + 24)), ReadU32(entry + 28));
+}
+
+AssetBlob AssetArchive::find(std::string_view name) const {
+    if (!base_) {
+        return {};
+    }
+    const std::string normalized = NormalizeAssetName(name);
+    const std::uint64_t hash = HashAssetName(normalized);
+    std::size_t lo = 0;
+    std::size_t hi = entry_count_;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::uint64_t mid_hash = ReadU64(entries_ + mid * kEntryBytes);
+        if (mid_hash < hash || (mid_hash == hash && entryName(mid) < normalized)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == entry_count_ || ReadU64(entries_ + lo * kEntryBytes) != hash || entryName(lo) != normalized) {
+        return {};
+    }
+    const std::uint8_t* entry = entries_ + lo * kEntryBytes;
+    return {base_ + ReadU64(entry + 8), static_cast<std::size_t>(ReadU64(entry + 16))};
+}
+
+std::vector<AssetSource> CollectAssetSources(const std::vector<std::filesystem::path>& roots) {
+    std::map<std::string, std::filesystem::path> by_name;
+    for (const auto& root : roots) {
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            const auto relative = it->path().lexically_relative(root);
+            by_name[NormalizeAssetName(relative.generic_string())] = it->path();
+        }
+    }
+    std::vector<AssetSource> sources;
+    sources.reserve(by_name.size());
+    for (auto& [name, path] : by_name) {
+        sources.push_back({name, path});
+    }
+    return sources;
+}
+
+bool WriteAssetArchive(const std::filesystem::path& out_path,
+                       const std::vector<AssetSource>& sources,
+                       std::string* error) {
+    struct Planned {
+        std::string name;
+        std::uint64_t hash = 0;
+        const AssetSource* source = nullptr;
+        std::uint64_t size = 0;
+    };
+    std::vector<Planned> planned;
+    planned.reserve(sources.size());
+    for (const auto& source : sources) {
+        Planned item;
+        item.name = NormalizeAssetName(source.name);
+        item.hash = HashAssetName(item.name);
+        item.source = &source;
+        std::error_code ec;
+        item.size = std::filesystem::file_size(source.path, ec);
+        if (ec) {
+            return Fail(error, "cannot stat " + source.path.string());
+        }
+        planned.push_back(std::move(item));
+    }
+    std::sort(planned.begin(), planned.end(), [](const Planned& a, const Planned& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+    });
+    for (std::size_t i = 1; i < planned.size(); ++i) {
+        if (planned[i].name == planned[i - 1].name) {
+            return Fail(error, "duplicate asset name " + planned[i].name);
+        }
+    }
+
+    std::vector<std::uint8_t> names;
+    for (const auto& item : planned) {
+        names.insert(names.end(), item.name.begin(), item.name.end());
+    }
+    const std::size_t manifest_end = kHeaderBytes + planned.size() * kEntryBytes + names.size();
+    auto align = [](std::uint64_t value) {
+        return (value + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+    };
+
+    std::vector<std::uint8_t> manifest;
+    manifest.insert(manifest.end(), std::begin(kMagic), std::end(kMagic));
+    AppendU32(manifest, kAssetArchiveVersion);
+    AppendU32(manifest, static_cast<std::uint32_t>(planned.size()));
+    AppendU32(manifest, static_cast<std::uint32_t>(names.size()));
+    std::uint64_t offset = align(manifest_end);
+    std::uint32_t name_offset = 0;
+    for (const auto& item : planned) {
+        AppendU64(manifest, item.hash);
+        AppendU64(manifest, offset);
+        AppendU64(manifest, item.size);
+        AppendU32(manifest, name_offset);
+        AppendU32(manifest, static_cast<std::uint32_t>(item.name.size()));
+        name_offset += static_cast<std::uint32_t>(item.name.size());
+        offset = align(offset + item.size);
+    }
+    manifest.insert(manifest.end(), names.begin(), names.end());
+
+    std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return Fail(error, "cannot create " + out_path.string());
+    }
+    out.write(reinterpret_cast<const char*>(manifest.data()), static_cast<std::streamsize>(manifest.size()));
+    std::uint64_t written = manifest.size();
+    std::vector<char> buffer;
+    const char zeros[kDataAlignment] = {};
+    for (const auto& item : planned) {
+        out.write(zeros, static_cast<std::streamsize>(align(written) - written));
+        written = align(written);
+        std::ifstream in(item.source->path, std::ios::binary);
+        buffer.resize(static_cast<std::size_t>(item.size));
+        if (!in || !in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            return Fail(error, "cannot read " + item.source->path.string());
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        written += item.size;
+    }
+    if (!out.good()) {
+        return Fail(error, "write failed for " + out_path.string());
+    }
+    return true;
+}
+
+}  // namespace match::app
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <map>
 #include <mutex>
 
 namespace match::app {
@@ -77,13 +78,64 @@ const std::vector<std::filesystem::path>& AssetRoots() {
 }
 
 std::filesystem::path AssetPath(const std::string& filename) {
+    static std::mutex mutex;
+    static std::map<std::string, std::filesystem::path> resolved;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = resolved.find(filename);
+    if (found != resolved.end()) {
+        return found->second;
+    }
+    std::filesystem::path result(filename);
     for (const auto& root : AssetRoots()) {
         std::filesystem::path candidate = root / filename;
         if (FileExists(candidate)) {
-            return candidate;
+            result = candidate;
+            break;
+        }
+    }
+    resolved.emplace(filename, result);
+    return result;
+}
+
+const AssetArchive* PackedAssets() {
+    static AssetArchive archive;
+    static std::once_flag init_flag;
+    std::call_once(init_flag, [] {
+        std::vector<std::filesystem::path> candidates;
+        if (const char* env = std::getenv("MATCH_ASSETS")) {
+            std::filesystem::path env_path(env);
+            candidates.push_back(env_path.extension() == ".pak" ? env_path : env_path / "assets.pak");
         }
+        if (char* raw_base = SDL_GetBasePath()) {
+            candidates.push_back(std::filesystem::path(raw_base) / "assets.pak");
+            SDL_free(raw_base);
+        }
+        candidates.push_back("assets.pak");
+        for (const auto& candidate : candidates) {
+            if (archive.open(candidate)) {
+                SDL_Log("Mounted %zu packed assets from %s", archive.entryCount(),
+                        candidate.string().c_str());
+                return;
+            }
+        }
+    });
+    return archive.isOpen() ? &archive : nullptr;
+}
+
+AssetBlob FindPackedAsset(const std::string& filename) {
+    const AssetArchive* archive = PackedAssets();
+    return archive ? archive->find(filename) : AssetBlob{};
+}
+
+SDL_RWops* OpenAsset(const std::string& filename) {
+    if (AssetBlob blob = FindPackedAsset(filename)) {
+        return SDL_RWFromConstMem(blob.data, static_cast<int>(blob.size));
+    }
+    std::filesystem::path path = AssetPath(filename);
+    if (!FileExists(path)) {
+        return nullptr;
     }
-    return std::filesystem::path(filename);
+    return SDL_RWFromFile(path.string().c_str(), "rb");
 }
 
 }  // namespace match::app
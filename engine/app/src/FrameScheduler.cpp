@@ -0,0 +1,36 @@
+#include "match/app/FrameScheduler.hpp"
+
+#include <algorithm>
+
+namespace match::app {
+
+void FrameScheduler::setRefreshRate(int hz) noexcept {
+    refresh_hz_ = hz > 0 ? std::clamp(hz, 24, 360) : 60;
+}
+
+void FrameScheduler::beginFrame(std::uint64_t now_ms) noexcept {
+    frame_start_ms_ = now_ms;
+    started_ = true;
+}
+
+std::uint32_t FrameScheduler::waitMs(std::uint64_t now_ms,
+                                     bool active,
+                                     std::optional<std::uint64_t> deadline_ms) const noexcept {
+    if (!started_) {
+        return 0;
+    }
+    if (active) {
+        // Vsync normally absorbs the frame period in SDL_RenderPresent; this
+        // only covers drivers that ignore it.
+        const std::uint64_t period_ms = 1000u / static_cast<std::uint64_t>(refresh_hz_);
+        const std::uint64_t elapsed_ms = now_ms - std::min(now_ms, frame_start_ms_);
+        return static_cast<std::uint32_t>(period_ms > elapsed_ms ? period_ms - elapsed_ms : 0);
+    }
+    std::uint64_t wait_ms = kIdleWaitMs;
+    if (deadline_ms) {
+        wait_ms = std::min(wait_ms, *deadline_ms > now_ms ? *deadline_ms - now_ms : 0);
+    }
+    return static_cast<std::uint32_t>(wait_ms);
+}
+
+}  // namespace match::app
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <optional>
 
 #include "match/core/Board.hpp"
+#include "match/core/LegalMoveIndex.hpp"
 
 namespace match::core::ai {
 
@@ -13,6 +16,36 @@ struct BestMoveResult {
 };
 
 std::optional<BestMoveResult> BestMove(const Board& board);
+// Scores only the swaps the index reports as legal; board must match it.
+std::optional<BestMoveResult> BestMove(const Board& board, const LegalMoveIndex& legal_moves);
+
+enum class Difficulty { Easy, Normal, Hard };
+
+// Lookahead search settings. A depth of 1 is the greedy BestMove.
+struct SearchOptions {
+    // Consecutive own moves searched; iterative deepening stops here.
+    int max_depth = 2;
+    // Moves expanded past the first ply, best immediate score first.
+    int beam_width = 6;
+    // RNG forks averaged at each chance node to model unseen spawns.
+    int spawn_samples = 2;
+    // Deeper iterations are abandoned once this runs out; the one-ply pass
+    // always completes so a legal move is still returned.
+    int time_budget_ms = 60;
+    std::size_t table_entries = std::size_t{1} << 15;
+    // Checked alongside the time budget; when set the search stops early and
+    // returns its one-ply choice.
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+SearchOptions SearchOptionsFor(Difficulty difficulty);
+
+// Iterative-deepening expectimax over the current player's next moves. The
+// first ply uses the board's own RNG, exactly like BestMove; deeper plies
+// average over sampled forks and share a Zobrist-keyed transposition table.
+std::optional<BestMoveResult> SearchBestMove(const Board& board, const SearchOptions& options);
+std::optional<BestMoveResult> SearchBestMove(const Board& board, const LegalMoveIndex& legal_moves,
+                                             const SearchOptions& options);
 
 }  // namespace match::core::ai
 
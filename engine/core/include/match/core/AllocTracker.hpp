@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap accounting by subsystem. Off by default; build with
+// MATCH_ALLOC_TRACKING=1 to replace the global operator new and delete with
+// counting versions. Every allocation is charged to the domain of the
+// innermost MATCH_ALLOC_SCOPE on its thread. When off, the scopes expand to
+// nothing and the stats read as zero.
+#ifndef MATCH_ALLOC_TRACKING
+#define MATCH_ALLOC_TRACKING 0
+#endif
+
+namespace match::core {
+
+inline constexpr bool kAllocTracking = MATCH_ALLOC_TRACKING != 0;
+
+enum class AllocDomain : std::uint8_t { Other, Simulation, AI, Render, UI, Save };
+inline constexpr std::size_t kAllocDomainCount = 6;
+
+const char* AllocDomainName(AllocDomain domain) noexcept;
+
+struct AllocCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes_allocated = 0;
+    // Bytes allocated in the domain and not yet freed, wherever the free
+    // happened.
+    std::int64_t live_bytes = 0;
+};
+
+AllocCounters AllocStats(AllocDomain domain) noexcept;
+// All domains summed. Differences of allocations between two points give
+// the count for the code in between, e.g. one frame.
+AllocCounters AllocTotals() noexcept;
+
+// The domain new allocations on this thread are charged to.
+AllocDomain CurrentAllocDomain() noexcept;
+
+class AllocScope {
+public:
+    explicit AllocScope(AllocDomain domain) noexcept;
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    AllocDomain previous_;
+};
+
+}  // namespace match::core
+
+#define MATCH_ALLOC_CONCAT_INNER(a, b) a##b
+#define MATCH_ALLOC_CONCAT(a, b) MATCH_ALLOC_CONCAT_INNER(a, b)
+
+#if MATCH_ALLOC_TRACKING
+// domain is an AllocDomain enumerator name, e.g. MATCH_ALLOC_SCOPE(AI).
+#define MATCH_ALLOC_SCOPE(domain) \
+    ::match::core::AllocScope MATCH_ALLOC_CONCAT(match_alloc_scope_, __LINE__)(::match::core::AllocDomain::domain)
+#else
+#define MATCH_ALLOC_SCOPE(domain) static_cast<void>(0)
+#endif
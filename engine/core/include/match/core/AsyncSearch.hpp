@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "match/core/AI.hpp"
+
+namespace match::core::ai {
+
+struct AsyncSearchResult {
+    // Set when the search was superseded or cancelled before finishing;
+    // best is then meaningless and the caller should ask again.
+    bool cancelled = false;
+    std::optional<BestMoveResult> best;
+};
+
+// Runs SearchBestMove on a dedicated thread against a board snapshot. Only the
+// latest request matters: starting a new one or calling cancel() stops the
+// search in flight and resolves its future as cancelled.
+class AsyncMoveSearch {
+public:
+    AsyncMoveSearch();
+    ~AsyncMoveSearch();
+
+    AsyncMoveSearch(const AsyncMoveSearch&) = delete;
+    AsyncMoveSearch& operator=(const AsyncMoveSearch&) = delete;
+
+    std::shared_future<AsyncSearchResult> start(const Board& board, const SearchOptions& options);
+    // Same, taking root candidates from an index that matches board.
+    std::shared_future<AsyncSearchResult> start(const Board& board, const LegalMoveIndex& legal_moves,
+                                                const SearchOptions& options);
+    void cancel();
+
+private:
+    struct Job {
+        Board board;
+        std::optional<LegalMoveIndex> legal_moves;
+        SearchOptions options;
+        std::promise<AsyncSearchResult> promise;
+        std::atomic<bool> cancel{false};
+    };
+
+    std::shared_future<AsyncSearchResult> enqueue(std::shared_ptr<Job> job);
+    void workerLoop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::shared_ptr<Job> queued_;
+    std::shared_ptr<Job> running_;
+    bool stopping_{false};
+    // Declared last so the state above exists before the worker starts.
+    std::thread thread_;
+};
+
+}  // namespace match::core::ai
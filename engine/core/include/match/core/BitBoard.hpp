@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace match::core {
+
+// One-bit-per-cell mask over a board grid. Cells are laid out row-major with
+// one guard column past the right edge, so horizontal shifts never carry a
+// run from the end of one row into the start of the next.
+class BitBoard {
+public:
+    using Word = std::uint64_t;
+    static constexpr int kWordBits = 64;
+
+    BitBoard() = default;
+    BitBoard(int cols, int rows);
+
+    int cols() const noexcept { return cols_; }
+    int rows() const noexcept { return rows_; }
+    int stride() const noexcept { return cols_ + 1; }
+    std::size_t wordCount() const noexcept { return words_.size(); }
+
+    bool test(int col, int row) const noexcept {
+        const int bit = row * stride() + col;
+        return (words_[static_cast<std::size_t>(bit / kWordBits)] >> (bit % kWordBits)) & 1u;
+    }
+    void set(int col, int row) noexcept {
+        const int bit = row * stride() + col;
+        words_[static_cast<std::size_t>(bit / kWordBits)] |= Word{1} << (bit % kWordBits);
+    }
+    void reset(int col, int row) noexcept {
+        const int bit = row * stride() + col;
+        words_[static_cast<std::size_t>(bit / kWordBits)] &= ~(Word{1} << (bit % kWordBits));
+    }
+
+    bool any() const noexcept;
+    int count() const noexcept;
+    void clear() noexcept;
+    void fill() noexcept;
+
+    // this &= (src >> bits). Shifting right by 1 lines each cell up with its
+    // right neighbour, by stride() with the cell below.
+    void andShiftedRight(const BitBoard& src, int bits) noexcept;
+    // this |= (src << bits), the inverse used to expand run starts.
+    void orShiftedLeft(const BitBoard& src, int bits) noexcept;
+    // this |= (src >> bits). Bits shifted past the left edge land in the
+    // previous row's guard column.
+    void orShiftedRight(const BitBoard& src, int bits) noexcept;
+    void assign(const BitBoard& other) noexcept;
+    void orWith(const BitBoard& other) noexcept;
+    void andWith(const BitBoard& other) noexcept;
+    void andNot(const BitBoard& other) noexcept;
+
+    // Visits set cells in row-major order.
+    template <typename Fn>
+    void forEachSet(Fn&& fn) const {
+        const int row_stride = stride();
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            Word word = words_[w];
+            while (word != 0) {
+                const int bit = static_cast<int>(w) * kWordBits + LowestBit(word);
+                word &= word - 1;
+                fn(bit % row_stride, bit / row_stride);
+            }
+        }
+    }
+
+    static int LowestBit(Word word) noexcept;
+
+private:
+    void maskTail() noexcept;
+
+    int cols_{0};
+    int rows_{0};
+    std::vector<Word> words_;
+};
+
+}  // namespace match::core
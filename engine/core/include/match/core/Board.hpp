@@ -1,13 +1,24 @@
 #pragma once
 
+#include <cstdint>
 #include <random>
 #include <vector>
 
+#include "match/core/BitBoard.hpp"
 #include "match/core/Types.hpp"
 
+// Cell storage order. Column-major (the default) keeps gravity walking
+// contiguous memory; build with MATCH_BOARD_ROW_MAJOR=1 to store rows
+// contiguously instead. Only Board's internals depend on the choice.
+#ifndef MATCH_BOARD_ROW_MAJOR
+#define MATCH_BOARD_ROW_MAJOR 0
+#endif
+
 namespace match::core {
 
 inline constexpr int kEmptyCell = -1;
+// Tiles are stored as one signed byte per cell.
+inline constexpr int kMaxTileValue = 127;
 
 class Board {
 public:
@@ -46,8 +57,9 @@ public:
     int get(int col, int row) const noexcept;
     int get(const Cell& cell) const noexcept { return get(cell.col, cell.row); }
 
-    void set(int col, int row, int value) noexcept;
-    void set(const Cell& cell, int value) noexcept { set(cell.col, cell.row, value); }
+    // Values outside [kEmptyCell, kMaxTileValue] are stored as kEmptyCell.
+    void set(int col, int row, int value);
+    void set(const Cell& cell, int value) { set(cell.col, cell.row, value); }
 
     void swapCells(const Cell& a, const Cell& b) noexcept;
     void swapCells(const Move& move) noexcept { swapCells(move.a, move.b); }
@@ -62,8 +74,22 @@ public:
 
     void fillAll(int value);
 
+    // Per-tile occupancy masks kept in sync with the cell grid. Returns
+    // nullptr for kEmptyCell and tiles that have never been placed.
+    const BitBoard* tilePlane(int tile) const noexcept;
+    int planeCount() const noexcept { return static_cast<int>(planes_.size()); }
+
 private:
-    int index(int col, int row) const noexcept;
+    using Tile = std::int8_t;
+
+    int index(int col, int row) const noexcept {
+#if MATCH_BOARD_ROW_MAJOR
+        return row * cols_ + col;
+#else
+        return col * rows_ + row;
+#endif
+    }
+    void ensurePlane(int tile);
 
     Rules rules_{};
     int cols_{0};
@@ -71,10 +97,15 @@ private:
     int tile_types_{0};
     bool bombs_enabled_{false};
     bool color_chain_enabled_{false};
-    std::vector<int> cells_;
+    std::vector<Tile> cells_;
+    std::vector<BitBoard> planes_;
     std::mt19937 rng_{};
 };
 
+// Builds a board in a single pass with no standing run, no 2x2 square when
+// bombs are enabled (so color chains have nothing to spread from), and at
+// least one legal swap. Holds for four or more tile types; smaller sets are
+// best effort. The same rules and seed always give the same board.
 Board NewBoard(const Board::Rules& rules, std::uint32_t seed = std::random_device{}());
 
 bool HasMatchAt(const Board& board, int col, int row);
@@ -83,7 +114,16 @@ bool HasMatchAt(const Board& board, const Cell& cell);
 using MatchGroup = std::vector<Cell>;
 std::vector<MatchGroup> FindAllMatches(const Board& board);
 
+struct SimulationScratch;
+
 bool LegalSwap(Board& board, const Move& move);
+bool LegalSwap(Board& board, const Move& move, SimulationScratch& scratch);
+
+// Inspects only the row and column through each swapped cell and the 2x2
+// windows touching them. Agrees with LegalSwap on settled boards, i.e. ones
+// with no standing match or bomb square, which is every board a cascade
+// leaves behind.
+bool LegalSwapLocal(const Board& board, const Move& move);
 
 struct SimulationResult {
     int score = 0;
@@ -128,8 +168,57 @@ struct SimulationResult {
     std::vector<ChainEvent> chain_events;
 };
 
+// Caller-owned working memory for LegalSwap and SimulateFullChain. Masks are
+// resized the first time a board of a new size is seen and reused after
+// that, so a long-lived scratch keeps repeated simulations off the heap.
+struct SimulationScratch {
+    void prepare(int cols, int rows);
+
+    BitBoard run_starts;
+    BitBoard run_horizontal;
+    BitBoard run_vertical;
+    BitBoard squares;
+    BitBoard matched;
+    BitBoard neighbors;
+    BitBoard removed;
+    std::vector<Cell> corners;
+    std::vector<Cell> cells;
+    // Per column, the lowest row StepChain has to collapse, or -1.
+    std::vector<int> column_bottom;
+};
+
+enum class SimulationEvents {
+    Record,
+    // Fill in the summary fields only; the event vectors stay empty.
+    Skip,
+};
+
 SimulationResult SimulateFullChain(Board& board, const Move& move);
+SimulationResult SimulateFullChain(Board& board, const Move& move, SimulationScratch& scratch,
+                                   SimulationEvents events = SimulationEvents::Record);
+
+// Running totals of a cascade resolved with StepChain.
+struct CascadeTotals {
+    int total_cleared = 0;
+    int chains = 0;
+    int bombs_triggered = 0;
+    bool color_chain_triggered = false;
+
+    int score() const noexcept { return total_cleared >= 3 ? 1 + (total_cleared - 3) : 0; }
+};
 
-bool AnyLegalMoves(Board& board);
+// Resolves a single chain on board: clears what its current layout matches,
+// drops the tiles above and spawns refills. Returns false, leaving board
+// untouched, once nothing clears. When chain is non-null it is refilled with
+// this chain's events, reusing the storage of its vectors and of the
+// ClearEvents it already held, so a caller stepping one ChainEvent stops
+// allocating once it has seen its largest chain. SimulateFullChain is a swap
+// followed by StepChain until it returns false, so stepping draws the same
+// spawns from board's generator; it moves each chain into its result, so it
+// starts every chain from empty storage.
+bool StepChain(Board& board, SimulationScratch& scratch, CascadeTotals& totals,
+               SimulationResult::ChainEvent* chain = nullptr);
+
+bool AnyLegalMoves(const Board& board);
 
 }  // namespace match::core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "match/core/Board.hpp"
+
+namespace match::core {
+
+// Keeps a few boards per rule set generated ahead of time on a background
+// thread, so new rounds and tournament matches do not wait on NewBoard.
+// Every board comes with the seed that produced it; NewBoard(rules, seed)
+// rebuilds it exactly, which keeps pooled games replayable.
+class BoardPool {
+public:
+    struct Entry {
+        std::uint32_t seed = 0;
+        Board board;
+    };
+
+    explicit BoardPool(std::size_t depth = 4);
+    ~BoardPool();
+
+    BoardPool(const BoardPool&) = delete;
+    BoardPool& operator=(const BoardPool&) = delete;
+
+    // Starts filling boards for rules without taking one.
+    void prefill(const Board::Rules& rules);
+    // Hands out a ready board, or builds one on the calling thread when the
+    // pool is empty. Either way the rules are topped up in the background.
+    Entry take(const Board::Rules& rules);
+
+    std::size_t ready(const Board::Rules& rules) const;
+
+private:
+    struct Shelf {
+        Board::Rules rules;
+        std::deque<Entry> boards;
+    };
+
+    // Both expect mutex_ to be held.
+    Shelf& shelfFor(const Board::Rules& rules);
+    Shelf* nextToFill();
+    void workerLoop();
+
+    const std::size_t depth_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Shelf> shelves_;
+    std::mt19937 seeds_;
+    bool stopping_{false};
+    // Declared last so the state above exists before the worker starts.
+    std::thread thread_;
+};
+
+// Process-wide pool used by the game front end.
+BoardPool& SharedBoardPool();
+
+}  // namespace match::core
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "match/core/Board.hpp"
+
+namespace match::core {
+
+// A multiple of 8, the lanes held by one 64-bit word.
+inline constexpr int kCascadeLanes = 16;
+
+// Score-only cascades for many independent rollouts. Up to kCascadeLanes run
+// at once, each lane with its own board and generator; every rollout in a
+// batch shares one shape and rule set. Tiles are packed one byte per cell
+// with the lanes of a cell side by side in 64-bit words, so each matching
+// pass is one sweep over the board comparing eight lanes per operation, and
+// gravity compacts each lane's columns in place. Lanes step their chains in
+// lockstep; a lane whose rollout settles takes the next queued one.
+//
+// A rollout ends with exactly the totals, cells and generator state that
+// SimulateFullChain(..., SimulationEvents::Skip) leaves on a copy of its
+// board. A long-lived batch keeps repeated runs off the heap.
+class CascadeBatch {
+public:
+    // Queues move on a copy of board, spawning from a copy of board's
+    // generator or of *rng. board and rng are read during run() and must
+    // outlive it. When result is non-null the final board and generator are
+    // copied into it; it must have board's shape. Returns the rollout's index,
+    // or -1 when board's shape or rules differ from the rollouts already
+    // queued.
+    int add(const Board& board, const Move& move, const std::mt19937* rng = nullptr, Board* result = nullptr);
+
+    // Resolves every queued rollout.
+    void run();
+
+    std::size_t size() const noexcept { return jobs_.size(); }
+    const CascadeTotals& totals(std::size_t rollout) const noexcept { return jobs_[rollout].totals; }
+
+    // Drops every rollout; the memory is kept for the next batch.
+    void clear() noexcept { jobs_.clear(); }
+
+private:
+    struct Job {
+        const Board* board = nullptr;
+        Move move{};
+        const std::mt19937* rng = nullptr;
+        Board* result = nullptr;
+        CascadeTotals totals{};
+    };
+
+    // Cells are padded by two on every side so each pass can read its
+    // neighbours without bounds checks; padding holds kEmptyCell.
+    int index(int col, int row) const noexcept { return (col + 2) * stride_ + row + 2; }
+    void prepare(const Board& board);
+    // Loads queued rollouts into lane until one needs stepping. Returns
+    // false once the queue is empty.
+    bool load(int lane);
+    void finish(int lane);
+    bool step();
+
+    int cols_{0};
+    int rows_{0};
+    int stride_{0};
+    int tile_types_{0};
+    bool bombs_{false};
+    bool color_chain_{false};
+    std::vector<Job> jobs_;
+    std::size_t next_job_{0};
+    // kCascadeLanes / 8 words per cell. Masks use the top bit of each byte.
+    std::vector<std::uint64_t> tiles_;
+    std::vector<std::uint64_t> run_h_;
+    std::vector<std::uint64_t> run_v_;
+    std::vector<std::uint64_t> matched_;
+    std::vector<std::uint64_t> squares_;
+    std::vector<std::uint64_t> blast_;
+    std::vector<std::uint64_t> removed_;
+    // Per column, the lanes with a cleared cell in it.
+    std::vector<std::uint64_t> column_removed_;
+    std::vector<std::mt19937> rngs_;
+    // The rollout each lane is stepping, or -1.
+    std::array<int, kCascadeLanes> lane_job_{};
+    // Lanes whose board has a hole outside the cells being cleared, which
+    // makes gravity sweep every column as StepChain does.
+    std::array<bool, kCascadeLanes> holes_{};
+};
+
+}  // namespace match::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "match/core/Board.hpp"
+
+namespace match::core {
+
+// Set of legal adjacent swaps on a board, kept current by replaying the cells a
+// cascade touched instead of rescanning every pair. Legality follows
+// LegalSwapLocal, so the index assumes the board is settled between updates.
+class LegalMoveIndex {
+public:
+    LegalMoveIndex() = default;
+    explicit LegalMoveIndex(const Board& board) { rebuild(board); }
+
+    void rebuild(const Board& board);
+    // Refreshes the swaps near every cell the result cleared, moved or
+    // spawned, plus the swapped pair itself. board must already hold the
+    // post-cascade state.
+    void update(const Board& board, const SimulationResult& result);
+    void update(const Board& board, const std::vector<Cell>& changed);
+
+    bool any() const noexcept { return !moves_.empty(); }
+    std::size_t count() const noexcept { return moves_.size(); }
+    bool isLegal(const Move& move) const noexcept;
+    // First legal swap in board scan order, for hints.
+    std::optional<Move> hint() const;
+    // Legal swaps in board scan order (column-major origin, right before down).
+    std::vector<Move> moves() const;
+
+private:
+    static constexpr int kNoMove = -1;
+
+    int slotFor(const Move& move) const noexcept;
+    Move moveForSlot(int slot) const noexcept;
+    void refreshSlot(const Board& board, int slot);
+
+    int cols_{0};
+    int rows_{0};
+    // Two slots per origin cell: swap with the cell to the right, then below.
+    // position_ maps a slot to its entry in moves_ or kNoMove; dirty_ marks
+    // origins already queued during an update.
+    std::vector<int> position_;
+    std::vector<int> moves_;
+    std::vector<char> dirty_;
+};
+
+}  // namespace match::core
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "match/core/Board.hpp"
+#include "match/core/LegalMoveIndex.hpp"
+#include "match/core/Replay.hpp"
+#include "match/core/SelfPlay.hpp"
+#include "match/core/WorkerPool.hpp"
+
+namespace match::core {
+
+// Whose turn it is and what is left of the round.
+struct TurnState {
+    int round = 1;
+    int active_player = 0;
+    std::vector<int> moves_left;
+    bool game_over = false;
+};
+
+TurnState StartTurns(const MatchRules& rules);
+
+// Ends the active seat's turn. A played move costs one of the seat's moves;
+// a forfeit (a blitz timeout, or a computer with no legal swap) gives up the
+// rest of its round. Once every seat is out of moves the next round starts
+// with seat 0, and the game ends after the last round.
+void EndTurn(const MatchRules& rules, TurnState& turns, bool forfeit = false);
+
+// One match with no platform dependencies: the board, the turn rules and the
+// scores. Sessions share no state, so any number can be advanced from
+// different threads as long as each is used by one thread at a time.
+class MatchSession {
+public:
+    MatchSession(const MatchRules& rules, std::uint32_t seed);
+
+    const MatchRules& rules() const noexcept { return rules_; }
+    const Board& board() const noexcept { return board_; }
+    const LegalMoveIndex& legalMoves() const noexcept { return legal_moves_; }
+    const TurnState& turns() const noexcept { return turns_; }
+    const std::vector<int>& scores() const noexcept { return scores_; }
+    bool gameOver() const noexcept { return turns_.game_over; }
+    int activePlayer() const noexcept { return turns_.active_player; }
+    // The moves played so far; stamped with the final board once the game
+    // ends, so a hosted match can be checked with PlayReplay.
+    const Replay& replay() const noexcept { return replay_; }
+
+    // Plays move for the active seat and resolves the whole cascade. Returns
+    // false, changing nothing, once the game is over or when the swap does
+    // not match. result, when non-null, receives the cascade.
+    bool play(const Move& move, SimulationResult* result = nullptr);
+    void forfeitTurn();
+
+private:
+    void finishTurn(bool forfeit);
+
+    MatchRules rules_;
+    Board board_;
+    LegalMoveIndex legal_moves_;
+    SimulationScratch scratch_;
+    TurnState turns_;
+    std::vector<int> scores_;
+    Replay replay_;
+};
+
+// Hosts independent matches in one process. Seats with a SeatPolicy are
+// played by the host; remote seats wait for moves passed to submit(), which
+// any thread may call. advance() spreads the sessions over the pool, so
+// hundreds of boards cost one parallelFor per tick.
+class SessionHost {
+public:
+    using SessionId = std::size_t;
+
+    struct Seat {
+        SeatPolicy policy;
+        bool remote = false;
+    };
+
+    explicit SessionHost(WorkerPool& pool = SharedWorkerPool());
+
+    SessionHost(const SessionHost&) = delete;
+    SessionHost& operator=(const SessionHost&) = delete;
+
+    // Seats beyond the end of seats play greedy. Not safe to call while
+    // other threads submit moves.
+    SessionId open(const MatchRules& rules, std::uint32_t seed, std::vector<Seat> seats = {});
+    std::size_t size() const noexcept { return sessions_.size(); }
+
+    // Queues a move for the session. The next advance() plays queued moves in
+    // order while a remote seat is to move; a swap that is not legal when its
+    // turn comes is dropped.
+    void submit(SessionId id, const Move& move);
+
+    // Plays up to max_moves moves in every unfinished session and returns
+    // how many sessions are still running. Must not overlap another
+    // advance() or calls to session().
+    std::size_t advance(int max_moves = 1);
+    // Advances until every session has finished or is waiting on a remote
+    // seat.
+    void runToCompletion();
+
+    const MatchSession& session(SessionId id) const { return sessions_[id]->match; }
+
+private:
+    struct Hosted {
+        Hosted(const MatchRules& rules, std::uint32_t seed) : match(rules, seed) {}
+
+        MatchSession match;
+        std::vector<Seat> seats;
+        std::mutex inbox_mutex;
+        std::deque<Move> inbox;
+    };
+
+    static const Seat* activeSeat(const Hosted& hosted);
+    static bool waitingOnRemote(Hosted& hosted);
+    // False when the active seat is remote and has nothing queued. Seats,
+    // remote or not, forfeit their turn when the board has no legal swap.
+    static bool playOne(Hosted& hosted);
+
+    WorkerPool& pool_;
+    std::vector<std::unique_ptr<Hosted>> sessions_;
+};
+
+}  // namespace match::core
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Scoped phase timers. On by default in builds without NDEBUG; build with
+// MATCH_PROFILING=0 or 1 to force either way. When off, MATCH_PROFILE_SCOPE
+// expands to nothing and no timing code is emitted.
+#ifndef MATCH_PROFILING
+#ifdef NDEBUG
+#define MATCH_PROFILING 0
+#else
+#define MATCH_PROFILING 1
+#endif
+#endif
+
+namespace match::core {
+
+// Process-wide record of timed scopes from any thread. Each scope lands in a
+// fixed-size ring of trace events (for Chrome's about:tracing) and in a
+// per-name window of recent durations used for the on-screen summary.
+class Profiler {
+public:
+    static constexpr std::size_t kTraceCapacity = std::size_t{1} << 16;
+    static constexpr std::size_t kSampleWindow = 240;
+
+    struct PhaseStats {
+        std::string name;
+        std::size_t samples = 0;
+        double average_ms = 0.0;
+        double p99_ms = 0.0;
+        double last_ms = 0.0;
+    };
+
+    static Profiler& Instance();
+
+    bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+    void setEnabled(bool value) noexcept { enabled_.store(value, std::memory_order_relaxed); }
+
+    // Microseconds on a steady clock shared by every recorded event.
+    static std::uint64_t NowMicros() noexcept;
+
+    void record(const char* name, std::uint64_t start_us, std::uint64_t duration_us);
+    // Records the time since the previous call as the "frame" phase.
+    void markFrame();
+
+    // Sorted by name, with "frame" first. Durations of scopes sharing a name
+    // are pooled.
+    std::vector<PhaseStats> phaseStats() const;
+    void clear();
+
+    // Chrome trace-event JSON ("X" complete events) for everything still in
+    // the ring. Returns false if the file could not be written.
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    struct TraceEvent {
+        const char* name = nullptr;
+        std::uint64_t start_us = 0;
+        std::uint64_t duration_us = 0;
+        std::uint32_t thread = 0;
+    };
+
+    struct Samples {
+        std::vector<std::uint64_t> durations_us;
+        std::size_t next = 0;
+        std::uint64_t last_us = 0;
+    };
+
+    Profiler();
+
+    std::atomic<bool> enabled_{true};
+    mutable std::mutex mutex_;
+    std::vector<TraceEvent> trace_;
+    std::size_t trace_next_{0};
+    bool trace_wrapped_{false};
+    // Keyed by the literal's address; phaseStats merges literals that spell
+    // the same name but live in different translation units.
+    std::unordered_map<const char*, Samples> samples_;
+    std::uint64_t last_frame_us_{0};
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name) noexcept
+        : name_(name), start_us_(Profiler::Instance().enabled() ? Profiler::NowMicros() : 0) {}
+    ~ScopedTimer() {
+        if (start_us_ != 0) {
+            Profiler::Instance().record(name_, start_us_, Profiler::NowMicros() - start_us_);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_us_;
+};
+
+}  // namespace match::core
+
+#define MATCH_PROFILE_CONCAT_INNER(a, b) a##b
+#define MATCH_PROFILE_CONCAT(a, b) MATCH_PROFILE_CONCAT_INNER(a, b)
+
+#if MATCH_PROFILING
+// name must be a string literal (or otherwise outlive the profiler).
+#define MATCH_PROFILE_SCOPE(name) \
+    ::match::core::ScopedTimer MATCH_PROFILE_CONCAT(match_profile_scope_, __LINE__)(name)
+#else
+#define MATCH_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "match/core/Board.hpp"
+#include "match/core/SelfPlay.hpp"
+
+namespace match::core {
+
+// A game is a pure function of the seed handed to NewBoard and the swaps
+// played on it, so a replay stores just those: the rules, the seed and one
+// entry per accepted move. Turn order is not re-derived on playback; each
+// move names the seat that played it, which keeps skipped turns (blitz
+// timeouts, stalled computers) out of the format. The version changes
+// whenever NewBoard would build a different board from the same seed.
+inline constexpr std::uint16_t kReplayVersion = 2;
+
+struct ReplayMove {
+    Move move;
+    // Milliseconds since recording started.
+    std::uint32_t time_ms = 0;
+    int player = 0;
+};
+
+struct Replay {
+    std::uint32_t seed = 0;
+    MatchRules rules{};
+    std::string mode;
+    std::vector<std::string> players;
+    std::vector<ReplayMove> moves;
+    // BoardDigest after the last move, or 0 when the recording was cut short.
+    std::uint64_t final_digest = 0;
+};
+
+// FNV-1a over the board size and tiles in row-major order.
+std::uint64_t BoardDigest(const Board& board) noexcept;
+
+// Moves are written as a varint time delta, a varint cell index and one byte
+// holding the swap direction and seat, so a typical move takes four bytes.
+void EncodeReplay(const Replay& replay, std::vector<std::uint8_t>& out);
+bool DecodeReplay(const std::uint8_t* data, std::size_t size, Replay& out,
+                  std::string* error = nullptr);
+bool DecodeReplay(const std::vector<std::uint8_t>& bytes, Replay& out,
+                  std::string* error = nullptr);
+
+// Captures moves as they are accepted. Only games started from a seed can be
+// recorded; a game resumed from a save has no seed to replay from.
+class ReplayRecorder {
+public:
+    void start(std::uint32_t seed, const MatchRules& rules, std::string mode,
+               std::vector<std::string> players);
+    void stop() noexcept { recording_ = false; }
+    bool recording() const noexcept { return recording_; }
+
+    void record(const Move& move, int player);
+    // Stamps the digest of the board the last move left behind and stops.
+    void finish(const Board& board);
+
+    const Replay& replay() const noexcept { return replay_; }
+
+private:
+    Replay replay_;
+    std::chrono::steady_clock::time_point started_{};
+    bool recording_ = false;
+};
+
+struct ReplayResult {
+    std::vector<int> scores;
+    int moves_played = 0;
+    // Index of the first move that was not a legal swap on the reproduced
+    // board, or -1 when every move applied.
+    int diverged_at = -1;
+    std::uint64_t final_digest = 0;
+    // False when the replay carries a digest and the reproduced board
+    // differs from it.
+    bool digest_matches = true;
+    double elapsed_ms = 0.0;
+
+    bool ok() const noexcept { return diverged_at < 0 && digest_matches; }
+};
+
+// Replays every move headlessly, resolving each cascade with
+// SimulateFullChain without recording its events. board, when non-null,
+// receives the final position.
+ReplayResult PlayReplay(const Replay& replay, Board* board = nullptr);
+
+}  // namespace match::core
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "match/core/Board.hpp"
+#include "match/core/SavePayload.hpp"
+
+namespace match::core {
+
+// Save files written by EncodeSaveGame. Version 1 is the SavePayload
+// JSON/msgpack layout, which DecodeSaveGame still reads.
+inline constexpr std::uint16_t kSaveGameVersion = 2;
+
+struct SaveHeader {
+    std::uint16_t version = kSaveGameVersion;
+    std::string mode;
+    std::int64_t timestamp = 0;
+    std::string save_name;
+    std::vector<std::string> players;
+};
+
+// The GameContext fields a save restores. Option values are kept as the
+// app's string tokens so core does not depend on the ui enums.
+struct SaveSession {
+    std::vector<int> player_scores;
+    std::vector<int> moves_left_per_player;
+    int player_count = 2;
+    int active_player = 0;
+    int round_current = 1;
+    int round_total = 5;
+    int total_moves = 0;
+    int moves_per_round = 3;
+    std::string turn_order = "Consecutive";
+    std::string ai_difficulty = "normal";
+    std::string time_mode = "classic";
+    bool bombs_enabled = true;
+    bool color_blast_enabled = true;
+    int blitz_turn_minutes = 2;
+    int blitz_between_seconds = 10;
+    float blitz_turn_total_ms = 0.0f;
+    float blitz_turn_remaining_ms = 0.0f;
+    float blitz_pre_turn_ms = 0.0f;
+    bool blitz_pre_turn_active = false;
+    bool blitz_turn_active = false;
+    bool game_over = false;
+};
+
+// Mirrors ui::GameSettings, again with string tokens for the options.
+struct SaveSettings {
+    std::string mode = "pvc";
+    int player_count = 2;
+    std::vector<std::string> player_names;
+    std::string turn_order = "Consecutive";
+    int moves_per_round = 3;
+    int total_rounds = 5;
+    bool bombs_enabled = true;
+    bool color_blast_enabled = false;
+    std::string time_mode = "classic";
+    int blitz_turn_minutes = 2;
+    int blitz_between_seconds = 10;
+    std::string ai_difficulty = "normal";
+};
+
+struct SaveTournament {
+    struct Match {
+        int player_a = -1;
+        int player_b = -1;
+        int winner = -1;
+    };
+
+    bool active = false;
+    std::vector<std::string> players;
+    std::vector<std::vector<Match>> rounds;
+    int current_round = -1;
+    int current_match = -1;
+    std::array<int, 2> active_pair{{-1, -1}};
+    bool awaiting_next_match = false;
+    std::string last_summary;
+    std::optional<SaveSettings> base_settings;
+};
+
+struct SaveGame {
+    SaveHeader header;
+    Board board;
+    // False for version 1 saves, which did not record the generator.
+    bool has_rng = false;
+    SaveSession session;
+    std::optional<SaveTournament> tournament;
+};
+
+// Appends a version 2 save to out after clearing it, so a buffer reused
+// across autosaves stops allocating once it has grown to one save's size.
+// Tiles are written as one byte per cell and the board's generator state is
+// included, so a resumed game refills exactly as it would have.
+void EncodeSaveGame(const SaveHeader& header,
+                    const Board& board,
+                    const SaveSession& session,
+                    const SaveTournament* tournament,
+                    std::vector<std::uint8_t>& out);
+
+bool IsBinarySave(const std::uint8_t* data, std::size_t size) noexcept;
+
+// Reads a version 2 save in one pass, or falls back to the version 1
+// msgpack payload. Returns false and fills error for unreadable input.
+bool DecodeSaveGame(const std::uint8_t* data, std::size_t size, SaveGame& out,
+                    std::string* error = nullptr);
+bool DecodeSaveGame(const std::vector<std::uint8_t>& bytes, SaveGame& out,
+                    std::string* error = nullptr);
+
+enum class SaveRead { Ok, Truncated, Invalid, Unsupported };
+
+// Fills header, session and tournament from the start of a version 2 save,
+// stopping at the board, so a file prefix is enough to describe a slot.
+// Truncated means the prefix ended first; Unsupported means the data is not
+// a version 2 save and needs a full DecodeSaveGame.
+SaveRead DecodeSaveSummary(const std::uint8_t* data, std::size_t size, SaveGame& out,
+                           std::string* error = nullptr);
+
+// Version 1 conversion used by DecodeSaveGame. Missing or mistyped fields
+// keep their defaults.
+bool SaveGameFromPayload(const SavePayload& payload, SaveGame& out);
+
+}  // namespace match::core
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "match/core/AI.hpp"
+#include "match/core/Board.hpp"
+#include "match/core/WorkerPool.hpp"
+
+namespace match::core {
+
+enum class TurnOrder {
+    // A player keeps the board until their moves for the round run out.
+    Consecutive,
+    // Players alternate after every move while they have moves left.
+    RoundRobin,
+};
+
+// Round structure of one game, mirroring the app's GameContext: every player
+// gets moves_per_round moves per round, and the round restarts with player 0.
+struct MatchRules {
+    Board::Rules board{};
+    int players = 2;
+    int rounds = 5;
+    int moves_per_round = 3;
+    TurnOrder turn_order = TurnOrder::Consecutive;
+};
+
+// How one seat picks its move. Without search options the seat plays the
+// greedy ai::BestMove, which makes a game a pure function of its seed;
+// searched seats also depend on their time budget.
+struct SeatPolicy {
+    std::optional<ai::SearchOptions> search;
+};
+
+// The swap policy picks on board; greedy when policy is null.
+std::optional<ai::BestMoveResult> ChooseSeatMove(const Board& board, const LegalMoveIndex& legal_moves,
+                                               const SeatPolicy* policy);
+
+struct SelfPlayGame {
+    std::size_t index = 0;
+    std::uint32_t seed = 0;
+    std::vector<int> scores;
+    // Seat with the highest score, or -1 when the top score is shared.
+    int winner = -1;
+    int rounds_played = 0;
+    int moves = 0;
+    int chains = 0;
+    int longest_chain = 0;
+    int tiles_cleared = 0;
+    int bombs_triggered = 0;
+    int color_chains = 0;
+    int best_move_score = 0;
+    // The board ran out of legal swaps before the last round finished.
+    bool stalled = false;
+    double elapsed_ms = 0.0;
+};
+
+// Seats beyond the end of seats play greedy.
+SelfPlayGame PlaySelfPlayGame(const MatchRules& rules, const std::vector<SeatPolicy>& seats,
+                              std::uint32_t seed);
+
+struct SelfPlayBatch {
+    MatchRules rules{};
+    std::vector<SeatPolicy> seats;
+    std::size_t games = 1;
+    // Game i is played with seed first_seed + i.
+    std::uint32_t first_seed = 1;
+};
+
+using SelfPlaySink = std::function<void(const SelfPlayGame&)>;
+
+// Plays every game of the batch across the pool. sink sees the games one at
+// a time in index order, whichever thread finished them, so its output is
+// stable across thread counts.
+void RunSelfPlayBatch(const SelfPlayBatch& batch, const SelfPlaySink& sink,
+                      WorkerPool& pool = SharedWorkerPool());
+
+}  // namespace match::core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "match/core/AllocTracker.hpp"
+
+namespace match::core {
+
+// Fixed set of background threads for data-parallel loops. The calling thread
+// joins in, so a pool built with zero threads simply runs the loop inline.
+class WorkerPool {
+public:
+    using Task = std::function<void(std::size_t index, unsigned slot)>;
+
+    explicit WorkerPool(unsigned threads = DefaultThreadCount());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Distinct slot values passed to tasks: one per thread plus the caller.
+    unsigned slotCount() const noexcept { return static_cast<unsigned>(threads_.size()) + 1; }
+
+    // Runs task(i, slot) for every i in [0, count) and returns once all calls
+    // are done. Calls sharing a slot never overlap, so per-slot state needs no
+    // locking. Concurrent callers are serialised; tasks must not call back.
+    void parallelFor(std::size_t count, const Task& task);
+
+    // One less than the hardware thread count, leaving a core for the caller.
+    static unsigned DefaultThreadCount();
+
+    // True while the current thread is running a task of any pool. Code that
+    // may be reached from inside a task checks this and runs its own loops
+    // inline instead of handing them to a pool.
+    static bool InsideTask() noexcept;
+
+private:
+    void workerLoop(unsigned slot);
+    void drain(unsigned slot);
+
+    std::vector<std::thread> threads_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const Task* task_{nullptr};
+    std::size_t count_{0};
+    std::size_t next_{0};
+    unsigned busy_{0};
+    unsigned long long generation_{0};
+    // The caller's allocation domain, applied to the workers while they run
+    // its tasks.
+    AllocDomain domain_{AllocDomain::Other};
+    bool stopping_{false};
+};
+
+// Process-wide pool shared by the AI and batch tools.
+WorkerPool& SharedWorkerPool();
+
+}  // namespace match::core
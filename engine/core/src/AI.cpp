@@ -1,95 +1,363 @@
 #include "match/core/AI.hpp"
 
-#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+#include "match/core/AllocTracker.hpp"
+#include "match/core/CascadeBatch.hpp"
+#include "match/core/Profiler.hpp"
+#include "match/core/WorkerPool.hpp"
 
 namespace match::core::ai {
 
 namespace {
 
-std::pair<Cell, Cell> NormalizedKey(const Move& move) {
-    if (move.b < move.a) {
-        return {move.b, move.a};
-    }
-    return {move.a, move.b};
-}
-
-}  // namespace
+// Below this many candidates the pool hand-off costs more than it saves.
+constexpr std::size_t kParallelCandidateThreshold = 2 * kCascadeLanes;
 
-std::optional<BestMoveResult> BestMove(const Board& board) {
-    const int offsets[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
-
-    struct Entry {
-        std::pair<Cell, Cell> key{};
-        BestMoveResult result{};
-    };
-
-    std::vector<Entry> entries;
-    entries.reserve(static_cast<std::size_t>(board.cols()) *
-                    static_cast<std::size_t>(board.rows()) * 2);
+// Swapping a pair either way yields the same board, so each unordered pair is
+// scored once, oriented from the earlier cell in scan order. Ties keep the
+// first candidate. When scores_out is set it receives every candidate's
+// immediate score, in candidate order.
+std::optional<BestMoveResult> PickBest(const Board& board, const std::vector<Move>& candidates,
+                                       std::vector<int>* scores_out = nullptr) {
+    MATCH_PROFILE_SCOPE("ai.best_move");
+    MATCH_ALLOC_SCOPE(AI);
+    if (candidates.empty()) {
+        return std::nullopt;
+    }
 
-    auto find_entry = [&](const std::pair<Cell, Cell>& key) -> Entry* {
-        for (auto& entry : entries) {
-            if (entry.key == key) {
-                return &entry;
+    // Candidates are scored in lane batches without events, one contiguous
+    // share per pool slot; only the winner is replayed with events below.
+    std::vector<int> local_scores;
+    std::vector<int>& scores = scores_out != nullptr ? *scores_out : local_scores;
+    scores.assign(candidates.size(), 0);
+    auto score_candidates = [&](WorkerPool* pool) {
+        const std::size_t shares = pool != nullptr ? pool->slotCount() : 1;
+        const std::size_t share = (candidates.size() + shares - 1) / shares;
+        auto score_share = [&](std::size_t index, unsigned) {
+            static thread_local CascadeBatch batch;
+            const std::size_t begin = std::min(candidates.size(), index * share);
+            const std::size_t end = std::min(candidates.size(), begin + share);
+            batch.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                batch.add(board, candidates[i]);
+            }
+            batch.run();
+            for (std::size_t i = begin; i < end; ++i) {
+                scores[i] = batch.totals(i - begin).score();
             }
+        };
+        if (pool != nullptr) {
+            pool->parallelFor(shares, score_share);
+        } else {
+            score_share(0, 0);
         }
-        return nullptr;
     };
+    // Inside a pool task (a self-play batch, say) the outer loop already
+    // keeps every core busy, so candidates are scored inline.
+    const bool use_pool =
+        candidates.size() >= kParallelCandidateThreshold && !WorkerPool::InsideTask();
+    score_candidates(use_pool ? &SharedWorkerPool() : nullptr);
+
+    std::size_t best_index = 0;
+    for (std::size_t i = 1; i < scores.size(); ++i) {
+        if (scores[i] > scores[best_index]) {
+            best_index = i;
+        }
+    }
 
     BestMoveResult best{};
-    bool has_best = false;
+    best.move = candidates[best_index];
+    best.score = scores[best_index];
+    Board sim_board = board;
+    best.simulation = SimulateFullChain(sim_board, best.move);
+    return best;
+}
 
+void CollectLegalMoves(const Board& board, std::vector<Move>& moves) {
+    moves.clear();
     for (int col = 0; col < board.cols(); ++col) {
         for (int row = 0; row < board.rows(); ++row) {
             const Cell origin{col, row};
-            for (const auto& offset : offsets) {
-                const Cell neighbor{col + offset[0], row + offset[1]};
-                if (!board.inBounds(neighbor)) {
-                    continue;
+            const Cell neighbors[2] = {{col + 1, row}, {col, row + 1}};
+            for (const auto& neighbor : neighbors) {
+                const Move move{origin, neighbor};
+                if (LegalSwapLocal(board, move)) {
+                    moves.push_back(move);
                 }
+            }
+        }
+    }
+}
 
-                Move move{origin, neighbor};
+std::uint64_t SplitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
 
-                Board evaluation_board = board;
-                if (!LegalSwap(evaluation_board, move)) {
-                    continue;
+class Searcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Searcher(const Board& board, const SearchOptions& options)
+        : options_(options),
+          deadline_(Clock::now() + std::chrono::milliseconds(std::max(0, options.time_budget_ms))),
+          cells_(board.cols() * board.rows()),
+          tiles_(std::max(1, board.planeCount())),
+          table_(std::max<std::size_t>(1, options.table_entries)) {
+        std::uint64_t state = 0x6D61746368ull;
+        keys_.resize(static_cast<std::size_t>(cells_) * static_cast<std::size_t>(tiles_));
+        for (auto& key : keys_) {
+            key = SplitMix64(state);
+        }
+        for (auto& key : depth_keys_) {
+            key = SplitMix64(state);
+        }
+    }
+
+    bool timedOut() const noexcept { return timed_out_; }
+
+    // Latches timedOut() once the budget is spent or the search is cancelled.
+    bool checkDeadline() {
+        if (!timed_out_ && (Clock::now() >= deadline_ ||
+                            (options_.cancel != nullptr && options_.cancel->load()))) {
+            timed_out_ = true;
+        }
+        return timed_out_;
+    }
+
+    // Exact result of move on the real RNG plus the expected value of what
+    // the resulting board offers over depth - 1 further moves.
+    double rootValue(const Board& board, const Move& move, int depth, int& score) {
+        Board next = board;
+        score = SimulateFullChain(next, move, scratch_, SimulationEvents::Skip).score;
+        return score + value(next, depth - 1);
+    }
+
+private:
+    struct Entry {
+        std::uint64_t key = 0;
+        double value = 0.0;
+        bool used = false;
+    };
+
+    struct Ranked {
+        Move move{};
+        int score = 0;
+    };
+
+    // Best expected total over depth moves from board, spawns unknown.
+    double value(const Board& board, int depth) {
+        if (depth <= 0 || checkDeadline()) {
+            return 0.0;
+        }
+        const std::uint64_t key = hash(board) ^ depth_keys_[static_cast<std::size_t>(
+                                                    std::min(depth, kMaxTableDepth - 1))];
+        Entry& entry = table_[static_cast<std::size_t>(key % table_.size())];
+        if (entry.used && entry.key == key) {
+            return entry.value;
+        }
+
+        // Rank by one fork, then average the most promising few over all forks.
+        std::vector<Move> moves;
+        CollectLegalMoves(board, moves);
+        if (moves.empty()) {
+            return 0.0;
+        }
+        // Ranking needs scores only, so every move goes through one batch;
+        // the ranking is finished before any recursion reuses batch_.
+        std::mt19937 fork(ForkSeed(key, 0));
+        batch_.clear();
+        for (const auto& move : moves) {
+            batch_.add(board, move, &fork);
+        }
+        batch_.run();
+        std::vector<Ranked> ranked;
+        ranked.reserve(moves.size());
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            ranked.push_back({moves[i], batch_.totals(i).score()});
+        }
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const Ranked& a, const Ranked& b) { return a.score > b.score; });
+        ranked.resize(std::min<std::size_t>(ranked.size(),
+                                            static_cast<std::size_t>(std::max(1, options_.beam_width))));
+
+        const int samples = std::max(1, options_.spawn_samples);
+        Board next = board;
+        double best = 0.0;
+        for (const auto& candidate : ranked) {
+            double total = 0.0;
+            for (int sample = 0; sample < samples; ++sample) {
+                next = board;
+                next.rng().seed(ForkSeed(key, static_cast<std::uint64_t>(sample)));
+                const int score =
+                    SimulateFullChain(next, candidate.move, scratch_, SimulationEvents::Skip).score;
+                total += score + value(next, depth - 1);
+                if (timed_out_) {
+                    return 0.0;
                 }
+            }
+            best = std::max(best, total / samples);
+        }
+
+        entry.key = key;
+        entry.value = best;
+        entry.used = true;
+        return best;
+    }
 
-                Board sim_board = board;
-                SimulationResult sim = SimulateFullChain(sim_board, move);
-
-                BestMoveResult candidate{};
-                candidate.move = move;
-                candidate.score = sim.score;
-                candidate.simulation = std::move(sim);
-
-                const auto key = NormalizedKey(move);
-                if (auto* existing = find_entry(key); existing != nullptr) {
-                    if (candidate.score > existing->result.score) {
-                        existing->result = candidate;
-                    }
-
-                    if (!has_best || existing->result.score > best.score) {
-                        best = existing->result;
-                        has_best = true;
-                    }
-                } else {
-                    entries.push_back({key, candidate});
-
-                    if (!has_best || candidate.score > best.score) {
-                        best = candidate;
-                        has_best = true;
-                    }
+    std::uint64_t hash(const Board& board) const {
+        std::uint64_t key = 0;
+        for (int col = 0; col < board.cols(); ++col) {
+            for (int row = 0; row < board.rows(); ++row) {
+                const int tile = board.get(col, row);
+                if (tile < 0 || tile >= tiles_) {
+                    continue;
                 }
+                const int cell = col * board.rows() + row;
+                key ^= keys_[static_cast<std::size_t>(cell) * static_cast<std::size_t>(tiles_) +
+                             static_cast<std::size_t>(tile)];
             }
         }
+        return key;
     }
 
-    if (!has_best) {
-        return std::nullopt;
+    // Forks depend only on board contents, so transpositions see the same
+    // spawns and cached values stay consistent.
+    static std::mt19937::result_type ForkSeed(std::uint64_t key, std::uint64_t sample) {
+        std::uint64_t state = key ^ (sample * 0xD1B54A32D192ED03ull);
+        return static_cast<std::mt19937::result_type>(SplitMix64(state));
+    }
+
+    static constexpr int kMaxTableDepth = 8;
+
+    const SearchOptions& options_;
+    Clock::time_point deadline_;
+    int cells_;
+    int tiles_;
+    std::vector<std::uint64_t> keys_;
+    std::uint64_t depth_keys_[kMaxTableDepth]{};
+    std::vector<Entry> table_;
+    SimulationScratch scratch_;
+    CascadeBatch batch_;
+    bool timed_out_ = false;
+};
+
+std::optional<BestMoveResult> Search(const Board& board, const std::vector<Move>& moves,
+                                     const SearchOptions& options) {
+    MATCH_PROFILE_SCOPE("ai.search");
+    MATCH_ALLOC_SCOPE(AI);
+    if (options.max_depth <= 1) {
+        return PickBest(board, moves);
+    }
+
+    // The budget covers the greedy pass too; that pass always completes, but
+    // nothing past it starts once the budget is gone.
+    Searcher searcher(board, options);
+    std::vector<int> scores;
+    auto greedy = PickBest(board, moves, &scores);
+    if (!greedy || searcher.checkDeadline()) {
+        return greedy;
+    }
+
+    // Only the moves the greedy pass rates highest are searched deeper,
+    // ranked by the immediate scores it already computed.
+    std::vector<std::pair<Move, int>> ranked;
+    ranked.reserve(moves.size());
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        ranked.emplace_back(moves[i], scores[i]);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+    ranked.resize(std::min<std::size_t>(ranked.size(),
+                                        static_cast<std::size_t>(std::max(1, options.beam_width))));
+    if (searcher.checkDeadline()) {
+        return greedy;
+    }
+
+    Move chosen = greedy->move;
+    for (int depth = 2; depth <= options.max_depth; ++depth) {
+        Move depth_best{};
+        double depth_value = 0.0;
+        bool has_value = false;
+        for (const auto& candidate : ranked) {
+            const Move& move = candidate.first;
+            int immediate = 0;
+            const double value = searcher.rootValue(board, move, depth, immediate);
+            if (searcher.timedOut()) {
+                break;
+            }
+            if (!has_value || value > depth_value) {
+                depth_best = move;
+                depth_value = value;
+                has_value = true;
+            }
+        }
+        if (searcher.timedOut()) {
+            break;
+        }
+        chosen = depth_best;
     }
 
+    if (chosen.a == greedy->move.a && chosen.b == greedy->move.b) {
+        return greedy;
+    }
+    BestMoveResult best{};
+    best.move = chosen;
+    Board sim_board = board;
+    best.simulation = SimulateFullChain(sim_board, chosen);
+    best.score = best.simulation.score;
     return best;
 }
 
+}  // namespace
+
+std::optional<BestMoveResult> BestMove(const Board& board) {
+    std::vector<Move> candidates;
+    CollectLegalMoves(board, candidates);
+    return PickBest(board, candidates);
+}
+
+std::optional<BestMoveResult> BestMove(const Board& board, const LegalMoveIndex& legal_moves) {
+    return PickBest(board, legal_moves.moves());
+}
+
+SearchOptions SearchOptionsFor(Difficulty difficulty) {
+    SearchOptions options;
+    switch (difficulty) {
+        case Difficulty::Easy:
+            options.max_depth = 1;
+            break;
+        case Difficulty::Normal:
+            options.max_depth = 2;
+            options.beam_width = 6;
+            options.spawn_samples = 2;
+            options.time_budget_ms = 60;
+            break;
+        case Difficulty::Hard:
+            options.max_depth = 3;
+            options.beam_width = 8;
+            options.spawn_samples = 3;
+            options.time_budget_ms = 150;
+            break;
+    }
+    return options;
+}
+
+std::optional<BestMoveResult> SearchBestMove(const Board& board, const SearchOptions& options) {
+    std::vector<Move> moves;
+    CollectLegalMoves(board, moves);
+    return Search(board, moves, options);
+}
+
+std::optional<BestMoveResult> SearchBestMove(const Board& board, const LegalMoveIndex& legal_moves,
+                                             const SearchOptions& options) {
+    return Search(board, legal_moves.moves(), options);
+}
+
 }  // namespace match::core::ai
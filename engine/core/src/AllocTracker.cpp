@@ -0,0 +1,161 @@
+#include "match/core/AllocTracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace match::core {
+
+namespace {
+
+struct DomainCounters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytes_allocated{0};
+    std::atomic<std::int64_t> live_bytes{0};
+};
+
+// Constant-initialised, so allocations made before main are counted too.
+DomainCounters g_counters[kAllocDomainCount];
+thread_local AllocDomain t_domain = AllocDomain::Other;
+
+AllocCounters Load(const DomainCounters& counters) noexcept {
+    AllocCounters out;
+    out.allocations = counters.allocations.load(std::memory_order_relaxed);
+    out.frees = counters.frees.load(std::memory_order_relaxed);
+    out.bytes_allocated = counters.bytes_allocated.load(std::memory_order_relaxed);
+    out.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+    return out;
+}
+
+}  // namespace
+
+const char* AllocDomainName(AllocDomain domain) noexcept {
+    switch (domain) {
+        case AllocDomain::Other:
+            return "other";
+        case AllocDomain::Simulation:
+            return "simulation";
+        case AllocDomain::AI:
+            return "ai";
+        case AllocDomain::Render:
+            return "render";
+        case AllocDomain::UI:
+            return "ui";
+        case AllocDomain::Save:
+            return "save";
+    }
+    return "other";
+}
+
+AllocCounters AllocStats(AllocDomain domain) noexcept {
+    return Load(g_counters[static_cast<std::size_t>(domain)]);
+}
+
+AllocCounters AllocTotals() noexcept {
+    AllocCounters total;
+    for (const auto& counters : g_counters) {
+        const AllocCounters one = Load(counters);
+        total.allocations += one.allocations;
+        total.frees += one.frees;
+        total.bytes_allocated += one.bytes_allocated;
+        total.live_bytes += one.live_bytes;
+    }
+    return total;
+}
+
+AllocDomain CurrentAllocDomain() noexcept {
+    return t_domain;
+}
+
+AllocScope::AllocScope(AllocDomain domain) noexcept : previous_(t_domain) {
+    t_domain = domain;
+}
+
+AllocScope::~AllocScope() {
+    t_domain = previous_;
+}
+
+}  // namespace match::core
+
+#if MATCH_ALLOC_TRACKING
+
+namespace {
+
+using match::core::AllocDomain;
+using match::core::g_counters;
+
+// Each block starts with its size and domain, padded to keep the caller's
+// pointer at the alignment malloc guarantees. Over-aligned new is left to
+// the library and goes uncounted.
+constexpr std::size_t kHeaderBytes = alignof(std::max_align_t);
+static_assert(kHeaderBytes >= 2 * sizeof(std::uint64_t));
+
+void* TrackedAlloc(std::size_t size) noexcept {
+    auto* block = static_cast<std::uint64_t*>(std::malloc(size + kHeaderBytes));
+    if (!block) {
+        return nullptr;
+    }
+    const AllocDomain domain = match::core::CurrentAllocDomain();
+    block[0] = size;
+    block[1] = static_cast<std::uint64_t>(domain);
+    auto& counters = g_counters[static_cast<std::size_t>(domain)];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    counters.live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    return reinterpret_cast<unsigned char*>(block) + kHeaderBytes;
+}
+
+void TrackedFree(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto* block = reinterpret_cast<std::uint64_t*>(static_cast<unsigned char*>(ptr) - kHeaderBytes);
+    auto& counters = g_counters[static_cast<std::size_t>(block[1])];
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+    counters.live_bytes.fetch_sub(static_cast<std::int64_t>(block[0]), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void* TrackedNew(std::size_t size) {
+    void* ptr = TrackedAlloc(size == 0 ? 1 : size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return TrackedNew(size);
+}
+void* operator new[](std::size_t size) {
+    return TrackedNew(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAlloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAlloc(size == 0 ? 1 : size);
+}
+void operator delete(void* ptr) noexcept {
+    TrackedFree(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    TrackedFree(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    TrackedFree(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+    TrackedFree(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    TrackedFree(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    TrackedFree(ptr);
+}
+
+#endif
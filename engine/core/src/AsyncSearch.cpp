@@ -0,0 +1,105 @@
+#include "match/core/AsyncSearch.hpp"
+
+#include <utility>
+
+namespace match::core::ai {
+
+AsyncMoveSearch::AsyncMoveSearch() : thread_([this] { workerLoop(); }) {}
+
+AsyncMoveSearch::~AsyncMoveSearch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        if (running_) {
+            running_->cancel = true;
+        }
+    }
+    wake_.notify_all();
+    thread_.join();
+    if (queued_) {
+        queued_->promise.set_value(AsyncSearchResult{true, std::nullopt});
+    }
+}
+
+std::shared_future<AsyncSearchResult> AsyncMoveSearch::start(const Board& board,
+                                                             const SearchOptions& options) {
+    auto job = std::make_shared<Job>();
+    job->board = board;
+    job->options = options;
+    return enqueue(std::move(job));
+}
+
+std::shared_future<AsyncSearchResult> AsyncMoveSearch::start(const Board& board,
+                                                             const LegalMoveIndex& legal_moves,
+                                                             const SearchOptions& options) {
+    auto job = std::make_shared<Job>();
+    job->board = board;
+    job->legal_moves = legal_moves;
+    job->options = options;
+    return enqueue(std::move(job));
+}
+
+std::shared_future<AsyncSearchResult> AsyncMoveSearch::enqueue(std::shared_ptr<Job> job) {
+    job->options.cancel = &job->cancel;
+    std::shared_future<AsyncSearchResult> future = job->promise.get_future().share();
+
+    std::shared_ptr<Job> superseded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            running_->cancel = true;
+        }
+        superseded = std::exchange(queued_, job);
+    }
+    if (superseded) {
+        superseded->promise.set_value(AsyncSearchResult{true, std::nullopt});
+    }
+    wake_.notify_one();
+    return future;
+}
+
+void AsyncMoveSearch::cancel() {
+    std::shared_ptr<Job> superseded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            running_->cancel = true;
+        }
+        superseded = std::move(queued_);
+    }
+    if (superseded) {
+        superseded->promise.set_value(AsyncSearchResult{true, std::nullopt});
+    }
+}
+
+void AsyncMoveSearch::workerLoop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || queued_ != nullptr; });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(queued_);
+            running_ = job;
+        }
+
+        AsyncSearchResult result;
+        result.best = job->legal_moves
+                          ? SearchBestMove(job->board, *job->legal_moves, job->options)
+                          : SearchBestMove(job->board, job->options);
+        result.cancelled = job->cancel.load();
+        if (result.cancelled) {
+            result.best.reset();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_.reset();
+        }
+        job->promise.set_value(std::move(result));
+    }
+}
+
+}  // namespace match::core::ai
@@ -0,0 +1,138 @@
+#include "match/core/BitBoard.hpp"
+
+#include <algorithm>
+
+namespace match::core {
+
+BitBoard::BitBoard(int cols, int rows)
+    : cols_(std::max(0, cols)),
+      rows_(std::max(0, rows)),
+      words_((static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_ + 1) + kWordBits - 1) /
+                 kWordBits,
+             Word{0}) {}
+
+bool BitBoard::any() const noexcept {
+    return std::any_of(words_.begin(), words_.end(), [](Word w) { return w != 0; });
+}
+
+int BitBoard::count() const noexcept {
+    int total = 0;
+    for (Word word : words_) {
+#if defined(__GNUC__) || defined(__clang__)
+        total += __builtin_popcountll(word);
+#else
+        while (word != 0) {
+            word &= word - 1;
+            ++total;
+        }
+#endif
+    }
+    return total;
+}
+
+void BitBoard::clear() noexcept {
+    std::fill(words_.begin(), words_.end(), Word{0});
+}
+
+void BitBoard::fill() noexcept {
+    clear();
+    for (int row = 0; row < rows_; ++row) {
+        for (int col = 0; col < cols_; ++col) {
+            set(col, row);
+        }
+    }
+}
+
+void BitBoard::andShiftedRight(const BitBoard& src, int bits) noexcept {
+    const std::size_t count = words_.size();
+    const std::size_t word_shift = static_cast<std::size_t>(bits / kWordBits);
+    const int bit_shift = bits % kWordBits;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t lo = i + word_shift;
+        Word shifted = 0;
+        if (lo < count) {
+            shifted = src.words_[lo] >> bit_shift;
+            if (bit_shift != 0 && lo + 1 < count) {
+                shifted |= src.words_[lo + 1] << (kWordBits - bit_shift);
+            }
+        }
+        words_[i] &= shifted;
+    }
+}
+
+void BitBoard::orShiftedLeft(const BitBoard& src, int bits) noexcept {
+    const std::size_t count = words_.size();
+    const std::size_t word_shift = static_cast<std::size_t>(bits / kWordBits);
+    const int bit_shift = bits % kWordBits;
+    for (std::size_t i = count; i-- > word_shift;) {
+        const std::size_t hi = i - word_shift;
+        Word shifted = src.words_[hi] << bit_shift;
+        if (bit_shift != 0 && hi > 0) {
+            shifted |= src.words_[hi - 1] >> (kWordBits - bit_shift);
+        }
+        words_[i] |= shifted;
+    }
+    maskTail();
+}
+
+void BitBoard::orShiftedRight(const BitBoard& src, int bits) noexcept {
+    const std::size_t count = words_.size();
+    const std::size_t word_shift = static_cast<std::size_t>(bits / kWordBits);
+    const int bit_shift = bits % kWordBits;
+    for (std::size_t i = 0; i + word_shift < count; ++i) {
+        const std::size_t lo = i + word_shift;
+        Word shifted = src.words_[lo] >> bit_shift;
+        if (bit_shift != 0 && lo + 1 < count) {
+            shifted |= src.words_[lo + 1] << (kWordBits - bit_shift);
+        }
+        words_[i] |= shifted;
+    }
+}
+
+void BitBoard::assign(const BitBoard& other) noexcept {
+    std::copy(other.words_.begin(), other.words_.end(), words_.begin());
+}
+
+void BitBoard::orWith(const BitBoard& other) noexcept {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+        words_[i] |= other.words_[i];
+    }
+}
+
+void BitBoard::andWith(const BitBoard& other) noexcept {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= other.words_[i];
+    }
+}
+
+void BitBoard::andNot(const BitBoard& other) noexcept {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= ~other.words_[i];
+    }
+}
+
+int BitBoard::LowestBit(Word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1u) == 0) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+void BitBoard::maskTail() noexcept {
+    if (words_.empty()) {
+        return;
+    }
+    const std::size_t used_bits = static_cast<std::size_t>(rows_) * static_cast<std::size_t>(stride());
+    const int tail = static_cast<int>(used_bits % kWordBits);
+    if (tail != 0) {
+        words_.back() &= (Word{1} << tail) - 1;
+    }
+}
+
+}  // namespace match::core
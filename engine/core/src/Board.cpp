@@ -2,33 +2,210 @@
 
 #include <algorithm>
 #include <cmath>
-#include <iterator>
 #include <random>
-#include <set>
-#include <unordered_set>
+#include <utility>
+
+#include "match/core/AllocTracker.hpp"
 
 namespace match::core {
 
 namespace {
 
-using CellSet = std::set<Cell>;
+// Fills scratch.run_horizontal and scratch.run_vertical with the cells of one
+// tile plane covered by horizontal and vertical runs of three or more.
+// scratch.run_starts is left holding the vertical run starts.
+void ComputeRunMasks(const BitBoard& plane, SimulationScratch& scratch) {
+    const int stride = plane.stride();
+    BitBoard& starts = scratch.run_starts;
+
+    starts.assign(plane);
+    starts.andShiftedRight(plane, 1);
+    starts.andShiftedRight(plane, 2);
+    scratch.run_horizontal.assign(starts);
+    scratch.run_horizontal.orShiftedLeft(starts, 1);
+    scratch.run_horizontal.orShiftedLeft(starts, 2);
+
+    starts.assign(plane);
+    starts.andShiftedRight(plane, stride);
+    starts.andShiftedRight(plane, 2 * stride);
+    scratch.run_vertical.assign(starts);
+    scratch.run_vertical.orShiftedLeft(starts, stride);
+    scratch.run_vertical.orShiftedLeft(starts, 2 * stride);
+}
+
+// Top-left corners of every same-tile 2x2 square, in column-major order.
+void CollectBombSquares(const Board& board, SimulationScratch& scratch) {
+    scratch.corners.clear();
+    if (board.cols() < 2 || board.rows() < 2) {
+        return;
+    }
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        const BitBoard* plane = board.tilePlane(tile);
+        const int stride = plane->stride();
+        scratch.squares.assign(*plane);
+        scratch.squares.andShiftedRight(*plane, 1);
+        scratch.squares.andShiftedRight(*plane, stride);
+        scratch.squares.andShiftedRight(*plane, stride + 1);
+        scratch.squares.forEachSet(
+            [&](int col, int row) { scratch.corners.push_back(Cell{col, row}); });
+    }
+    std::sort(scratch.corners.begin(), scratch.corners.end());
+}
 
-bool CellsOverlap(const CellSet& a, const CellSet& b) {
-    auto it_a = a.begin();
-    auto it_b = b.begin();
-    while (it_a != a.end() && it_b != b.end()) {
-        if (*it_a == *it_b) {
+bool HasBombSquare(const Board& board, SimulationScratch& scratch) {
+    if (board.cols() < 2 || board.rows() < 2) {
+        return false;
+    }
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        const BitBoard* plane = board.tilePlane(tile);
+        const int stride = plane->stride();
+        scratch.squares.assign(*plane);
+        scratch.squares.andShiftedRight(*plane, 1);
+        scratch.squares.andShiftedRight(*plane, stride);
+        scratch.squares.andShiftedRight(*plane, stride + 1);
+        if (scratch.squares.any()) {
             return true;
         }
-        if (*it_a < *it_b) {
-            ++it_a;
-        } else {
-            ++it_b;
+    }
+    return false;
+}
+
+bool HasAnyMatch(const Board& board, SimulationScratch& scratch) {
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        ComputeRunMasks(*board.tilePlane(tile), scratch);
+        if (scratch.run_horizontal.any() || scratch.run_vertical.any()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsAdjacentSwap(const Board& board, const Move& move) {
+    if (!board.inBounds(move.a) || !board.inBounds(move.b)) {
+        return false;
+    }
+    const int dist =
+        std::abs(move.a.col - move.b.col) + std::abs(move.a.row - move.b.row);
+    return dist == 1;
+}
+
+// Tile at (col, row) as if move had already been applied.
+int SwappedTile(const Board& board, const Move& move, int col, int row) {
+    if (col == move.a.col && row == move.a.row) {
+        return board.get(move.b);
+    }
+    if (col == move.b.col && row == move.b.row) {
+        return board.get(move.a);
+    }
+    return board.get(col, row);
+}
+
+bool SwappedMatchAt(const Board& board, const Move& move, const Cell& cell, int tile) {
+    auto same = [&](int c, int r) {
+        return board.inBounds(c, r) && SwappedTile(board, move, c, r) == tile;
+    };
+    int run = 1;
+    for (int c = cell.col - 1; run < 3 && same(c, cell.row); --c) {
+        ++run;
+    }
+    for (int c = cell.col + 1; run < 3 && same(c, cell.row); ++c) {
+        ++run;
+    }
+    if (run >= 3) {
+        return true;
+    }
+    run = 1;
+    for (int r = cell.row - 1; run < 3 && same(cell.col, r); --r) {
+        ++run;
+    }
+    for (int r = cell.row + 1; run < 3 && same(cell.col, r); ++r) {
+        ++run;
+    }
+    return run >= 3;
+}
+
+bool SwappedSquareAt(const Board& board, const Move& move, const Cell& cell, int tile) {
+    for (int left = cell.col - 1; left <= cell.col; ++left) {
+        for (int top = cell.row - 1; top <= cell.row; ++top) {
+            if (!board.inBounds(left, top) || !board.inBounds(left + 1, top + 1)) {
+                continue;
+            }
+            if (SwappedTile(board, move, left, top) == tile &&
+                SwappedTile(board, move, left + 1, top) == tile &&
+                SwappedTile(board, move, left, top + 1) == tile &&
+                SwappedTile(board, move, left + 1, top + 1) == tile) {
+                return true;
+            }
         }
     }
     return false;
 }
 
+// Tiles that would complete a run of three, or with squares set a 2x2
+// square, if placed on the empty cell given the tiles already around it.
+// Writes each tile once to excluded, in ascending order, and returns how
+// many there are.
+int ExcludedTiles(const Board& board, const Cell& cell, bool squares, int (&excluded)[10]) {
+    auto at = [&](int dc, int dr) {
+        const int c = cell.col + dc;
+        const int r = cell.row + dr;
+        return board.inBounds(c, r) ? board.get(c, r) : kEmptyCell;
+    };
+    int count = 0;
+    auto exclude = [&](int tile) {
+        int* slot = std::lower_bound(excluded, excluded + count, tile);
+        if (tile == kEmptyCell || (slot != excluded + count && *slot == tile)) {
+            return;
+        }
+        std::copy_backward(slot, excluded + count, excluded + count + 1);
+        *slot = tile;
+        ++count;
+    };
+    auto pair = [&](int a, int b) {
+        if (a == b) {
+            exclude(a);
+        }
+    };
+
+    pair(at(-1, 0), at(-2, 0));
+    pair(at(1, 0), at(2, 0));
+    pair(at(-1, 0), at(1, 0));
+    pair(at(0, -1), at(0, -2));
+    pair(at(0, 1), at(0, 2));
+    pair(at(0, -1), at(0, 1));
+    if (squares) {
+        for (int dc = -1; dc <= 1; dc += 2) {
+            for (int dr = -1; dr <= 1; dr += 2) {
+                const int side = at(dc, 0);
+                if (side == at(0, dr) && side == at(dc, dr)) {
+                    exclude(side);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Lays out x x y x along a random row or column (mirrored half the time), so
+// swapping y with its lone neighbour makes a run of three whatever the rest
+// of the board holds. Needs a line of four cells and two tile types.
+void PlantLegalMove(Board& board) {
+    if (board.tileTypes() < 2 || (board.cols() < 4 && board.rows() < 4)) {
+        return;
+    }
+    auto pick = [&](int count) { return std::uniform_int_distribution<int>(0, count - 1)(board.rng()); };
+    const bool horizontal = board.rows() < 4 || (board.cols() >= 4 && pick(2) == 0);
+    const int col = pick(horizontal ? board.cols() - 3 : board.cols());
+    const int row = pick(horizontal ? board.rows() : board.rows() - 3);
+    const bool mirrored = pick(2) == 1;
+    const int x = board.randomTile();
+    const int y = (x + 1 + pick(board.tileTypes() - 1)) % board.tileTypes();
+    for (int step = 0; step < 4; ++step) {
+        const int along = mirrored ? 3 - step : step;
+        board.set(horizontal ? col + along : col, horizontal ? row : row + along, step == 2 ? y : x);
+    }
+}
+
 }  // namespace
 
 Board::Board(int cols, int rows, int tile_types, bool bombs_enabled, bool color_chain_enabled,
@@ -36,10 +213,12 @@ Board::Board(int cols, int rows, int tile_types, bool bombs_enabled, bool color_
     : rules_{cols, rows, tile_types, bombs_enabled, color_chain_enabled},
       cols_(cols),
       rows_(rows),
-      tile_types_(tile_types),
+      tile_types_(std::min(tile_types, kMaxTileValue + 1)),
       bombs_enabled_(bombs_enabled),
       color_chain_enabled_(color_chain_enabled),
-      cells_(static_cast<std::size_t>(cols) * static_cast<std::size_t>(rows), kEmptyCell),
+      cells_(static_cast<std::size_t>(cols) * static_cast<std::size_t>(rows),
+             static_cast<Tile>(kEmptyCell)),
+      planes_(static_cast<std::size_t>(std::max(0, tile_types_)), BitBoard(cols, rows)),
       rng_(seed) {}
 
 Board::Board(const Rules& rules, std::uint32_t seed)
@@ -54,13 +233,40 @@ int Board::get(int col, int row) const noexcept {
     return cells_[index(col, row)];
 }
 
-void Board::set(int col, int row, int value) noexcept {
-    cells_[index(col, row)] = value;
+void Board::set(int col, int row, int value) {
+    if (value < kEmptyCell || value > kMaxTileValue) {
+        value = kEmptyCell;
+    }
+    Tile& cell = cells_[index(col, row)];
+    if (cell == value) {
+        return;
+    }
+    if (cell >= 0) {
+        planes_[static_cast<std::size_t>(cell)].reset(col, row);
+    }
+    if (value >= 0) {
+        ensurePlane(value);
+        planes_[static_cast<std::size_t>(value)].set(col, row);
+    }
+    cell = static_cast<Tile>(value);
 }
 
 void Board::swapCells(const Cell& a, const Cell& b) noexcept {
     auto idx_a = index(a.col, a.row);
     auto idx_b = index(b.col, b.row);
+    const int tile_a = cells_[idx_a];
+    const int tile_b = cells_[idx_b];
+    if (tile_a == tile_b) {
+        return;
+    }
+    if (tile_a >= 0) {
+        planes_[static_cast<std::size_t>(tile_a)].reset(a.col, a.row);
+        planes_[static_cast<std::size_t>(tile_a)].set(b.col, b.row);
+    }
+    if (tile_b >= 0) {
+        planes_[static_cast<std::size_t>(tile_b)].reset(b.col, b.row);
+        planes_[static_cast<std::size_t>(tile_b)].set(a.col, a.row);
+    }
     std::swap(cells_[idx_a], cells_[idx_b]);
 }
 
@@ -73,46 +279,59 @@ int Board::randomTile() {
 }
 
 void Board::fillAll(int value) {
-    std::fill(cells_.begin(), cells_.end(), value);
+    if (value < kEmptyCell || value > kMaxTileValue) {
+        value = kEmptyCell;
+    }
+    std::fill(cells_.begin(), cells_.end(), static_cast<Tile>(value));
+    for (auto& plane : planes_) {
+        plane.clear();
+    }
+    if (value >= 0) {
+        ensurePlane(value);
+        planes_[static_cast<std::size_t>(value)].fill();
+    }
 }
 
-int Board::index(int col, int row) const noexcept {
-    return col * rows_ + row;
+const BitBoard* Board::tilePlane(int tile) const noexcept {
+    if (tile < 0 || tile >= static_cast<int>(planes_.size())) {
+        return nullptr;
+    }
+    return &planes_[static_cast<std::size_t>(tile)];
+}
+
+void Board::ensurePlane(int tile) {
+    if (tile >= static_cast<int>(planes_.size())) {
+        planes_.resize(static_cast<std::size_t>(tile) + 1, BitBoard(cols_, rows_));
+    }
 }
 
 Board NewBoard(const Board::Rules& rules, std::uint32_t seed) {
     Board board(rules, seed);
+    PlantLegalMove(board);
+
+    // One pass, one draw per cell: each cell picks uniformly among the tiles
+    // that complete nothing with what is already placed. Only tiny tile sets
+    // can run out of candidates, and those cells take any tile.
+    const int tile_types = board.tileTypes();
     for (int col = 0; col < board.cols(); ++col) {
         for (int row = 0; row < board.rows(); ++row) {
-            board.set(col, row, board.randomTile());
-            int tries = 0;
-            while (HasMatchAt(board, col, row) && tries <= 20) {
+            if (board.get(col, row) != kEmptyCell) {
+                continue;
+            }
+            int excluded[10];
+            const int excluded_count = ExcludedTiles(board, Cell{col, row}, board.bombsEnabled(), excluded);
+            if (excluded_count >= tile_types) {
                 board.set(col, row, board.randomTile());
-                ++tries;
+                continue;
             }
-        }
-    }
-
-    bool changed = true;
-    int iter_guard = 0;
-    while (changed && iter_guard < 1000) {
-        changed = false;
-        ++iter_guard;
-        for (int col = 0; col < board.cols() - 1; ++col) {
-            for (int row = 0; row < board.rows() - 1; ++row) {
-                const int t = board.get(col, row);
-                if (t == kEmptyCell) {
-                    continue;
-                }
-                if (board.get(col + 1, row) == t && board.get(col, row + 1) == t &&
-                    board.get(col + 1, row + 1) == t) {
-                    board.set(col + 1, row + 1, board.randomTile());
-                    changed = true;
-                }
+            std::uniform_int_distribution<int> dist(0, tile_types - excluded_count - 1);
+            int tile = dist(board.rng());
+            for (int i = 0; i < excluded_count && excluded[i] <= tile; ++i) {
+                ++tile;
             }
+            board.set(col, row, tile);
         }
     }
-
     return board;
 }
 
@@ -120,28 +339,19 @@ bool HasMatchAt(const Board& board, int col, int row) {
     if (!board.inBounds(col, row)) {
         return false;
     }
-    const int tile = board.get(col, row);
-    if (tile == kEmptyCell) {
+    const BitBoard* plane = board.tilePlane(board.get(col, row));
+    if (plane == nullptr) {
         return false;
     }
-    int count = 1;
-    for (int c = col - 1; c >= 0 && board.get(c, row) == tile; --c) {
-        ++count;
-    }
-    for (int c = col + 1; c < board.cols() && board.get(c, row) == tile; ++c) {
-        ++count;
-    }
-    if (count >= 3) {
+    auto same = [&](int c, int r) { return board.inBounds(c, r) && plane->test(c, r); };
+    const bool left = same(col - 1, row);
+    const bool right = same(col + 1, row);
+    if ((left && (same(col - 2, row) || right)) || (right && same(col + 2, row))) {
         return true;
     }
-    count = 1;
-    for (int r = row - 1; r >= 0 && board.get(col, r) == tile; --r) {
-        ++count;
-    }
-    for (int r = row + 1; r < board.rows() && board.get(col, r) == tile; ++r) {
-        ++count;
-    }
-    return count >= 3;
+    const bool up = same(col, row - 1);
+    const bool down = same(col, row + 1);
+    return (up && (same(col, row - 2) || down)) || (down && same(col, row + 2));
 }
 
 bool HasMatchAt(const Board& board, const Cell& cell) {
@@ -149,332 +359,371 @@ bool HasMatchAt(const Board& board, const Cell& cell) {
 }
 
 std::vector<MatchGroup> FindAllMatches(const Board& board) {
-    std::vector<CellSet> groups;
-    groups.reserve(board.cols() * board.rows());
-
-    for (int row = 0; row < board.rows(); ++row) {
-        int col = 0;
-        while (col < board.cols()) {
-            const int tile = board.get(col, row);
-            if (tile == kEmptyCell) {
-                ++col;
-                continue;
-            }
-            int start = col;
-            while (col + 1 < board.cols() && board.get(col + 1, row) == tile) {
-                ++col;
+    struct Component {
+        MatchGroup cells;
+        long long order_key = -1;
+        int runs = 0;
+    };
+
+    const int cols = board.cols();
+    const int rows = board.rows();
+    const long long cell_count = static_cast<long long>(cols) * rows;
+
+    std::vector<Component> components;
+    SimulationScratch scratch;
+    scratch.prepare(cols, rows);
+    BitBoard& visited = scratch.removed;
+    std::vector<Cell>& stack = scratch.cells;
+
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        ComputeRunMasks(*board.tilePlane(tile), scratch);
+        const BitBoard& horizontal = scratch.run_horizontal;
+        const BitBoard& vertical = scratch.run_vertical;
+        BitBoard& matched = scratch.matched;
+        matched.assign(horizontal);
+        matched.orWith(vertical);
+
+        matched.forEachSet([&](int seed_col, int seed_row) {
+            if (visited.test(seed_col, seed_row)) {
+                return;
             }
-            if (col - start + 1 >= 3) {
-                CellSet group;
-                for (int c = start; c <= col; ++c) {
-                    group.insert(Cell{c, row});
+            Component component;
+            visited.set(seed_col, seed_row);
+            stack.push_back(Cell{seed_col, seed_row});
+            while (!stack.empty()) {
+                const Cell cell = stack.back();
+                stack.pop_back();
+                component.cells.push_back(cell);
+
+                // Runs are ordered the way the old scan emitted them: every
+                // horizontal run (row-major) before every vertical run
+                // (column-major). A component is keyed by its latest run.
+                const bool in_h = horizontal.test(cell.col, cell.row);
+                const bool in_v = vertical.test(cell.col, cell.row);
+                if (in_h && (cell.col == 0 || !horizontal.test(cell.col - 1, cell.row))) {
+                    ++component.runs;
+                    component.order_key = std::max<long long>(
+                        component.order_key, static_cast<long long>(cell.row) * cols + cell.col);
                 }
-                groups.push_back(std::move(group));
-            }
-            ++col;
-        }
-    }
-
-    for (int col = 0; col < board.cols(); ++col) {
-        int row = 0;
-        while (row < board.rows()) {
-            const int tile = board.get(col, row);
-            if (tile == kEmptyCell) {
-                ++row;
-                continue;
-            }
-            int start = row;
-            while (row + 1 < board.rows() && board.get(col, row + 1) == tile) {
-                ++row;
-            }
-            if (row - start + 1 >= 3) {
-                CellSet group;
-                for (int r = start; r <= row; ++r) {
-                    group.insert(Cell{col, r});
+                if (in_v && (cell.row == 0 || !vertical.test(cell.col, cell.row - 1))) {
+                    ++component.runs;
+                    component.order_key = std::max<long long>(
+                        component.order_key,
+                        cell_count + static_cast<long long>(cell.col) * rows + cell.row);
                 }
-                groups.push_back(std::move(group));
-            }
-            ++row;
-        }
-    }
 
-    bool merged = true;
-    while (merged) {
-        merged = false;
-        std::vector<CellSet> out;
-        out.reserve(groups.size());
-        while (!groups.empty()) {
-            CellSet current = std::move(groups.back());
-            groups.pop_back();
-            bool expanded = true;
-            while (expanded) {
-                expanded = false;
-                for (auto it = groups.begin(); it != groups.end();) {
-                    if (CellsOverlap(current, *it)) {
-                        current.insert(it->begin(), it->end());
-                        it = groups.erase(it);
-                        expanded = true;
-                        merged = true;
-                    } else {
-                        ++it;
+                auto visit = [&](int c, int r, const BitBoard& link) {
+                    if (c < 0 || c >= cols || r < 0 || r >= rows) {
+                        return;
+                    }
+                    if (!link.test(c, r) || visited.test(c, r)) {
+                        return;
                     }
+                    visited.set(c, r);
+                    stack.push_back(Cell{c, r});
+                };
+                if (in_h) {
+                    visit(cell.col - 1, cell.row, horizontal);
+                    visit(cell.col + 1, cell.row, horizontal);
+                }
+                if (in_v) {
+                    visit(cell.col, cell.row - 1, vertical);
+                    visit(cell.col, cell.row + 1, vertical);
                 }
             }
-            out.push_back(std::move(current));
-        }
-        groups = std::move(out);
+            std::sort(component.cells.begin(), component.cells.end());
+            components.push_back(std::move(component));
+        });
     }
 
+    // The pairwise merge this replaces emitted groups latest-run-first and
+    // reversed that order again whenever any runs were merged.
+    const bool any_merged = std::any_of(components.begin(), components.end(),
+                                        [](const Component& c) { return c.runs > 1; });
+    std::sort(components.begin(), components.end(), [&](const Component& a, const Component& b) {
+        return any_merged ? a.order_key < b.order_key : a.order_key > b.order_key;
+    });
+
     std::vector<MatchGroup> result;
-    result.reserve(groups.size());
-    for (auto& set : groups) {
-        MatchGroup group;
-        group.assign(set.begin(), set.end());
-        result.push_back(std::move(group));
+    result.reserve(components.size());
+    for (auto& component : components) {
+        result.push_back(std::move(component.cells));
     }
     return result;
 }
 
+void SimulationScratch::prepare(int cols, int rows) {
+    if (matched.cols() == cols && matched.rows() == rows) {
+        return;
+    }
+    for (BitBoard* mask : {&run_starts, &run_horizontal, &run_vertical, &squares, &matched,
+                           &neighbors, &removed}) {
+        *mask = BitBoard(cols, rows);
+    }
+}
+
 bool LegalSwap(Board& board, const Move& move) {
-    if (!board.inBounds(move.a) || !board.inBounds(move.b)) {
+    SimulationScratch scratch;
+    return LegalSwap(board, move, scratch);
+}
+
+bool LegalSwap(Board& board, const Move& move, SimulationScratch& scratch) {
+    if (!IsAdjacentSwap(board, move)) {
         return false;
     }
-    const int dist =
-        std::abs(move.a.col - move.b.col) + std::abs(move.a.row - move.b.row);
-    if (dist != 1) {
+    scratch.prepare(board.cols(), board.rows());
+    board.swapCells(move);
+    const bool ok = HasAnyMatch(board, scratch) ||
+                    (board.bombsEnabled() && HasBombSquare(board, scratch));
+    board.swapCells(move);
+    return ok;
+}
+
+bool LegalSwapLocal(const Board& board, const Move& move) {
+    if (!IsAdjacentSwap(board, move)) {
         return false;
     }
-    board.swapCells(move);
-    bool ok = !FindAllMatches(board).empty();
-
-    if (!ok && board.bombsEnabled()) {
-        for (int col = 0; col < board.cols() - 1 && !ok; ++col) {
-            for (int row = 0; row < board.rows() - 1 && !ok; ++row) {
-                const int t = board.get(col, row);
-                if (t != kEmptyCell && board.get(col + 1, row) == t &&
-                    board.get(col, row + 1) == t && board.get(col + 1, row + 1) == t) {
-                    ok = true;
-                }
-            }
+    const int tile_a = board.get(move.a);
+    const int tile_b = board.get(move.b);
+    if (tile_a == tile_b) {
+        return false;
+    }
+    for (const auto& [cell, tile] : {std::pair{move.a, tile_b}, std::pair{move.b, tile_a}}) {
+        if (tile == kEmptyCell) {
+            continue;
+        }
+        if (SwappedMatchAt(board, move, cell, tile) ||
+            (board.bombsEnabled() && SwappedSquareAt(board, move, cell, tile))) {
+            return true;
         }
     }
-
-    board.swapCells(move);
-    return ok;
+    return false;
 }
 
 SimulationResult SimulateFullChain(Board& board, const Move& move) {
+    SimulationScratch scratch;
+    return SimulateFullChain(board, move, scratch, SimulationEvents::Record);
+}
+
+SimulationResult SimulateFullChain(Board& board, const Move& move, SimulationScratch& scratch,
+                                   SimulationEvents events) {
+    MATCH_ALLOC_SCOPE(Simulation);
     SimulationResult result{};
-    if (!board.inBounds(move.a) || !board.inBounds(move.b)) {
-        return result;
-    }
-    const int dist =
-        std::abs(move.a.col - move.b.col) + std::abs(move.a.row - move.b.row);
-    if (dist != 1) {
+    if (!IsAdjacentSwap(board, move)) {
         return result;
     }
 
     board.swapCells(move);
     result.move = move;
 
-    int total_cleared = 0;
-    int chains = 0;
-    int bombs_total = 0;
-    bool color_chain_happened = false;
-
-    while (true) {
-        const auto raw_groups = FindAllMatches(board);
-
-        std::vector<CellSet> base_groups;
-        base_groups.reserve(raw_groups.size());
-        CellSet matched_cells;
-        for (const auto& group : raw_groups) {
-            CellSet set;
-            set.insert(group.begin(), group.end());
-            matched_cells.insert(set.begin(), set.end());
-            base_groups.push_back(std::move(set));
+    const bool record = events == SimulationEvents::Record;
+    CascadeTotals totals;
+    SimulationResult::ChainEvent chain_event;
+    while (StepChain(board, scratch, totals, record ? &chain_event : nullptr)) {
+        if (record) {
+            result.clear_events.insert(result.clear_events.end(), chain_event.clears.begin(),
+                                       chain_event.clears.end());
+            result.fall_events.insert(result.fall_events.end(), chain_event.falls.begin(),
+                                      chain_event.falls.end());
+            result.spawn_events.insert(result.spawn_events.end(), chain_event.spawns.begin(),
+                                       chain_event.spawns.end());
+            result.chain_events.push_back(std::move(chain_event));
+            chain_event = SimulationResult::ChainEvent{};
         }
+    }
 
-        CellSet chain_neighbors;
-        if (board.colorChainEnabled() && !base_groups.empty()) {
-            constexpr int neighbor_offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-            for (const auto& group : base_groups) {
-                if (group.empty()) {
-                    continue;
-                }
-                const Cell sample = *group.begin();
-                const int match_color = board.get(sample);
-                if (match_color == kEmptyCell) {
-                    continue;
-                }
-                for (const auto& cell : group) {
-                    for (const auto& off : neighbor_offsets) {
-                        Cell neighbor{cell.col + off[0], cell.row + off[1]};
-                        if (!board.inBounds(neighbor)) {
-                            continue;
-                        }
-                        if (matched_cells.count(neighbor) > 0) {
-                            continue;
-                        }
-                        if (board.get(neighbor) == match_color) {
-                            chain_neighbors.insert(neighbor);
-                        }
-                    }
-                }
-            }
-        }
+    result.total_cleared = totals.total_cleared;
+    result.chains = totals.chains;
+    result.bombs_triggered = totals.bombs_triggered;
+    result.color_chain_triggered = totals.color_chain_triggered;
+    result.score = totals.score();
+    return result;
+}
 
-        std::vector<CellSet> bomb_groups;
-        if (board.bombsEnabled()) {
-            for (int col = 0; col < board.cols() - 1; ++col) {
-                for (int row = 0; row < board.rows() - 1; ++row) {
-                    const int t = board.get(col, row);
-                    if (t == kEmptyCell) {
-                        continue;
-                    }
-                    if (board.get(col + 1, row) == t && board.get(col, row + 1) == t &&
-                        board.get(col + 1, row + 1) == t) {
-                        CellSet bomb_cells;
-                        for (int x = col - 1; x <= col + 2; ++x) {
-                            for (int y = row - 1; y <= row + 2; ++y) {
-                                Cell candidate{x, y};
-                                if (board.inBounds(candidate)) {
-                                    bomb_cells.insert(candidate);
-                                }
-                            }
-                        }
-                        bomb_groups.push_back(std::move(bomb_cells));
-                    }
-                }
-            }
-        }
+bool StepChain(Board& board, SimulationScratch& scratch, CascadeTotals& totals,
+               SimulationResult::ChainEvent* chain) {
+    MATCH_ALLOC_SCOPE(Simulation);
+    scratch.prepare(board.cols(), board.rows());
+    const bool record = chain != nullptr;
+    if (record) {
+        // clears is trimmed once this chain's events are known, so its
+        // ClearEvents keep their cell storage for reuse.
+        chain->falls.clear();
+        chain->spawns.clear();
+    }
 
-        if (base_groups.empty() && bomb_groups.empty() && chain_neighbors.empty()) {
-            break;
+    // Every cell in a run, plus same-coloured orthogonal neighbours of
+    // those runs when colour chains are on.
+    scratch.matched.clear();
+    scratch.neighbors.clear();
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        const BitBoard& plane = *board.tilePlane(tile);
+        ComputeRunMasks(plane, scratch);
+        BitBoard& tile_matched = scratch.run_starts;
+        tile_matched.assign(scratch.run_horizontal);
+        tile_matched.orWith(scratch.run_vertical);
+        if (!tile_matched.any()) {
+            continue;
         }
-
-        CellSet to_remove;
-        for (const auto& group : base_groups) {
-            to_remove.insert(group.begin(), group.end());
+        scratch.matched.orWith(tile_matched);
+        if (board.colorChainEnabled()) {
+            const int stride = plane.stride();
+            scratch.squares.clear();
+            scratch.squares.orShiftedLeft(tile_matched, 1);
+            scratch.squares.orShiftedRight(tile_matched, 1);
+            scratch.squares.orShiftedLeft(tile_matched, stride);
+            scratch.squares.orShiftedRight(tile_matched, stride);
+            scratch.squares.andWith(plane);
+            scratch.neighbors.orWith(scratch.squares);
         }
-        for (const auto& group : bomb_groups) {
-            to_remove.insert(group.begin(), group.end());
+    }
+    scratch.neighbors.andNot(scratch.matched);
+
+    scratch.corners.clear();
+    if (board.bombsEnabled()) {
+        CollectBombSquares(board, scratch);
+    }
+
+    const bool has_matches = scratch.matched.any();
+    const bool has_neighbors = scratch.neighbors.any();
+    if (!has_matches && scratch.corners.empty() && !has_neighbors) {
+        if (record) {
+            chain->clears.clear();
         }
-        to_remove.insert(chain_neighbors.begin(), chain_neighbors.end());
-
-        total_cleared += static_cast<int>(to_remove.size()) +
-                         (2 * static_cast<int>(bomb_groups.size()));
-        ++chains;
-        bombs_total += static_cast<int>(bomb_groups.size());
-        if (!chain_neighbors.empty()) {
-            color_chain_happened = true;
+        return false;
+    }
+
+    scratch.removed.assign(scratch.matched);
+    scratch.removed.orWith(scratch.neighbors);
+    for (const auto& corner : scratch.corners) {
+        for (int x = corner.col - 1; x <= corner.col + 2; ++x) {
+            for (int y = corner.row - 1; y <= corner.row + 2; ++y) {
+                if (board.inBounds(x, y)) {
+                    scratch.removed.set(x, y);
+                }
+            }
         }
+    }
 
-        SimulationResult::ChainEvent chain_event;
-        std::vector<SimulationResult::ClearEvent> clear_events;
-        clear_events.reserve(base_groups.size() + bomb_groups.size() +
-                             (chain_neighbors.empty() ? 0 : 1));
+    const int bomb_count = static_cast<int>(scratch.corners.size());
+    totals.total_cleared += scratch.removed.count() + (2 * bomb_count);
+    ++totals.chains;
+    totals.bombs_triggered += bomb_count;
+    if (has_neighbors) {
+        totals.color_chain_triggered = true;
+    }
 
-        auto append_clear_event = [&](const CellSet& cells, bool via_bomb, bool via_color) {
+    if (record) {
+        std::size_t clear_count = 0;
+        auto append_clear_event = [&](const std::vector<Cell>& cells, bool via_bomb, bool via_color) {
             if (cells.empty()) {
                 return;
             }
-            SimulationResult::ClearEvent evt;
+            if (clear_count == chain->clears.size()) {
+                chain->clears.emplace_back();
+            }
+            SimulationResult::ClearEvent& evt = chain->clears[clear_count++];
             evt.via_bomb = via_bomb;
             evt.via_color = via_color;
-            evt.cells.reserve(cells.size());
+            evt.cells.clear();
             for (const auto& cell : cells) {
                 SimulationResult::ClearedCell cleared;
                 cleared.position = cell;
                 cleared.tile = board.get(cell);
                 evt.cells.push_back(cleared);
             }
-            chain_event.clears.push_back(evt);
-            clear_events.push_back(std::move(evt));
         };
 
-        for (const auto& group : base_groups) {
-            append_clear_event(group, /*via_bomb=*/false, /*via_color=*/false);
-        }
-        for (const auto& group : bomb_groups) {
-            append_clear_event(group, /*via_bomb=*/true, /*via_color=*/false);
+        if (has_matches) {
+            for (const auto& group : FindAllMatches(board)) {
+                append_clear_event(group, /*via_bomb=*/false, /*via_color=*/false);
+            }
         }
-        if (!chain_neighbors.empty()) {
-            append_clear_event(chain_neighbors, /*via_bomb=*/false, /*via_color=*/true);
+        for (const auto& corner : scratch.corners) {
+            scratch.cells.clear();
+            for (int x = corner.col - 1; x <= corner.col + 2; ++x) {
+                for (int y = corner.row - 1; y <= corner.row + 2; ++y) {
+                    if (board.inBounds(x, y)) {
+                        scratch.cells.push_back(Cell{x, y});
+                    }
+                }
+            }
+            append_clear_event(scratch.cells, /*via_bomb=*/true, /*via_color=*/false);
         }
-
-        for (const auto& cell : to_remove) {
-            board.set(cell, kEmptyCell);
+        if (has_neighbors) {
+            scratch.cells.clear();
+            scratch.neighbors.forEachSet([&](int col, int row) { scratch.cells.push_back(Cell{col, row}); });
+            std::sort(scratch.cells.begin(), scratch.cells.end());
+            append_clear_event(scratch.cells, /*via_bomb=*/false, /*via_color=*/true);
         }
+        chain->clears.resize(clear_count);
+    }
 
-        std::vector<SimulationResult::FallEvent> fall_events;
-        std::vector<SimulationResult::SpawnEvent> spawn_events;
+    // Gravity only has work below the lowest cleared cell of each column, so
+    // columns the chain did not touch are skipped. A board that already had
+    // holes before this chain (only hand-built ones do) gets the full sweep.
+    int occupied = 0;
+    for (int tile = 0; tile < board.planeCount(); ++tile) {
+        occupied += board.tilePlane(tile)->count();
+    }
+    const bool stray_holes = occupied != board.cols() * board.rows();
+    scratch.column_bottom.assign(static_cast<std::size_t>(board.cols()), stray_holes ? board.rows() - 1 : -1);
+    scratch.removed.forEachSet([&](int col, int row) {
+        board.set(col, row, kEmptyCell);
+        int& bottom = scratch.column_bottom[static_cast<std::size_t>(col)];
+        bottom = std::max(bottom, row);
+    });
 
-        for (int col = 0; col < board.cols(); ++col) {
-            int write = board.rows() - 1;
-            for (int row = board.rows() - 1; row >= 0; --row) {
-                const int val = board.get(col, row);
-                if (val == kEmptyCell) {
-                    continue;
-                }
-                if (write != row) {
-                    board.set(col, write, val);
+    for (int col = 0; col < board.cols(); ++col) {
+        const int bottom = scratch.column_bottom[static_cast<std::size_t>(col)];
+        if (bottom < 0) {
+            continue;
+        }
+        int write = bottom;
+        for (int row = bottom; row >= 0; --row) {
+            const int val = board.get(col, row);
+            if (val == kEmptyCell) {
+                continue;
+            }
+            if (write != row) {
+                board.set(col, write, val);
+                if (record) {
                     SimulationResult::FallEvent fall;
                     fall.from = Cell{col, row};
                     fall.to = Cell{col, write};
                     fall.tile = val;
-                    fall_events.push_back(fall);
-                    board.set(col, row, kEmptyCell);
+                    chain->falls.push_back(fall);
                 }
-                --write;
+                board.set(col, row, kEmptyCell);
             }
+            --write;
+        }
 
-            const int holes = write + 1;
-            int spawn_index = 0;
-            for (int row = write; row >= 0; --row, ++spawn_index) {
-                const int new_tile = board.randomTile();
-                board.set(col, row, new_tile);
+        const int holes = write + 1;
+        int spawn_index = 0;
+        for (int row = write; row >= 0; --row, ++spawn_index) {
+            const int new_tile = board.randomTile();
+            board.set(col, row, new_tile);
+            if (record) {
                 SimulationResult::SpawnEvent spawn;
                 spawn.position = Cell{col, row};
                 spawn.tile = new_tile;
                 spawn.distance_cells = std::max(1, holes - spawn_index);
-                spawn_events.push_back(spawn);
+                chain->spawns.push_back(spawn);
             }
         }
-
-        chain_event.falls.insert(chain_event.falls.end(), fall_events.begin(),
-                                 fall_events.end());
-        chain_event.spawns.insert(chain_event.spawns.end(), spawn_events.begin(),
-                                  spawn_events.end());
-
-        result.fall_events.insert(result.fall_events.end(), fall_events.begin(),
-                                  fall_events.end());
-        result.spawn_events.insert(result.spawn_events.end(), spawn_events.begin(),
-                                   spawn_events.end());
-
-        result.clear_events.insert(result.clear_events.end(),
-                                   std::make_move_iterator(clear_events.begin()),
-                                   std::make_move_iterator(clear_events.end()));
-        result.chain_events.push_back(std::move(chain_event));
     }
-
-    result.total_cleared = total_cleared;
-    result.chains = chains;
-    result.bombs_triggered = bombs_total;
-    result.color_chain_triggered = color_chain_happened;
-
-    result.score = (total_cleared >= 3) ? (1 + (total_cleared - 3)) : 0;
-    return result;
+    return true;
 }
 
-bool AnyLegalMoves(Board& board) {
+bool AnyLegalMoves(const Board& board) {
     for (int col = 0; col < board.cols(); ++col) {
         for (int row = 0; row < board.rows(); ++row) {
             const Cell origin{col, row};
             const Cell neighbors[2] = {{col + 1, row}, {col, row + 1}};
             for (const auto& neighbor : neighbors) {
                 Move move{origin, neighbor};
-                if (LegalSwap(board, move)) {
+                if (LegalSwapLocal(board, move)) {
                     return true;
                 }
             }
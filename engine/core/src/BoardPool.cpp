@@ -0,0 +1,115 @@
+#include "match/core/BoardPool.hpp"
+
+#include <utility>
+
+#include "match/core/Profiler.hpp"
+
+namespace match::core {
+
+namespace {
+
+bool SameRules(const Board::Rules& a, const Board::Rules& b) {
+    return a.cols == b.cols && a.rows == b.rows && a.tile_types == b.tile_types &&
+           a.bombs_enabled == b.bombs_enabled && a.color_chain_enabled == b.color_chain_enabled;
+}
+
+}  // namespace
+
+BoardPool::BoardPool(std::size_t depth)
+    : depth_(depth), seeds_(std::random_device{}()), thread_([this] { workerLoop(); }) {}
+
+BoardPool::~BoardPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+void BoardPool::prefill(const Board::Rules& rules) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shelfFor(rules);
+    }
+    wake_.notify_one();
+}
+
+BoardPool::Entry BoardPool::take(const Board::Rules& rules) {
+    std::uint32_t seed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Shelf& shelf = shelfFor(rules);
+        if (!shelf.boards.empty()) {
+            Entry entry = std::move(shelf.boards.front());
+            shelf.boards.pop_front();
+            wake_.notify_one();
+            return entry;
+        }
+        seed = seeds_();
+    }
+    wake_.notify_one();
+    MATCH_PROFILE_SCOPE("board_pool.miss");
+    return Entry{seed, NewBoard(rules, seed)};
+}
+
+std::size_t BoardPool::ready(const Board::Rules& rules) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Shelf& shelf : shelves_) {
+        if (SameRules(shelf.rules, rules)) {
+            return shelf.boards.size();
+        }
+    }
+    return 0;
+}
+
+BoardPool::Shelf& BoardPool::shelfFor(const Board::Rules& rules) {
+    for (Shelf& shelf : shelves_) {
+        if (SameRules(shelf.rules, rules)) {
+            return shelf;
+        }
+    }
+    shelves_.push_back(Shelf{rules, {}});
+    return shelves_.back();
+}
+
+BoardPool::Shelf* BoardPool::nextToFill() {
+    for (Shelf& shelf : shelves_) {
+        if (shelf.boards.size() < depth_) {
+            return &shelf;
+        }
+    }
+    return nullptr;
+}
+
+void BoardPool::workerLoop() {
+    while (true) {
+        Board::Rules rules;
+        std::uint32_t seed = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || nextToFill() != nullptr; });
+            if (stopping_) {
+                return;
+            }
+            rules = nextToFill()->rules;
+            seed = seeds_();
+        }
+
+        Entry entry{seed, NewBoard(rules, seed)};
+
+        // take() may have added shelves meanwhile, so look this one up again.
+        std::lock_guard<std::mutex> lock(mutex_);
+        Shelf& shelf = shelfFor(rules);
+        if (shelf.boards.size() < depth_) {
+            shelf.boards.push_back(std::move(entry));
+        }
+    }
+}
+
+BoardPool& SharedBoardPool() {
+    static BoardPool pool;
+    return pool;
+}
+
+}  // namespace match::core
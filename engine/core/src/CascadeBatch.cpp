@@ -0,0 +1,302 @@
+#include "match/core/CascadeBatch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "match/core/AllocTracker.hpp"
+
+namespace match::core {
+
+namespace {
+
+using Word = std::uint64_t;
+
+constexpr int kWords = kCascadeLanes / 8;
+static_assert(kCascadeLanes % 8 == 0);
+
+constexpr Word kHigh = 0x8080808080808080ull;
+constexpr Word kLow = 0x7F7F7F7F7F7F7F7Full;
+
+// Top bit of every byte where x and y hold the same value.
+constexpr Word Equal(Word x, Word y) {
+    const Word diff = x ^ y;
+    return ~(((diff & kLow) + kLow) | diff) & kHigh;
+}
+
+// Top bit of every byte holding a tile; kEmptyCell has its sign bit set.
+constexpr Word Occupied(Word x) {
+    return ~x & kHigh;
+}
+
+// Lanes are bytes in memory order, whatever the word's byte order.
+std::uint8_t* LaneBytes(std::vector<Word>& words) {
+    return reinterpret_cast<std::uint8_t*>(words.data());
+}
+
+bool IsAdjacent(const Board& board, const Move& move) {
+    return board.inBounds(move.a) && board.inBounds(move.b) &&
+           std::abs(move.a.col - move.b.col) + std::abs(move.a.row - move.b.row) == 1;
+}
+
+}  // namespace
+
+int CascadeBatch::add(const Board& board, const Move& move, const std::mt19937* rng, Board* result) {
+    if (jobs_.empty()) {
+        prepare(board);
+    } else if (board.cols() != cols_ || board.rows() != rows_ || board.tileTypes() != tile_types_ ||
+               board.bombsEnabled() != bombs_ || board.colorChainEnabled() != color_chain_) {
+        return -1;
+    }
+    Job job;
+    job.board = &board;
+    job.move = move;
+    job.rng = rng;
+    job.result = result;
+    jobs_.push_back(job);
+    return static_cast<int>(jobs_.size()) - 1;
+}
+
+void CascadeBatch::prepare(const Board& board) {
+    tile_types_ = board.tileTypes();
+    bombs_ = board.bombsEnabled();
+    color_chain_ = board.colorChainEnabled();
+    if (board.cols() == cols_ && board.rows() == rows_ && !rngs_.empty()) {
+        return;
+    }
+    cols_ = board.cols();
+    rows_ = board.rows();
+    stride_ = rows_ + 4;
+    const std::size_t words = static_cast<std::size_t>(cols_ + 4) * static_cast<std::size_t>(stride_) * kWords;
+    tiles_.assign(words, ~Word{0});
+    for (auto* mask : {&run_h_, &run_v_, &matched_, &squares_, &blast_, &removed_}) {
+        mask->assign(words, 0);
+    }
+    column_removed_.assign(static_cast<std::size_t>(cols_) * kWords, 0);
+    rngs_.resize(kCascadeLanes);
+}
+
+void CascadeBatch::run() {
+    MATCH_ALLOC_SCOPE(Simulation);
+    next_job_ = 0;
+    bool busy = false;
+    for (int lane = 0; lane < kCascadeLanes; ++lane) {
+        busy |= load(lane);
+    }
+    while (busy) {
+        busy = step();
+    }
+}
+
+bool CascadeBatch::load(int lane) {
+    const auto slot = static_cast<std::size_t>(lane);
+    while (next_job_ < jobs_.size()) {
+        Job& job = jobs_[next_job_];
+        const Board& board = *job.board;
+        const std::mt19937& rng = job.rng ? *job.rng : board.rng();
+        job.totals = CascadeTotals{};
+        // Like SimulateFullChain, a swap of non-neighbours resolves to nothing.
+        if (!IsAdjacent(board, job.move)) {
+            if (job.result) {
+                *job.result = board;
+                job.result->rng() = rng;
+            }
+            ++next_job_;
+            continue;
+        }
+
+        std::uint8_t* tiles = LaneBytes(tiles_) + lane;
+        bool holes = false;
+        for (int col = 0; col < cols_; ++col) {
+            for (int row = 0; row < rows_; ++row) {
+                const int tile = board.get(col, row);
+                tiles[index(col, row) * kCascadeLanes] = static_cast<std::uint8_t>(tile);
+                holes |= tile == kEmptyCell;
+            }
+        }
+        holes_[slot] = holes;
+        std::swap(tiles[index(job.move.a.col, job.move.a.row) * kCascadeLanes],
+                  tiles[index(job.move.b.col, job.move.b.row) * kCascadeLanes]);
+        rngs_[slot] = rng;
+        lane_job_[slot] = static_cast<int>(next_job_++);
+        return true;
+    }
+    lane_job_[slot] = -1;
+    return false;
+}
+
+void CascadeBatch::finish(int lane) {
+    const auto slot = static_cast<std::size_t>(lane);
+    Board* result = jobs_[static_cast<std::size_t>(lane_job_[slot])].result;
+    if (result) {
+        const std::uint8_t* tiles = LaneBytes(tiles_) + lane;
+        for (int col = 0; col < cols_; ++col) {
+            for (int row = 0; row < rows_; ++row) {
+                result->set(col, row, static_cast<std::int8_t>(tiles[index(col, row) * kCascadeLanes]));
+            }
+        }
+        result->rng() = rngs_[slot];
+    }
+    lane_job_[slot] = -1;
+}
+
+// One chain across every lane, following StepChain: runs of three, their
+// same-coloured neighbours when colour chains are on, and the 4x4 blast
+// around every 2x2 square when bombs are. Only interior cells are written,
+// so padding stays empty in tiles_ and clear in the masks.
+bool CascadeBatch::step() {
+    const int down = kWords;
+    const int right = stride_ * kWords;
+    const Word* tiles = tiles_.data();
+    Word* run_h = run_h_.data();
+    Word* run_v = run_v_.data();
+    Word* matched = matched_.data();
+    Word* squares = squares_.data();
+    Word* blast = blast_.data();
+    Word* removed = removed_.data();
+
+    for (int col = 0; col < cols_; ++col) {
+        const int first = index(col, 0) * kWords;
+        const int last = first + rows_ * kWords;
+        for (int i = first; i < last; ++i) {
+            const Word a = tiles[i];
+            const Word occupied = Occupied(a);
+            const Word same_right = Equal(a, tiles[i + right]);
+            const Word same_down = Equal(a, tiles[i + down]);
+            run_h[i] = occupied & same_right & Equal(a, tiles[i + 2 * right]);
+            run_v[i] = occupied & same_down & Equal(a, tiles[i + 2 * down]);
+            if (bombs_) {
+                squares[i] = occupied & same_right & same_down & Equal(a, tiles[i + right + down]);
+            }
+        }
+    }
+
+    for (int col = 0; col < cols_; ++col) {
+        const int first = index(col, 0) * kWords;
+        const int last = first + rows_ * kWords;
+        for (int i = first; i < last; ++i) {
+            matched[i] = run_h[i] | run_h[i - right] | run_h[i - 2 * right] | run_v[i] | run_v[i - down] |
+                         run_v[i - 2 * down];
+            if (bombs_) {
+                // A square's top-left corner blasts from one cell above and
+                // left of it to two below and right; rows first, columns in
+                // the next pass.
+                blast[i] = squares[i - 2 * down] | squares[i - down] | squares[i] | squares[i + down];
+            }
+        }
+    }
+
+    Word any_removed[kWords] = {};
+    Word colored[kWords] = {};
+    for (int col = 0; col < cols_; ++col) {
+        const int first = index(col, 0) * kWords;
+        const int last = first + rows_ * kWords;
+        Word* column_removed = column_removed_.data() + col * kWords;
+        for (int w = 0; w < kWords; ++w) {
+            column_removed[w] = 0;
+        }
+        for (int i = first; i < last; ++i) {
+            Word r = matched[i];
+            if (color_chain_) {
+                const Word a = tiles[i];
+                const Word near = (matched[i - down] & Equal(a, tiles[i - down])) |
+                                  (matched[i + down] & Equal(a, tiles[i + down])) |
+                                  (matched[i - right] & Equal(a, tiles[i - right])) |
+                                  (matched[i + right] & Equal(a, tiles[i + right]));
+                const Word neighbor = ~matched[i] & Occupied(a) & near;
+                r |= neighbor;
+                colored[i % kWords] |= neighbor;
+            }
+            if (bombs_) {
+                r |= blast[i - 2 * right] | blast[i - right] | blast[i] | blast[i + right];
+            }
+            removed[i] = r;
+            column_removed[i % kWords] |= r;
+        }
+        for (int w = 0; w < kWords; ++w) {
+            any_removed[w] |= column_removed[w];
+        }
+    }
+
+    const auto* any_bytes = reinterpret_cast<const std::uint8_t*>(any_removed);
+    const auto* colored_bytes = reinterpret_cast<const std::uint8_t*>(colored);
+    std::uint8_t* tile_bytes = LaneBytes(tiles_);
+    const std::uint8_t* removed_bytes = LaneBytes(removed_);
+    const std::uint8_t* square_bytes = LaneBytes(squares_);
+    const std::uint8_t* column_bytes = LaneBytes(column_removed_);
+    bool busy = false;
+    for (int lane = 0; lane < kCascadeLanes; ++lane) {
+        const auto slot = static_cast<std::size_t>(lane);
+        if (lane_job_[slot] < 0) {
+            continue;
+        }
+        if (any_bytes[lane] == 0) {
+            finish(lane);
+            busy |= load(lane);
+            continue;
+        }
+        busy = true;
+
+        // Collapse each column over the cleared cells, then refill from the
+        // lowest hole upwards, drawing in the same order as StepChain. As
+        // there, columns without a cleared cell are left alone and a column
+        // is only walked from its lowest cleared cell, which is at or below
+        // every square corner in it.
+        std::mt19937& rng = rngs_[slot];
+        const bool sweep = holes_[slot];
+        bool spawned_hole = false;
+        int cleared = 0;
+        int bombs = 0;
+        for (int col = 0; col < cols_; ++col) {
+            if (!sweep && column_bytes[col * kCascadeLanes + lane] == 0) {
+                continue;
+            }
+            const int top = index(col, 0) * kCascadeLanes + lane;
+            int row = rows_ - 1;
+            if (!sweep) {
+                while (removed_bytes[top + row * kCascadeLanes] == 0) {
+                    --row;
+                }
+            }
+            int write = row;
+            for (; row >= 0; --row) {
+                const int at = top + row * kCascadeLanes;
+                bombs += bombs_ && square_bytes[at] != 0;
+                if (removed_bytes[at] != 0) {
+                    ++cleared;
+                    continue;
+                }
+                const std::uint8_t value = tile_bytes[at];
+                if (value == static_cast<std::uint8_t>(kEmptyCell)) {
+                    continue;
+                }
+                if (write != row) {
+                    tile_bytes[top + write * kCascadeLanes] = value;
+                }
+                --write;
+            }
+            for (int row = write; row >= 0; --row) {
+                int tile = 0;
+                if (tile_types_ > 0) {
+                    std::uniform_int_distribution<int> dist(0, tile_types_ - 1);
+                    tile = dist(rng);
+                }
+                // Board::set stores out-of-range tiles as holes.
+                const bool hole = tile > kMaxTileValue;
+                tile_bytes[top + row * kCascadeLanes] = static_cast<std::uint8_t>(hole ? kEmptyCell : tile);
+                spawned_hole |= hole;
+            }
+        }
+        holes_[slot] = spawned_hole;
+
+        CascadeTotals& totals = jobs_[static_cast<std::size_t>(lane_job_[slot])].totals;
+        totals.total_cleared += cleared + 2 * bombs;
+        ++totals.chains;
+        totals.bombs_triggered += bombs;
+        if (colored_bytes[lane] != 0) {
+            totals.color_chain_triggered = true;
+        }
+    }
+    return busy;
+}
+
+}  // namespace match::core
@@ -0,0 +1,146 @@
+#include "match/core/LegalMoveIndex.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "match/core/AllocTracker.hpp"
+#include "match/core/Profiler.hpp"
+
+namespace match::core {
+
+void LegalMoveIndex::rebuild(const Board& board) {
+    MATCH_PROFILE_SCOPE("legal_moves.rebuild");
+    MATCH_ALLOC_SCOPE(Simulation);
+    cols_ = board.cols();
+    rows_ = board.rows();
+    const std::size_t slots = static_cast<std::size_t>(cols_) * static_cast<std::size_t>(rows_) * 2;
+    position_.assign(slots, kNoMove);
+    dirty_.assign(slots / 2, 0);
+    moves_.clear();
+    for (int slot = 0; slot < static_cast<int>(slots); ++slot) {
+        refreshSlot(board, slot);
+    }
+}
+
+void LegalMoveIndex::update(const Board& board, const SimulationResult& result) {
+    MATCH_ALLOC_SCOPE(Simulation);
+    std::vector<Cell> changed;
+    changed.reserve(result.fall_events.size() * 2 + result.spawn_events.size() + 2);
+    changed.push_back(result.move.a);
+    changed.push_back(result.move.b);
+    for (const auto& clear : result.clear_events) {
+        for (const auto& cell : clear.cells) {
+            changed.push_back(cell.position);
+        }
+    }
+    for (const auto& fall : result.fall_events) {
+        changed.push_back(fall.from);
+        changed.push_back(fall.to);
+    }
+    for (const auto& spawn : result.spawn_events) {
+        changed.push_back(spawn.position);
+    }
+    update(board, changed);
+}
+
+void LegalMoveIndex::update(const Board& board, const std::vector<Cell>& changed) {
+    MATCH_ALLOC_SCOPE(Simulation);
+    if (board.cols() != cols_ || board.rows() != rows_) {
+        rebuild(board);
+        return;
+    }
+
+    // LegalSwapLocal reads up to two cells past either end of a swap, so a
+    // changed cell can affect any swap whose origin lies in the 6x6 window
+    // from three cells up/left to two cells down/right of it.
+    std::vector<int> pending;
+    for (const auto& cell : changed) {
+        const int col_begin = std::max(0, cell.col - 3);
+        const int col_end = std::min(cols_ - 1, cell.col + 2);
+        const int row_begin = std::max(0, cell.row - 3);
+        const int row_end = std::min(rows_ - 1, cell.row + 2);
+        for (int col = col_begin; col <= col_end; ++col) {
+            for (int row = row_begin; row <= row_end; ++row) {
+                const int origin = col * rows_ + row;
+                if (dirty_[static_cast<std::size_t>(origin)] == 0) {
+                    dirty_[static_cast<std::size_t>(origin)] = 1;
+                    pending.push_back(origin);
+                }
+            }
+        }
+    }
+    for (const int origin : pending) {
+        dirty_[static_cast<std::size_t>(origin)] = 0;
+        refreshSlot(board, origin * 2);
+        refreshSlot(board, origin * 2 + 1);
+    }
+}
+
+bool LegalMoveIndex::isLegal(const Move& move) const noexcept {
+    const int slot = slotFor(move);
+    return slot != kNoMove && position_[static_cast<std::size_t>(slot)] != kNoMove;
+}
+
+std::optional<Move> LegalMoveIndex::hint() const {
+    if (moves_.empty()) {
+        return std::nullopt;
+    }
+    return moveForSlot(*std::min_element(moves_.begin(), moves_.end()));
+}
+
+std::vector<Move> LegalMoveIndex::moves() const {
+    std::vector<int> slots = moves_;
+    std::sort(slots.begin(), slots.end());
+    std::vector<Move> result;
+    result.reserve(slots.size());
+    for (const int slot : slots) {
+        result.push_back(moveForSlot(slot));
+    }
+    return result;
+}
+
+int LegalMoveIndex::slotFor(const Move& move) const noexcept {
+    Cell origin = move.a;
+    Cell other = move.b;
+    if (other < origin) {
+        std::swap(origin, other);
+    }
+    if (origin.col < 0 || origin.col >= cols_ || origin.row < 0 || origin.row >= rows_) {
+        return kNoMove;
+    }
+    const int base = (origin.col * rows_ + origin.row) * 2;
+    if (other.col == origin.col + 1 && other.row == origin.row && other.col < cols_) {
+        return base;
+    }
+    if (other.col == origin.col && other.row == origin.row + 1 && other.row < rows_) {
+        return base + 1;
+    }
+    return kNoMove;
+}
+
+Move LegalMoveIndex::moveForSlot(int slot) const noexcept {
+    const int origin = slot / 2;
+    const Cell a{origin / rows_, origin % rows_};
+    const Cell b = (slot % 2 == 0) ? Cell{a.col + 1, a.row} : Cell{a.col, a.row + 1};
+    return Move{a, b};
+}
+
+void LegalMoveIndex::refreshSlot(const Board& board, int slot) {
+    const bool legal = LegalSwapLocal(board, moveForSlot(slot));
+    int& position = position_[static_cast<std::size_t>(slot)];
+    if (legal == (position != kNoMove)) {
+        return;
+    }
+    if (legal) {
+        position = static_cast<int>(moves_.size());
+        moves_.push_back(slot);
+        return;
+    }
+    const int last = moves_.back();
+    moves_[static_cast<std::size_t>(position)] = last;
+    position_[static_cast<std::size_t>(last)] = position;
+    moves_.pop_back();
+    position = kNoMove;
+}
+
+}  // namespace match::core
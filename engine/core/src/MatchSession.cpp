@@ -0,0 +1,175 @@
+#include "match/core/MatchSession.hpp"
+
+#include <algorithm>
+
+namespace match::core {
+
+namespace {
+
+int NextSeatWithMoves(const std::vector<int>& moves_left, int from_seat) {
+    const int count = static_cast<int>(moves_left.size());
+    for (int step = 1; step <= count; ++step) {
+        const int candidate = (from_seat + step) % count;
+        if (moves_left[static_cast<std::size_t>(candidate)] > 0) {
+            return candidate;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+TurnState StartTurns(const MatchRules& rules) {
+    TurnState turns;
+    turns.moves_left.assign(static_cast<std::size_t>(std::max(1, rules.players)),
+                            std::max(1, rules.moves_per_round));
+    return turns;
+}
+
+void EndTurn(const MatchRules& rules, TurnState& turns, bool forfeit) {
+    if (turns.game_over || turns.moves_left.empty()) {
+        return;
+    }
+    turns.active_player =
+        std::clamp(turns.active_player, 0, static_cast<int>(turns.moves_left.size()) - 1);
+    auto& left = turns.moves_left[static_cast<std::size_t>(turns.active_player)];
+    left = forfeit ? 0 : std::max(0, left - 1);
+
+    const bool round_finished = std::all_of(turns.moves_left.begin(), turns.moves_left.end(),
+                                            [](int value) { return value <= 0; });
+    if (round_finished) {
+        turns.round += 1;
+        if (turns.round > std::max(1, rules.rounds)) {
+            turns.game_over = true;
+        } else {
+            std::fill(turns.moves_left.begin(), turns.moves_left.end(), std::max(1, rules.moves_per_round));
+            turns.active_player = 0;
+        }
+    } else if (rules.turn_order != TurnOrder::Consecutive || left <= 0) {
+        const int next = NextSeatWithMoves(turns.moves_left, turns.active_player);
+        if (next >= 0) {
+            turns.active_player = next;
+        }
+    }
+}
+
+MatchSession::MatchSession(const MatchRules& rules, std::uint32_t seed)
+    : rules_(rules),
+      board_(NewBoard(rules.board, seed)),
+      legal_moves_(board_),
+      turns_(StartTurns(rules)),
+      scores_(turns_.moves_left.size(), 0) {
+    rules_.players = static_cast<int>(turns_.moves_left.size());
+    replay_.seed = seed;
+    replay_.rules = rules_;
+}
+
+bool MatchSession::play(const Move& move, SimulationResult* result) {
+    if (turns_.game_over || !legal_moves_.isLegal(move)) {
+        return false;
+    }
+    SimulationResult cascade = SimulateFullChain(board_, move, scratch_);
+    legal_moves_.update(board_, cascade);
+    scores_[static_cast<std::size_t>(turns_.active_player)] += cascade.score;
+
+    ReplayMove entry;
+    entry.move = move;
+    entry.player = turns_.active_player;
+    replay_.moves.push_back(entry);
+
+    if (result) {
+        *result = std::move(cascade);
+    }
+    finishTurn(false);
+    return true;
+}
+
+void MatchSession::forfeitTurn() {
+    finishTurn(true);
+}
+
+void MatchSession::finishTurn(bool forfeit) {
+    EndTurn(rules_, turns_, forfeit);
+    if (turns_.game_over) {
+        replay_.final_digest = BoardDigest(board_);
+    }
+}
+
+SessionHost::SessionHost(WorkerPool& pool) : pool_(pool) {}
+
+SessionHost::SessionId SessionHost::open(const MatchRules& rules, std::uint32_t seed,
+                                         std::vector<Seat> seats) {
+    auto hosted = std::make_unique<Hosted>(rules, seed);
+    hosted->seats = std::move(seats);
+    sessions_.push_back(std::move(hosted));
+    return sessions_.size() - 1;
+}
+
+void SessionHost::submit(SessionId id, const Move& move) {
+    Hosted& hosted = *sessions_[id];
+    std::lock_guard<std::mutex> lock(hosted.inbox_mutex);
+    hosted.inbox.push_back(move);
+}
+
+const SessionHost::Seat* SessionHost::activeSeat(const Hosted& hosted) {
+    const int seat = hosted.match.activePlayer();
+    return seat < static_cast<int>(hosted.seats.size()) ? &hosted.seats[static_cast<std::size_t>(seat)]
+                                                        : nullptr;
+}
+
+bool SessionHost::waitingOnRemote(Hosted& hosted) {
+    const Seat* seat = activeSeat(hosted);
+    if (!seat || !seat->remote || !hosted.match.legalMoves().any()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(hosted.inbox_mutex);
+    return hosted.inbox.empty();
+}
+
+bool SessionHost::playOne(Hosted& hosted) {
+    MatchSession& match = hosted.match;
+    const Seat* policy = activeSeat(hosted);
+
+    if (policy && policy->remote && match.legalMoves().any()) {
+        // Illegal swaps are dropped and cost the seat nothing.
+        std::lock_guard<std::mutex> lock(hosted.inbox_mutex);
+        while (!hosted.inbox.empty()) {
+            const Move move = hosted.inbox.front();
+            hosted.inbox.pop_front();
+            if (match.play(move)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const auto choice = ChooseSeatMove(match.board(), match.legalMoves(), policy ? &policy->policy : nullptr);
+    if (!choice || !match.play(choice->move)) {
+        match.forfeitTurn();
+    }
+    return true;
+}
+
+std::size_t SessionHost::advance(int max_moves) {
+    pool_.parallelFor(sessions_.size(), [&](std::size_t index, unsigned) {
+        Hosted& hosted = *sessions_[index];
+        for (int i = 0; i < max_moves && !hosted.match.gameOver(); ++i) {
+            if (!playOne(hosted)) {
+                break;
+            }
+        }
+    });
+    return static_cast<std::size_t>(std::count_if(sessions_.begin(), sessions_.end(), [](const auto& hosted) {
+        return !hosted->match.gameOver();
+    }));
+}
+
+void SessionHost::runToCompletion() {
+    while (std::any_of(sessions_.begin(), sessions_.end(), [](const auto& hosted) {
+        return !hosted->match.gameOver() && !waitingOnRemote(*hosted);
+    })) {
+        advance(64);
+    }
+}
+
+}  // namespace match::core
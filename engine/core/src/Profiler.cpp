@@ -0,0 +1,154 @@
+#include "match/core/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+
+#include "match/core/Json.hpp"
+
+namespace match::core {
+
+namespace {
+
+constexpr const char* kFramePhase = "frame";
+
+std::uint32_t CurrentThreadIndex() {
+    static std::atomic<std::uint32_t> next{1};
+    thread_local const std::uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+double ToMillis(std::uint64_t micros) {
+    return static_cast<double>(micros) / 1000.0;
+}
+
+}  // namespace
+
+Profiler::Profiler() {
+    trace_.resize(kTraceCapacity);
+}
+
+Profiler& Profiler::Instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+std::uint64_t Profiler::NowMicros() noexcept {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point origin = Clock::now();
+    // Offset by one so a start time of zero can mean "not timing".
+    return static_cast<std::uint64_t>(
+               std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin).count()) +
+           1;
+}
+
+void Profiler::record(const char* name, std::uint64_t start_us, std::uint64_t duration_us) {
+    const std::uint32_t thread = CurrentThreadIndex();
+    std::lock_guard<std::mutex> lock(mutex_);
+    trace_[trace_next_] = TraceEvent{name, start_us, duration_us, thread};
+    trace_next_ = (trace_next_ + 1) % trace_.size();
+    trace_wrapped_ = trace_wrapped_ || trace_next_ == 0;
+
+    Samples& samples = samples_[name];
+    if (samples.durations_us.size() < kSampleWindow) {
+        samples.durations_us.push_back(duration_us);
+    } else {
+        samples.durations_us[samples.next] = duration_us;
+    }
+    samples.next = (samples.next + 1) % kSampleWindow;
+    samples.last_us = duration_us;
+}
+
+void Profiler::markFrame() {
+    if (!enabled()) {
+        return;
+    }
+    const std::uint64_t now = NowMicros();
+    std::uint64_t previous = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        previous = last_frame_us_;
+        last_frame_us_ = now;
+    }
+    if (previous != 0) {
+        record(kFramePhase, previous, now - previous);
+    }
+}
+
+std::vector<Profiler::PhaseStats> Profiler::phaseStats() const {
+    std::map<std::string, std::pair<std::vector<std::uint64_t>, std::uint64_t>> pooled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, samples] : samples_) {
+            auto& entry = pooled[name];
+            entry.first.insert(entry.first.end(), samples.durations_us.begin(), samples.durations_us.end());
+            entry.second = samples.last_us;
+        }
+    }
+
+    std::vector<PhaseStats> stats;
+    stats.reserve(pooled.size());
+    for (auto& [name, entry] : pooled) {
+        auto& durations = entry.first;
+        if (durations.empty()) {
+            continue;
+        }
+        PhaseStats phase;
+        phase.name = name;
+        phase.samples = durations.size();
+        std::uint64_t total = 0;
+        for (std::uint64_t value : durations) {
+            total += value;
+        }
+        phase.average_ms = ToMillis(total) / static_cast<double>(durations.size());
+        const std::size_t rank = (durations.size() * 99 + 99) / 100 - 1;
+        std::nth_element(durations.begin(), durations.begin() + static_cast<std::ptrdiff_t>(rank),
+                         durations.end());
+        phase.p99_ms = ToMillis(durations[rank]);
+        phase.last_ms = ToMillis(entry.second);
+        stats.push_back(std::move(phase));
+    }
+    std::stable_partition(stats.begin(), stats.end(),
+                          [](const PhaseStats& phase) { return phase.name == kFramePhase; });
+    return stats;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fill(trace_.begin(), trace_.end(), TraceEvent{});
+    trace_next_ = 0;
+    trace_wrapped_ = false;
+    samples_.clear();
+    last_frame_us_ = 0;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    Json events = Json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::size_t count = trace_wrapped_ ? trace_.size() : trace_next_;
+        const std::size_t first = trace_wrapped_ ? trace_next_ : 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const TraceEvent& event = trace_[(first + i) % trace_.size()];
+            if (event.name == nullptr) {
+                continue;
+            }
+            events.push_back(Json{{"name", event.name},
+                                  {"ph", "X"},
+                                  {"ts", event.start_us},
+                                  {"dur", event.duration_us},
+                                  {"pid", 1},
+                                  {"tid", event.thread}});
+        }
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << Json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}.dump();
+    return static_cast<bool>(out);
+}
+
+}  // namespace match::core
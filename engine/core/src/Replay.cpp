@@ -0,0 +1,348 @@
+#include "match/core/Replay.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace match::core {
+
+namespace {
+
+// Layout, fixed-width integers little-endian:
+//   "MRPL" u16 version u16 reserved u32 seed
+//   u16 cols u16 rows u8 tile_types u8 flags u8 players u16 rounds
+//   u16 moves_per_round u64 final_digest
+//   str mode, u8 count + str players, varint move_count
+//   move_count x { varint delta_ms, varint cell, u8 direction | seat << 2 }
+// Strings are a u8 byte length followed by the bytes. cell is the row-major
+// index of move.a; direction says which neighbour move.b is.
+constexpr std::uint8_t kMagic[4] = {'M', 'R', 'P', 'L'};
+constexpr std::size_t kMaxSeats = 64;
+
+constexpr std::uint8_t kFlagBombs = 1;
+constexpr std::uint8_t kFlagColorChain = 2;
+constexpr std::uint8_t kFlagRoundRobin = 4;
+
+constexpr int kDirectionCol[4] = {1, 0, -1, 0};
+constexpr int kDirectionRow[4] = {0, 1, 0, -1};
+
+void PutU16(std::vector<std::uint8_t>& out, std::uint16_t value) {
+    out.push_back(static_cast<std::uint8_t>(value));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void PutU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void PutU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    PutU32(out, static_cast<std::uint32_t>(value));
+    PutU32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+void PutVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void PutString(std::vector<std::uint8_t>& out, const std::string& text) {
+    const std::size_t length = std::min<std::size_t>(text.size(), 0xFF);
+    out.push_back(static_cast<std::uint8_t>(length));
+    out.insert(out.end(), text.begin(), text.begin() + static_cast<std::ptrdiff_t>(length));
+}
+
+// Same contract as the save reader: an overrun clears ok() and later reads
+// return zero.
+class Reader {
+public:
+    Reader(const std::uint8_t* data, std::size_t size) : cursor_(data), end_(data + size) {}
+
+    bool ok() const noexcept { return ok_; }
+    std::size_t remaining() const noexcept { return static_cast<std::size_t>(end_ - cursor_); }
+
+    const std::uint8_t* take(std::size_t count) {
+        if (!ok_ || remaining() < count) {
+            ok_ = false;
+            return nullptr;
+        }
+        const std::uint8_t* at = cursor_;
+        cursor_ += count;
+        return at;
+    }
+
+    std::uint8_t u8() {
+        const std::uint8_t* at = take(1);
+        return at ? at[0] : 0;
+    }
+    std::uint16_t u16() {
+        const std::uint8_t* at = take(2);
+        return at ? static_cast<std::uint16_t>(at[0] | (at[1] << 8)) : 0;
+    }
+    std::uint32_t u32() {
+        const std::uint8_t* at = take(4);
+        if (!at) {
+            return 0;
+        }
+        return static_cast<std::uint32_t>(at[0]) | (static_cast<std::uint32_t>(at[1]) << 8) |
+               (static_cast<std::uint32_t>(at[2]) << 16) | (static_cast<std::uint32_t>(at[3]) << 24);
+    }
+    std::uint64_t u64() {
+        const std::uint64_t low = u32();
+        return low | (static_cast<std::uint64_t>(u32()) << 32);
+    }
+    std::uint32_t varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            const std::uint8_t byte = u8();
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+    std::string str() {
+        const std::uint8_t length = u8();
+        const std::uint8_t* at = take(length);
+        return at ? std::string(reinterpret_cast<const char*>(at), length) : std::string{};
+    }
+
+private:
+    const std::uint8_t* cursor_;
+    const std::uint8_t* end_;
+    bool ok_ = true;
+};
+
+bool Fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+int DirectionOf(const Move& move) {
+    for (int dir = 0; dir < 4; ++dir) {
+        if (move.b.col - move.a.col == kDirectionCol[dir] &&
+            move.b.row - move.a.row == kDirectionRow[dir]) {
+            return dir;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+std::uint64_t BoardDigest(const Board& board) noexcept {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (value >> shift) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(static_cast<std::uint32_t>(board.cols()));
+    mix(static_cast<std::uint32_t>(board.rows()));
+    for (int r = 0; r < board.rows(); ++r) {
+        for (int c = 0; c < board.cols(); ++c) {
+            hash ^= static_cast<std::uint8_t>(static_cast<std::int8_t>(board.get(c, r)));
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+void EncodeReplay(const Replay& replay, std::vector<std::uint8_t>& out) {
+    const Board::Rules& board = replay.rules.board;
+    out.clear();
+    out.reserve(64 + replay.moves.size() * 4);
+    out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+    PutU16(out, kReplayVersion);
+    PutU16(out, 0);
+    PutU32(out, replay.seed);
+    PutU16(out, static_cast<std::uint16_t>(board.cols));
+    PutU16(out, static_cast<std::uint16_t>(board.rows));
+    out.push_back(static_cast<std::uint8_t>(board.tile_types));
+    out.push_back(static_cast<std::uint8_t>((board.bombs_enabled ? kFlagBombs : 0) |
+                                            (board.color_chain_enabled ? kFlagColorChain : 0) |
+                                            (replay.rules.turn_order == TurnOrder::RoundRobin
+                                                 ? kFlagRoundRobin
+                                                 : 0)));
+    out.push_back(static_cast<std::uint8_t>(std::clamp<int>(replay.rules.players, 1, kMaxSeats)));
+    PutU16(out, static_cast<std::uint16_t>(replay.rules.rounds));
+    PutU16(out, static_cast<std::uint16_t>(replay.rules.moves_per_round));
+    PutU64(out, replay.final_digest);
+    PutString(out, replay.mode);
+    const std::size_t names = std::min<std::size_t>(replay.players.size(), kMaxSeats);
+    out.push_back(static_cast<std::uint8_t>(names));
+    for (std::size_t i = 0; i < names; ++i) {
+        PutString(out, replay.players[i]);
+    }
+
+    // Moves that cannot be expressed (not adjacent, or off the board) end
+    // the recording rather than corrupting it.
+    std::size_t count = 0;
+    for (const auto& entry : replay.moves) {
+        if (DirectionOf(entry.move) < 0 || entry.move.a.col < 0 || entry.move.a.col >= board.cols ||
+            entry.move.a.row < 0 || entry.move.a.row >= board.rows || entry.player < 0 ||
+            entry.player >= static_cast<int>(kMaxSeats)) {
+            break;
+        }
+        ++count;
+    }
+    PutVarint(out, static_cast<std::uint32_t>(count));
+    std::uint32_t previous_ms = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const ReplayMove& entry = replay.moves[i];
+        const std::uint32_t time_ms = std::max(entry.time_ms, previous_ms);
+        PutVarint(out, time_ms - previous_ms);
+        previous_ms = time_ms;
+        PutVarint(out, static_cast<std::uint32_t>(entry.move.a.row * board.cols + entry.move.a.col));
+        out.push_back(static_cast<std::uint8_t>(DirectionOf(entry.move) | (entry.player << 2)));
+    }
+}
+
+bool DecodeReplay(const std::uint8_t* data, std::size_t size, Replay& out, std::string* error) {
+    Reader reader(data, size);
+    const std::uint8_t* magic = reader.take(sizeof(kMagic));
+    if (!magic || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        return Fail(error, "not a replay file");
+    }
+    if (reader.u16() != kReplayVersion) {
+        return Fail(error, "unsupported replay version");
+    }
+    reader.u16();
+
+    Replay replay;
+    replay.seed = reader.u32();
+    Board::Rules& board = replay.rules.board;
+    board.cols = reader.u16();
+    board.rows = reader.u16();
+    board.tile_types = reader.u8();
+    const std::uint8_t flags = reader.u8();
+    board.bombs_enabled = (flags & kFlagBombs) != 0;
+    board.color_chain_enabled = (flags & kFlagColorChain) != 0;
+    replay.rules.turn_order = (flags & kFlagRoundRobin) != 0 ? TurnOrder::RoundRobin
+                                                             : TurnOrder::Consecutive;
+    replay.rules.players = reader.u8();
+    replay.rules.rounds = reader.u16();
+    replay.rules.moves_per_round = reader.u16();
+    replay.final_digest = reader.u64();
+    replay.mode = reader.str();
+    const std::uint8_t names = reader.u8();
+    for (std::uint8_t i = 0; i < names && reader.ok(); ++i) {
+        replay.players.push_back(reader.str());
+    }
+    if (!reader.ok()) {
+        return Fail(error, "replay header is truncated");
+    }
+    if (board.cols <= 0 || board.rows <= 0 || board.tile_types <= 0 || replay.rules.players <= 0) {
+        return Fail(error, "replay rules are invalid");
+    }
+
+    const std::uint32_t count = reader.varint();
+    // Every move takes at least three bytes.
+    if (!reader.ok() || count > reader.remaining() / 3) {
+        return Fail(error, "replay move list is truncated");
+    }
+    replay.moves.reserve(count);
+    std::uint32_t time_ms = 0;
+    const std::uint32_t cells = static_cast<std::uint32_t>(board.cols) * static_cast<std::uint32_t>(board.rows);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        time_ms += reader.varint();
+        const std::uint32_t cell = reader.varint();
+        const std::uint8_t packed = reader.u8();
+        if (!reader.ok()) {
+            return Fail(error, "replay move list is truncated");
+        }
+        ReplayMove entry;
+        entry.time_ms = time_ms;
+        entry.player = packed >> 2;
+        entry.move.a = {static_cast<int>(cell % static_cast<std::uint32_t>(board.cols)),
+                        static_cast<int>(cell / static_cast<std::uint32_t>(board.cols))};
+        entry.move.b = {entry.move.a.col + kDirectionCol[packed & 3],
+                        entry.move.a.row + kDirectionRow[packed & 3]};
+        if (cell >= cells || entry.move.b.col < 0 || entry.move.b.col >= board.cols ||
+            entry.move.b.row < 0 || entry.move.b.row >= board.rows ||
+            entry.player >= replay.rules.players) {
+            return Fail(error, "replay move is off the board");
+        }
+        replay.moves.push_back(entry);
+    }
+    out = std::move(replay);
+    return true;
+}
+
+bool DecodeReplay(const std::vector<std::uint8_t>& bytes, Replay& out, std::string* error) {
+    return DecodeReplay(bytes.data(), bytes.size(), out, error);
+}
+
+void ReplayRecorder::start(std::uint32_t seed, const MatchRules& rules, std::string mode,
+                           std::vector<std::string> players) {
+    replay_ = Replay{};
+    replay_.seed = seed;
+    replay_.rules = rules;
+    replay_.mode = std::move(mode);
+    replay_.players = std::move(players);
+    started_ = std::chrono::steady_clock::now();
+    recording_ = true;
+}
+
+void ReplayRecorder::record(const Move& move, int player) {
+    if (!recording_) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started_);
+    ReplayMove entry;
+    entry.move = move;
+    entry.time_ms = static_cast<std::uint32_t>(std::max<std::int64_t>(0, elapsed.count()));
+    entry.player = player;
+    replay_.moves.push_back(entry);
+}
+
+void ReplayRecorder::finish(const Board& board) {
+    if (!recording_) {
+        return;
+    }
+    replay_.final_digest = BoardDigest(board);
+    recording_ = false;
+}
+
+ReplayResult PlayReplay(const Replay& replay, Board* board_out) {
+    const auto start = std::chrono::steady_clock::now();
+    ReplayResult result;
+    result.scores.assign(static_cast<std::size_t>(std::max(1, replay.rules.players)), 0);
+
+    Board board = NewBoard(replay.rules.board, replay.seed);
+    SimulationScratch scratch;
+    for (const auto& entry : replay.moves) {
+        // Cascades always settle the board, so the local check is exact.
+        if (!LegalSwapLocal(board, entry.move)) {
+            result.diverged_at = result.moves_played;
+            break;
+        }
+        const SimulationResult step =
+            SimulateFullChain(board, entry.move, scratch, SimulationEvents::Skip);
+        const std::size_t seat = static_cast<std::size_t>(
+            std::clamp(entry.player, 0, static_cast<int>(result.scores.size()) - 1));
+        result.scores[seat] += step.score;
+        result.moves_played += 1;
+    }
+
+    result.final_digest = BoardDigest(board);
+    result.digest_matches = replay.final_digest == 0 ||
+                            (result.diverged_at < 0 && replay.final_digest == result.final_digest);
+    if (board_out) {
+        *board_out = std::move(board);
+    }
+    result.elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}  // namespace match::core
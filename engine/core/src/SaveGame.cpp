@@ -0,0 +1,775 @@
+#include "match/core/SaveGame.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+#include "match/core/AllocTracker.hpp"
+
+namespace match::core {
+
+namespace {
+
+// Layout, all integers little-endian:
+//   "MSAV" u16 version u16 reserved i64 timestamp
+//   str mode, str save_name, u16 count + str players
+//   then sections of u32 tag, u32 byte length, body; unknown tags are skipped.
+// Strings are a u16 byte length followed by the bytes.
+constexpr std::uint8_t kMagic[4] = {'M', 'S', 'A', 'V'};
+
+constexpr std::uint32_t FourCC(char a, char b, char c, char d) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+}
+
+constexpr std::uint32_t kBoardSection = FourCC('B', 'O', 'R', 'D');
+constexpr std::uint32_t kRngSection = FourCC('R', 'N', 'G', ' ');
+constexpr std::uint32_t kSessionSection = FourCC('G', 'A', 'M', 'E');
+constexpr std::uint32_t kTournamentSection = FourCC('T', 'O', 'U', 'R');
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    void u8(std::uint8_t value) { out_.push_back(value); }
+    void u16(std::uint16_t value) {
+        out_.push_back(static_cast<std::uint8_t>(value));
+        out_.push_back(static_cast<std::uint8_t>(value >> 8));
+    }
+    void u32(std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            out_.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+    }
+    void i32(int value) { u32(static_cast<std::uint32_t>(value)); }
+    void i64(std::int64_t value) {
+        const auto bits = static_cast<std::uint64_t>(value);
+        for (int shift = 0; shift < 64; shift += 8) {
+            out_.push_back(static_cast<std::uint8_t>(bits >> shift));
+        }
+    }
+    void f32(float value) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+    void boolean(bool value) { u8(value ? 1 : 0); }
+    void str(const std::string& text) {
+        const std::size_t length = std::min<std::size_t>(text.size(), 0xFFFF);
+        u16(static_cast<std::uint16_t>(length));
+        out_.insert(out_.end(), text.begin(), text.begin() + static_cast<std::ptrdiff_t>(length));
+    }
+    void strings(const std::vector<std::string>& values) {
+        u16(static_cast<std::uint16_t>(std::min<std::size_t>(values.size(), 0xFFFF)));
+        for (std::size_t i = 0; i < values.size() && i < 0xFFFF; ++i) {
+            str(values[i]);
+        }
+    }
+    void ints(const std::vector<int>& values) {
+        u16(static_cast<std::uint16_t>(std::min<std::size_t>(values.size(), 0xFFFF)));
+        for (std::size_t i = 0; i < values.size() && i < 0xFFFF; ++i) {
+            i32(values[i]);
+        }
+    }
+
+    // Writes the tag and a length placeholder; endSection patches the length.
+    std::size_t beginSection(std::uint32_t tag) {
+        u32(tag);
+        u32(0);
+        return out_.size();
+    }
+    void endSection(std::size_t body_start) {
+        const auto length = static_cast<std::uint32_t>(out_.size() - body_start);
+        for (int i = 0; i < 4; ++i) {
+            out_[body_start - 4 + static_cast<std::size_t>(i)] =
+                static_cast<std::uint8_t>(length >> (8 * i));
+        }
+    }
+
+    std::vector<std::uint8_t>& bytes() { return out_; }
+
+private:
+    std::vector<std::uint8_t>& out_;
+};
+
+// Bounds-checked cursor. Any overrun clears ok() and makes every later read
+// return zero, so decoders check once at the end rather than per field.
+class ByteReader {
+public:
+    ByteReader(const std::uint8_t* data, std::size_t size) : cursor_(data), end_(data + size) {}
+
+    bool ok() const noexcept { return ok_; }
+    std::size_t remaining() const noexcept { return static_cast<std::size_t>(end_ - cursor_); }
+    void fail() noexcept { ok_ = false; }
+
+    const std::uint8_t* take(std::size_t count) {
+        if (!ok_ || remaining() < count) {
+            ok_ = false;
+            return nullptr;
+        }
+        const std::uint8_t* at = cursor_;
+        cursor_ += count;
+        return at;
+    }
+
+    std::uint8_t u8() {
+        const std::uint8_t* at = take(1);
+        return at ? at[0] : 0;
+    }
+    std::uint16_t u16() {
+        const std::uint8_t* at = take(2);
+        return at ? static_cast<std::uint16_t>(at[0] | (at[1] << 8)) : 0;
+    }
+    std::uint32_t u32() {
+        const std::uint8_t* at = take(4);
+        if (!at) {
+            return 0;
+        }
+        return static_cast<std::uint32_t>(at[0]) | (static_cast<std::uint32_t>(at[1]) << 8) |
+               (static_cast<std::uint32_t>(at[2]) << 16) | (static_cast<std::uint32_t>(at[3]) << 24);
+    }
+    int i32() { return static_cast<int>(u32()); }
+    std::int64_t i64() {
+        const std::uint8_t* at = take(8);
+        if (!at) {
+            return 0;
+        }
+        std::uint64_t bits = 0;
+        for (int i = 7; i >= 0; --i) {
+            bits = (bits << 8) | at[i];
+        }
+        return static_cast<std::int64_t>(bits);
+    }
+    float f32() {
+        const std::uint32_t bits = u32();
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    bool boolean() { return u8() != 0; }
+    std::string str() {
+        const std::uint16_t length = u16();
+        const std::uint8_t* at = take(length);
+        return at ? std::string(reinterpret_cast<const char*>(at), length) : std::string{};
+    }
+    void strings(std::vector<std::string>& values) {
+        const std::uint16_t count = u16();
+        values.clear();
+        for (std::uint16_t i = 0; i < count && ok_; ++i) {
+            values.push_back(str());
+        }
+    }
+    void ints(std::vector<int>& values) {
+        const std::uint16_t count = u16();
+        values.clear();
+        if (remaining() / 4 < count) {
+            fail();
+            return;
+        }
+        values.reserve(count);
+        for (std::uint16_t i = 0; i < count; ++i) {
+            values.push_back(i32());
+        }
+    }
+
+private:
+    const std::uint8_t* cursor_;
+    const std::uint8_t* end_;
+    bool ok_ = true;
+};
+
+void WriteBoard(ByteWriter& writer, const Board& board) {
+    const std::size_t body = writer.beginSection(kBoardSection);
+    writer.u16(static_cast<std::uint16_t>(board.cols()));
+    writer.u16(static_cast<std::uint16_t>(board.rows()));
+    writer.u8(static_cast<std::uint8_t>(board.tileTypes()));
+    writer.u8(static_cast<std::uint8_t>((board.bombsEnabled() ? 1u : 0u) |
+                                        (board.colorChainEnabled() ? 2u : 0u)));
+    // Row-major, independent of Board's storage order.
+    auto& bytes = writer.bytes();
+    const std::size_t tiles_at = bytes.size();
+    bytes.resize(tiles_at + static_cast<std::size_t>(board.cols()) * static_cast<std::size_t>(board.rows()));
+    std::uint8_t* tile = bytes.data() + tiles_at;
+    for (int r = 0; r < board.rows(); ++r) {
+        for (int c = 0; c < board.cols(); ++c) {
+            *tile++ = static_cast<std::uint8_t>(static_cast<std::int8_t>(board.get(c, r)));
+        }
+    }
+    writer.endSection(body);
+}
+
+bool ReadBoard(ByteReader& reader, Board& board) {
+    Board::Rules rules;
+    rules.cols = reader.u16();
+    rules.rows = reader.u16();
+    rules.tile_types = reader.u8();
+    const std::uint8_t flags = reader.u8();
+    rules.bombs_enabled = (flags & 1u) != 0;
+    rules.color_chain_enabled = (flags & 2u) != 0;
+    const std::uint8_t* tiles =
+        reader.take(static_cast<std::size_t>(rules.cols) * static_cast<std::size_t>(rules.rows));
+    if (!tiles || rules.cols <= 0 || rules.rows <= 0 || rules.tile_types <= 0) {
+        return false;
+    }
+    board = Board(rules, 0);
+    for (int r = 0; r < rules.rows; ++r) {
+        for (int c = 0; c < rules.cols; ++c) {
+            board.set(c, r, static_cast<std::int8_t>(*tiles++));
+        }
+    }
+    return true;
+}
+
+// The generator goes through its standard textual form, stored as words. A
+// different standard library may read the words as a different (but valid)
+// state; the board is still playable, only the refill sequence changes.
+void WriteRng(ByteWriter& writer, const std::mt19937& rng) {
+    std::ostringstream text;
+    text << rng;
+    std::istringstream words(text.str());
+    std::vector<std::uint32_t> state;
+    state.reserve(std::mt19937::state_size + 1);
+    unsigned long word = 0;
+    while (words >> word) {
+        state.push_back(static_cast<std::uint32_t>(word));
+    }
+    const std::size_t body = writer.beginSection(kRngSection);
+    writer.u16(static_cast<std::uint16_t>(state.size()));
+    for (std::uint32_t value : state) {
+        writer.u32(value);
+    }
+    writer.endSection(body);
+}
+
+bool ReadRng(ByteReader& reader, std::mt19937& rng) {
+    const std::uint16_t count = reader.u16();
+    if (count == 0 || reader.remaining() / 4 < count) {
+        return false;
+    }
+    std::string text;
+    text.reserve(static_cast<std::size_t>(count) * 11);
+    for (std::uint16_t i = 0; i < count; ++i) {
+        if (i != 0) {
+            text.push_back(' ');
+        }
+        text += std::to_string(reader.u32());
+    }
+    std::istringstream in(text);
+    std::mt19937 restored;
+    in >> restored;
+    if (in.fail()) {
+        return false;
+    }
+    rng = restored;
+    return true;
+}
+
+void WriteSession(ByteWriter& writer, const SaveSession& session) {
+    const std::size_t body = writer.beginSection(kSessionSection);
+    writer.ints(session.player_scores);
+    writer.ints(session.moves_left_per_player);
+    writer.i32(session.player_count);
+    writer.i32(session.active_player);
+    writer.i32(session.round_current);
+    writer.i32(session.round_total);
+    writer.i32(session.total_moves);
+    writer.i32(session.moves_per_round);
+    writer.str(session.turn_order);
+    writer.str(session.ai_difficulty);
+    writer.str(session.time_mode);
+    writer.boolean(session.bombs_enabled);
+    writer.boolean(session.color_blast_enabled);
+    writer.i32(session.blitz_turn_minutes);
+    writer.i32(session.blitz_between_seconds);
+    writer.f32(session.blitz_turn_total_ms);
+    writer.f32(session.blitz_turn_remaining_ms);
+    writer.f32(session.blitz_pre_turn_ms);
+    writer.boolean(session.blitz_pre_turn_active);
+    writer.boolean(session.blitz_turn_active);
+    writer.boolean(session.game_over);
+    writer.endSection(body);
+}
+
+void ReadSession(ByteReader& reader, SaveSession& session) {
+    reader.ints(session.player_scores);
+    reader.ints(session.moves_left_per_player);
+    session.player_count = reader.i32();
+    session.active_player = reader.i32();
+    session.round_current = reader.i32();
+    session.round_total = reader.i32();
+    session.total_moves = reader.i32();
+    session.moves_per_round = reader.i32();
+    session.turn_order = reader.str();
+    session.ai_difficulty = reader.str();
+    session.time_mode = reader.str();
+    session.bombs_enabled = reader.boolean();
+    session.color_blast_enabled = reader.boolean();
+    session.blitz_turn_minutes = reader.i32();
+    session.blitz_between_seconds = reader.i32();
+    session.blitz_turn_total_ms = reader.f32();
+    session.blitz_turn_remaining_ms = reader.f32();
+    session.blitz_pre_turn_ms = reader.f32();
+    session.blitz_pre_turn_active = reader.boolean();
+    session.blitz_turn_active = reader.boolean();
+    session.game_over = reader.boolean();
+}
+
+void WriteSettings(ByteWriter& writer, const SaveSettings& settings) {
+    writer.str(settings.mode);
+    writer.i32(settings.player_count);
+    writer.strings(settings.player_names);
+    writer.str(settings.turn_order);
+    writer.i32(settings.moves_per_round);
+    writer.i32(settings.total_rounds);
+    writer.boolean(settings.bombs_enabled);
+    writer.boolean(settings.color_blast_enabled);
+    writer.str(settings.time_mode);
+    writer.i32(settings.blitz_turn_minutes);
+    writer.i32(settings.blitz_between_seconds);
+    writer.str(settings.ai_difficulty);
+}
+
+void ReadSettings(ByteReader& reader, SaveSettings& settings) {
+    settings.mode = reader.str();
+    settings.player_count = reader.i32();
+    reader.strings(settings.player_names);
+    settings.turn_order = reader.str();
+    settings.moves_per_round = reader.i32();
+    settings.total_rounds = reader.i32();
+    settings.bombs_enabled = reader.boolean();
+    settings.color_blast_enabled = reader.boolean();
+    settings.time_mode = reader.str();
+    settings.blitz_turn_minutes = reader.i32();
+    settings.blitz_between_seconds = reader.i32();
+    settings.ai_difficulty = reader.str();
+}
+
+void WriteTournament(ByteWriter& writer, const SaveTournament& tournament) {
+    const std::size_t body = writer.beginSection(kTournamentSection);
+    writer.boolean(tournament.active);
+    writer.strings(tournament.players);
+    writer.u16(static_cast<std::uint16_t>(tournament.rounds.size()));
+    for (const auto& round : tournament.rounds) {
+        writer.u16(static_cast<std::uint16_t>(round.size()));
+        for (const auto& match : round) {
+            writer.i32(match.player_a);
+            writer.i32(match.player_b);
+            writer.i32(match.winner);
+        }
+    }
+    writer.i32(tournament.current_round);
+    writer.i32(tournament.current_match);
+    writer.i32(tournament.active_pair[0]);
+    writer.i32(tournament.active_pair[1]);
+    writer.boolean(tournament.awaiting_next_match);
+    writer.str(tournament.last_summary);
+    writer.boolean(tournament.base_settings.has_value());
+    if (tournament.base_settings) {
+        WriteSettings(writer, *tournament.base_settings);
+    }
+    writer.endSection(body);
+}
+
+void ReadTournament(ByteReader& reader, SaveTournament& tournament) {
+    tournament.active = reader.boolean();
+    reader.strings(tournament.players);
+    const std::uint16_t round_count = reader.u16();
+    tournament.rounds.clear();
+    for (std::uint16_t r = 0; r < round_count && reader.ok(); ++r) {
+        const std::uint16_t match_count = reader.u16();
+        if (reader.remaining() / 12 < match_count) {
+            reader.fail();
+            return;
+        }
+        auto& round = tournament.rounds.emplace_back();
+        round.resize(match_count);
+        for (auto& match : round) {
+            match.player_a = reader.i32();
+            match.player_b = reader.i32();
+            match.winner = reader.i32();
+        }
+    }
+    tournament.current_round = reader.i32();
+    tournament.current_match = reader.i32();
+    tournament.active_pair[0] = reader.i32();
+    tournament.active_pair[1] = reader.i32();
+    tournament.awaiting_next_match = reader.boolean();
+    tournament.last_summary = reader.str();
+    tournament.base_settings.reset();
+    if (reader.boolean()) {
+        ReadSettings(reader, tournament.base_settings.emplace());
+    }
+}
+
+bool Fail(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+SaveRead ReadHeader(ByteReader& reader, SaveHeader& header, std::string* error) {
+    reader.take(sizeof(kMagic));
+    header.version = reader.u16();
+    reader.u16();
+    if (reader.ok() && header.version > kSaveGameVersion) {
+        Fail(error, "save was written by a newer version");
+        return SaveRead::Invalid;
+    }
+    header.timestamp = reader.i64();
+    header.mode = reader.str();
+    header.save_name = reader.str();
+    reader.strings(header.players);
+    if (!reader.ok()) {
+        Fail(error, "truncated save header");
+        return SaveRead::Truncated;
+    }
+    return SaveRead::Ok;
+}
+
+bool DecodeBinary(const std::uint8_t* data, std::size_t size, SaveGame& out, std::string* error) {
+    ByteReader reader(data, size);
+    out = SaveGame{};
+    if (ReadHeader(reader, out.header, error) != SaveRead::Ok) {
+        return false;
+    }
+
+    bool has_board = false;
+    const std::uint8_t* rng_body = nullptr;
+    std::uint32_t rng_length = 0;
+    while (reader.remaining() > 0) {
+        const std::uint32_t tag = reader.u32();
+        const std::uint32_t length = reader.u32();
+        const std::uint8_t* body = reader.take(length);
+        if (!body) {
+            return Fail(error, "truncated save section");
+        }
+        ByteReader section(body, length);
+        switch (tag) {
+            case kBoardSection:
+                has_board = ReadBoard(section, out.board);
+                break;
+            case kRngSection:
+                // Applied once the board exists, whatever the section order.
+                rng_body = body;
+                rng_length = length;
+                continue;
+            case kSessionSection:
+                ReadSession(section, out.session);
+                break;
+            case kTournamentSection:
+                ReadTournament(section, out.tournament.emplace());
+                break;
+            default:
+                continue;
+        }
+        if (!section.ok()) {
+            return Fail(error, "corrupt save section");
+        }
+    }
+    if (!has_board) {
+        return Fail(error, "save has no board");
+    }
+
+    if (rng_body) {
+        ByteReader section(rng_body, rng_length);
+        out.has_rng = ReadRng(section, out.board.rng());
+    }
+    return true;
+}
+
+// Exception-free accessors for the version 1 JSON, which nlohmann's value()
+// would throw on when a field has an unexpected type.
+const Json* Field(const Json& object, const char* key) {
+    if (!object.is_object()) {
+        return nullptr;
+    }
+    auto it = object.find(key);
+    return it == object.end() ? nullptr : &(*it);
+}
+
+void ReadInt(const Json& object, const char* key, int& value) {
+    const Json* field = Field(object, key);
+    if (field && field->is_number()) {
+        value = field->get<int>();
+    }
+}
+
+void ReadFloat(const Json& object, const char* key, float& value) {
+    const Json* field = Field(object, key);
+    if (field && field->is_number()) {
+        value = field->get<float>();
+    }
+}
+
+void ReadBool(const Json& object, const char* key, bool& value) {
+    const Json* field = Field(object, key);
+    if (field && field->is_boolean()) {
+        value = field->get<bool>();
+    }
+}
+
+void ReadString(const Json& object, const char* key, std::string& value) {
+    const Json* field = Field(object, key);
+    if (field && field->is_string()) {
+        value = field->get<std::string>();
+    }
+}
+
+void ReadStrings(const Json& object, const char* key, std::vector<std::string>& values) {
+    const Json* field = Field(object, key);
+    if (!field || !field->is_array()) {
+        return;
+    }
+    values.clear();
+    for (const auto& entry : *field) {
+        values.push_back(entry.is_string() ? entry.get<std::string>() : std::string{});
+    }
+}
+
+void ReadInts(const Json& object, const char* key, std::vector<int>& values) {
+    const Json* field = Field(object, key);
+    if (!field || !field->is_array()) {
+        return;
+    }
+    values.clear();
+    for (const auto& entry : *field) {
+        values.push_back(entry.is_number() ? entry.get<int>() : 0);
+    }
+}
+
+}  // namespace
+
+void EncodeSaveGame(const SaveHeader& header,
+                    const Board& board,
+                    const SaveSession& session,
+                    const SaveTournament* tournament,
+                    std::vector<std::uint8_t>& out) {
+    MATCH_ALLOC_SCOPE(Save);
+    out.clear();
+    ByteWriter writer(out);
+    for (const std::uint8_t byte : kMagic) {
+        writer.u8(byte);
+    }
+    writer.u16(kSaveGameVersion);
+    writer.u16(0);
+    writer.i64(header.timestamp);
+    writer.str(header.mode);
+    writer.str(header.save_name);
+    writer.strings(header.players);
+
+    // Summary-relevant sections first, so DecodeSaveSummary can stop at the
+    // board and a file prefix is enough to list a slot.
+    WriteSession(writer, session);
+    if (tournament) {
+        WriteTournament(writer, *tournament);
+    }
+    WriteBoard(writer, board);
+    WriteRng(writer, board.rng());
+}
+
+bool IsBinarySave(const std::uint8_t* data, std::size_t size) noexcept {
+    return data && size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool DecodeSaveGame(const std::uint8_t* data, std::size_t size, SaveGame& out, std::string* error) {
+    MATCH_ALLOC_SCOPE(Save);
+    if (IsBinarySave(data, size)) {
+        return DecodeBinary(data, size, out, error);
+    }
+    if (!data || size == 0) {
+        return Fail(error, "empty save file");
+    }
+    Json json = Json::from_msgpack(data, data + size, true, false);
+    if (json.is_discarded() || !json.is_object()) {
+        return Fail(error, "unrecognised save format");
+    }
+    // SavePayload::FromJson throws on a mistyped "version", so the envelope
+    // goes through the same exception-free accessors as its contents.
+    SavePayload payload;
+    ReadInt(json, "version", payload.version);
+    ReadString(json, "mode", payload.mode);
+    if (const Json* meta = Field(json, "meta")) {
+        payload.meta = *meta;
+    }
+    if (const Json* data_json = Field(json, "data")) {
+        payload.data = *data_json;
+    }
+    if (!SaveGameFromPayload(payload, out)) {
+        return Fail(error, "save has no board");
+    }
+    return true;
+}
+
+bool DecodeSaveGame(const std::vector<std::uint8_t>& bytes, SaveGame& out, std::string* error) {
+    return DecodeSaveGame(bytes.data(), bytes.size(), out, error);
+}
+
+SaveRead DecodeSaveSummary(const std::uint8_t* data, std::size_t size, SaveGame& out, std::string* error) {
+    MATCH_ALLOC_SCOPE(Save);
+    if (!IsBinarySave(data, size)) {
+        return SaveRead::Unsupported;
+    }
+    ByteReader reader(data, size);
+    out = SaveGame{};
+    const SaveRead header = ReadHeader(reader, out.header, error);
+    if (header != SaveRead::Ok) {
+        return header;
+    }
+    while (true) {
+        const std::uint32_t tag = reader.u32();
+        const std::uint32_t length = reader.u32();
+        if (!reader.ok()) {
+            Fail(error, "truncated save section");
+            return SaveRead::Truncated;
+        }
+        if (tag == kBoardSection || tag == kRngSection) {
+            return SaveRead::Ok;
+        }
+        const std::uint8_t* body = reader.take(length);
+        if (!body) {
+            Fail(error, "truncated save section");
+            return SaveRead::Truncated;
+        }
+        ByteReader section(body, length);
+        if (tag == kSessionSection) {
+            ReadSession(section, out.session);
+        } else if (tag == kTournamentSection) {
+            ReadTournament(section, out.tournament.emplace());
+        }
+        if (!section.ok()) {
+            Fail(error, "corrupt save section");
+            return SaveRead::Invalid;
+        }
+    }
+}
+
+bool SaveGameFromPayload(const SavePayload& payload, SaveGame& out) {
+    out = SaveGame{};
+    const Json& meta = payload.meta;
+    const Json& data = payload.data;
+    out.header.version = static_cast<std::uint16_t>(payload.version);
+    out.header.mode = payload.mode;
+    if (const Json* timestamp = Field(meta, "timestamp"); timestamp && timestamp->is_number()) {
+        out.header.timestamp = timestamp->get<std::int64_t>();
+    }
+    ReadString(meta, "save_name", out.header.save_name);
+    ReadStrings(meta, "players", out.header.players);
+    ReadStrings(data, "player_names", out.header.players);
+
+    const Json* board_json = Field(data, "board");
+    if (!board_json || !board_json->is_object()) {
+        return false;
+    }
+    Board::Rules rules;
+    ReadInt(*board_json, "cols", rules.cols);
+    ReadInt(*board_json, "rows", rules.rows);
+    ReadInt(*board_json, "tile_types", rules.tile_types);
+    ReadBool(*board_json, "bombs_enabled", rules.bombs_enabled);
+    ReadBool(*board_json, "color_chain_enabled", rules.color_chain_enabled);
+    if (rules.cols <= 0 || rules.rows <= 0) {
+        return false;
+    }
+    out.board = Board(rules);
+    const Json* rows = Field(*board_json, "cells");
+    if (rows && rows->is_array()) {
+        for (int r = 0; r < rules.rows && r < static_cast<int>(rows->size()); ++r) {
+            const Json& row = (*rows)[static_cast<std::size_t>(r)];
+            if (!row.is_array()) {
+                continue;
+            }
+            for (int c = 0; c < rules.cols && c < static_cast<int>(row.size()); ++c) {
+                const Json& cell = row[static_cast<std::size_t>(c)];
+                if (cell.is_number()) {
+                    out.board.set(c, r, cell.get<int>());
+                }
+            }
+        }
+    }
+
+    SaveSession& session = out.session;
+    ReadInts(data, "player_scores", session.player_scores);
+    ReadInts(data, "moves_left_per_player", session.moves_left_per_player);
+    session.player_count = static_cast<int>(out.header.players.size());
+    ReadInt(data, "player_count", session.player_count);
+    ReadInt(data, "active_player", session.active_player);
+    ReadInt(data, "round_current", session.round_current);
+    ReadInt(data, "round_total", session.round_total);
+    ReadInt(data, "total_moves", session.total_moves);
+    ReadInt(data, "moves_per_round", session.moves_per_round);
+    ReadString(data, "turn_order", session.turn_order);
+    ReadString(data, "ai_difficulty", session.ai_difficulty);
+    ReadString(data, "time_mode", session.time_mode);
+    ReadBool(data, "bombs_enabled", session.bombs_enabled);
+    ReadBool(data, "color_blast_enabled", session.color_blast_enabled);
+    ReadInt(data, "blitz_turn_minutes", session.blitz_turn_minutes);
+    ReadInt(data, "blitz_between_seconds", session.blitz_between_seconds);
+    session.blitz_turn_total_ms = static_cast<float>(session.blitz_turn_minutes) * 60.0f * 1000.0f;
+    ReadFloat(data, "blitz_turn_total_ms", session.blitz_turn_total_ms);
+    session.blitz_turn_remaining_ms = session.blitz_turn_total_ms;
+    ReadFloat(data, "blitz_turn_remaining_ms", session.blitz_turn_remaining_ms);
+    ReadFloat(data, "blitz_pre_turn_ms", session.blitz_pre_turn_ms);
+    ReadBool(data, "blitz_pre_turn_active", session.blitz_pre_turn_active);
+    ReadBool(data, "blitz_turn_active", session.blitz_turn_active);
+    ReadBool(data, "game_over", session.game_over);
+
+    const Json* tour = Field(data, "tournament");
+    if (tour && tour->is_object()) {
+        SaveTournament& tournament = out.tournament.emplace();
+        tournament.active = payload.mode == "Tournament";
+        ReadBool(*tour, "active", tournament.active);
+        tournament.players = out.header.players;
+        ReadStrings(*tour, "players", tournament.players);
+        const Json* rounds = Field(*tour, "rounds");
+        if (rounds && rounds->is_array()) {
+            for (const auto& round_entry : *rounds) {
+                if (!round_entry.is_array()) {
+                    continue;
+                }
+                auto& round = tournament.rounds.emplace_back();
+                for (const auto& match_entry : round_entry) {
+                    if (!match_entry.is_object()) {
+                        continue;
+                    }
+                    SaveTournament::Match match;
+                    ReadInt(match_entry, "player_a", match.player_a);
+                    ReadInt(match_entry, "player_b", match.player_b);
+                    ReadInt(match_entry, "winner", match.winner);
+                    round.push_back(match);
+                }
+            }
+        }
+        ReadInt(*tour, "current_round", tournament.current_round);
+        ReadInt(*tour, "current_match", tournament.current_match);
+        const Json* pair = Field(*tour, "active_pair");
+        if (pair && pair->is_array() && pair->size() >= 2 && (*pair)[0].is_number() &&
+            (*pair)[1].is_number()) {
+            tournament.active_pair[0] = (*pair)[0].get<int>();
+            tournament.active_pair[1] = (*pair)[1].get<int>();
+        }
+        ReadBool(*tour, "awaiting_next_match", tournament.awaiting_next_match);
+        ReadString(*tour, "last_summary", tournament.last_summary);
+        const Json* base = Field(*tour, "base_settings");
+        if (base && base->is_object()) {
+            SaveSettings& settings = tournament.base_settings.emplace();
+            ReadString(*base, "mode", settings.mode);
+            ReadInt(*base, "player_count", settings.player_count);
+            ReadStrings(*base, "player_names", settings.player_names);
+            ReadString(*base, "turn_order", settings.turn_order);
+            ReadInt(*base, "moves_per_round", settings.moves_per_round);
+            ReadInt(*base, "total_rounds", settings.total_rounds);
+            ReadBool(*base, "bombs_enabled", settings.bombs_enabled);
+            ReadBool(*base, "color_blast_enabled", settings.color_blast_enabled);
+            ReadString(*base, "time_mode", settings.time_mode);
+            ReadInt(*base, "blitz_turn_minutes", settings.blitz_turn_minutes);
+            ReadInt(*base, "blitz_between_seconds", settings.blitz_between_seconds);
+            ReadString(*base, "ai_difficulty", settings.ai_difficulty);
+        }
+    }
+    return true;
+}
+
+}  // namespace match::core
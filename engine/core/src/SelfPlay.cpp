@@ -0,0 +1,81 @@
+#include "match/core/SelfPlay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+#include "match/core/LegalMoveIndex.hpp"
+#include "match/core/MatchSession.hpp"
+
+namespace match::core {
+
+std::optional<ai::BestMoveResult> ChooseSeatMove(const Board& board, const LegalMoveIndex& legal_moves,
+                                               const SeatPolicy* policy) {
+    if (policy != nullptr && policy->search) {
+        return ai::SearchBestMove(board, legal_moves, *policy->search);
+    }
+    return ai::BestMove(board, legal_moves);
+}
+
+SelfPlayGame PlaySelfPlayGame(const MatchRules& rules, const std::vector<SeatPolicy>& seats,
+                              std::uint32_t seed) {
+    const auto start = std::chrono::steady_clock::now();
+    SelfPlayGame game;
+    game.seed = seed;
+
+    MatchSession session(rules, seed);
+    SimulationResult result;
+    while (!session.gameOver()) {
+        const int seat = session.activePlayer();
+        const SeatPolicy* policy =
+            seat < static_cast<int>(seats.size()) ? &seats[static_cast<std::size_t>(seat)] : nullptr;
+        const auto choice = ChooseSeatMove(session.board(), session.legalMoves(), policy);
+        if (!choice || !session.play(choice->move, &result)) {
+            game.stalled = true;
+            break;
+        }
+        game.moves += 1;
+        game.chains += result.chains;
+        game.longest_chain = std::max(game.longest_chain, result.chains);
+        game.tiles_cleared += result.total_cleared;
+        game.bombs_triggered += result.bombs_triggered;
+        game.color_chains += result.color_chain_triggered ? 1 : 0;
+        game.best_move_score = std::max(game.best_move_score, result.score);
+    }
+    game.scores = session.scores();
+    game.rounds_played = session.turns().round - 1;
+
+    const auto best = std::max_element(game.scores.begin(), game.scores.end());
+    if (std::count(game.scores.begin(), game.scores.end(), *best) == 1) {
+        game.winner = static_cast<int>(best - game.scores.begin());
+    }
+    game.elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return game;
+}
+
+void RunSelfPlayBatch(const SelfPlayBatch& batch, const SelfPlaySink& sink, WorkerPool& pool) {
+    // Games that finish ahead of an earlier one wait here until it lands.
+    std::mutex mutex;
+    std::map<std::size_t, SelfPlayGame> finished;
+    std::size_t next_to_emit = 0;
+
+    pool.parallelFor(batch.games, [&](std::size_t index, unsigned) {
+        SelfPlayGame game = PlaySelfPlayGame(
+            batch.rules, batch.seats, batch.first_seed + static_cast<std::uint32_t>(index));
+        game.index = index;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.emplace(index, std::move(game));
+        for (auto it = finished.begin(); it != finished.end() && it->first == next_to_emit;
+             it = finished.erase(it)) {
+            if (sink) {
+                sink(it->second);
+            }
+            ++next_to_emit;
+        }
+    });
+}
+
+}  // namespace match::core
@@ -0,0 +1,123 @@
+#include "match/core/WorkerPool.hpp"
+
+namespace match::core {
+
+namespace {
+
+thread_local unsigned t_task_depth = 0;
+
+struct TaskScope {
+    TaskScope() noexcept { ++t_task_depth; }
+    ~TaskScope() { --t_task_depth; }
+};
+
+}  // namespace
+
+WorkerPool::WorkerPool(unsigned threads) {
+    threads_.reserve(threads);
+    for (unsigned slot = 0; slot < threads; ++slot) {
+        threads_.emplace_back([this, slot] { workerLoop(slot); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    // Lets a parallelFor that is still running finish first.
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(std::size_t count, const Task& task) {
+    if (count == 0) {
+        return;
+    }
+    const unsigned caller_slot = static_cast<unsigned>(threads_.size());
+    if (threads_.empty() || count == 1) {
+        TaskScope scope;
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i, caller_slot);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_ = 0;
+        busy_ = static_cast<unsigned>(threads_.size());
+        domain_ = CurrentAllocDomain();
+        ++generation_;
+    }
+    wake_.notify_all();
+    drain(caller_slot);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+}
+
+bool WorkerPool::InsideTask() noexcept {
+    return t_task_depth > 0;
+}
+
+unsigned WorkerPool::DefaultThreadCount() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void WorkerPool::workerLoop(unsigned slot) {
+    unsigned long long seen = 0;
+    while (true) {
+        AllocDomain domain = AllocDomain::Other;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            // A generation already published still counts this worker in
+            // busy_, so it is drained before a stop is honoured.
+            if (generation_ == seen) {
+                return;
+            }
+            seen = generation_;
+            domain = domain_;
+        }
+        {
+            AllocScope scope(domain);
+            drain(slot);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --busy_;
+        }
+        done_.notify_one();
+    }
+}
+
+void WorkerPool::drain(unsigned slot) {
+    while (true) {
+        std::size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next_ >= count_) {
+                return;
+            }
+            index = next_++;
+        }
+        TaskScope scope;
+        (*task_)(index, slot);
+    }
+}
+
+WorkerPool& SharedWorkerPool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+}  // namespace match::core
@@ -2,19 +2,33 @@
 
 #include <SDL2/SDL_mixer.h>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <initializer_list>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace match::platform {
 
+// Sound effects and the music stream are decoded on a loader thread started
+// by Initialize, intro first, so start-up only waits on the device. Playing a
+// sound that has not finished loading is silently skipped, except for the
+// intro, which PlayIntro waits for.
 class AudioSystem {
 public:
     AudioSystem() = default;
     ~AudioSystem();
 
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+
     bool Initialize();
     void Shutdown();
 
+    // Starts the loop now, or as soon as the music has been opened.
     void StartMusicLoop();
     void StopMusic();
 
@@ -31,31 +45,54 @@ public:
     void PlayCountdownFinal() const;
 
 private:
+    // Load order; the loader works through it front to back.
+    enum Sound : std::size_t {
+        kIntro,
+        kSwap,
+        kMatch,
+        kCombo,
+        kError,
+        kBomb,
+        kClick,
+        kNextTurn,
+        kNextRound,
+        kWin,
+        kCountdownTick,
+        kCountdownFinal,
+        kSoundCount
+    };
+
+    struct SoundSlot {
+        std::atomic<Mix_Chunk*> chunk{nullptr};
+        // Written before chunk is published.
+        float duration_ms = 0.0f;
+    };
+
     static void FreeChunk(Mix_Chunk*& chunk);
     static void Play(Mix_Chunk* chunk);
     float ChunkDurationMs(Mix_Chunk* chunk) const;
+    float PlaySound(Sound sound) const;
+    void LoaderLoop();
+    void StopLoader();
 
     Mix_Chunk* LoadChunk(const std::string& filename);
     Mix_Music* LoadMusic(std::initializer_list<const char*> candidates);
 
     bool initialized_ = false;
-    Mix_Chunk* swap_ = nullptr;
-    Mix_Chunk* match_ = nullptr;
-    Mix_Chunk* combo_ = nullptr;
-    Mix_Chunk* error_ = nullptr;
-    Mix_Chunk* bomb_ = nullptr;
-    Mix_Chunk* click_ = nullptr;
-    Mix_Chunk* next_turn_ = nullptr;
-    Mix_Chunk* next_round_ = nullptr;
-    Mix_Chunk* win_ = nullptr;
-    Mix_Chunk* intro_ = nullptr;
-    Mix_Chunk* countdown_tick_ = nullptr;
-    Mix_Chunk* countdown_final_ = nullptr;
+    std::array<SoundSlot, kSoundCount> sounds_{};
     Mix_Music* music_ = nullptr;
     bool music_playing_ = false;
+    bool music_requested_ = false;
     int sample_rate_ = 44100;
     int channels_ = 2;
     Uint16 format_ = MIX_DEFAULT_FORMAT;
+
+    // Guards the music fields and intro_done_ between the loader and callers.
+    mutable std::mutex mutex_;
+    mutable std::condition_variable intro_loaded_;
+    bool intro_done_ = false;
+    std::atomic<bool> stop_loading_{false};
+    std::thread loader_;
 };
 
 }  // namespace match::platform
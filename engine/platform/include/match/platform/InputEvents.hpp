@@ -1,7 +1,11 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
 
 namespace match::platform {
 
@@ -17,7 +21,9 @@ enum class InputEventType {
     ControllerButtonUp,
     ControllerAxisMotion,
     WindowRestored,
-    TextInput
+    TextInput,
+    // The renderer dropped the contents of its render-target textures.
+    RenderTargetsReset
 };
 
 enum class MouseButton { Left, Right, Middle, Unknown };
@@ -34,6 +40,8 @@ enum class KeyCode {
     D,
     Backspace,
     Enter,
+    F3,
+    F4,
     Unknown
 };
 
@@ -53,6 +61,27 @@ enum class ControllerButton {
 
 enum class ControllerAxis { LeftX, LeftY, Unknown };
 
+// UTF-8 bytes of a TextInput event, stored inline so an event never
+// allocates. SDL delivers at most 31 bytes per event.
+struct InputText {
+    static constexpr std::size_t kCapacity = 32;
+
+    std::array<char, kCapacity> bytes{};
+    std::uint8_t length = 0;
+
+    void assign(const char* text) noexcept {
+        const std::size_t n = text ? std::min(std::strlen(text), kCapacity - 1) : 0;
+        std::memcpy(bytes.data(), text ? text : "", n);
+        bytes[n] = '\0';
+        length = static_cast<std::uint8_t>(n);
+    }
+    bool empty() const noexcept { return length == 0; }
+    std::size_t size() const noexcept { return length; }
+    const char* begin() const noexcept { return bytes.data(); }
+    const char* end() const noexcept { return bytes.data() + length; }
+    std::string_view view() const noexcept { return {bytes.data(), length}; }
+};
+
 struct InputEvent {
     InputEventType type = InputEventType::Quit;
     int x = 0;
@@ -63,7 +92,68 @@ struct InputEvent {
     ControllerAxis controller_axis = ControllerAxis::Unknown;
     int wheel_y = 0;
     int axis_value = 0;
-    std::string text;
+    InputText text;
+    // SDL_GetTicks() time at which SDL queued the event.
+    std::uint32_t timestamp_ms = 0;
+};
+
+// Fixed-capacity buffer the platform layer fills once per frame and the main
+// loop reads in place. Consecutive mouse moves, and consecutive motion on the
+// same controller axis, collapse into the latest one, which keeps the first
+// one's timestamp so latency is measured from the earliest input.
+class InputQueue {
+public:
+    static constexpr std::size_t kCapacity = 256;
+
+    void clear() noexcept { count_ = 0; }
+    bool full() const noexcept { return count_ == kCapacity; }
+    bool empty() const noexcept { return count_ == 0; }
+    std::size_t size() const noexcept { return count_; }
+
+    // Returns false, dropping nothing already queued, when the buffer is full
+    // and evt could not be merged.
+    bool push(const InputEvent& evt) noexcept {
+        if (count_ > 0 && Coalesces(events_[count_ - 1], evt)) {
+            InputEvent& merged = events_[count_ - 1];
+            const std::uint32_t first_timestamp = merged.timestamp_ms;
+            merged = evt;
+            merged.timestamp_ms = first_timestamp;
+            return true;
+        }
+        if (full()) {
+            return false;
+        }
+        events_[count_++] = evt;
+        return true;
+    }
+
+    const InputEvent* begin() const noexcept { return events_.data(); }
+    const InputEvent* end() const noexcept { return events_.data() + count_; }
+    const InputEvent& operator[](std::size_t index) const noexcept { return events_[index]; }
+
+    // Earliest timestamp in the buffer, or 0 when it is empty.
+    std::uint32_t oldestTimestamp() const noexcept {
+        std::uint32_t oldest = 0;
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (oldest == 0 || events_[i].timestamp_ms < oldest) {
+                oldest = events_[i].timestamp_ms;
+            }
+        }
+        return oldest;
+    }
+
+private:
+    static bool Coalesces(const InputEvent& previous, const InputEvent& next) noexcept {
+        if (previous.type != next.type) {
+            return false;
+        }
+        return next.type == InputEventType::MouseMove ||
+               (next.type == InputEventType::ControllerAxisMotion &&
+                previous.controller_axis == next.controller_axis);
+    }
+
+    std::array<InputEvent, kCapacity> events_{};
+    std::size_t count_ = 0;
 };
 
 }  // namespace match::platform
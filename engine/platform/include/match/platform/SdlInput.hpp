@@ -15,7 +15,12 @@ public:
 
     bool Initialize();
     void Shutdown();
-    std::vector<InputEvent> Poll();
+    // Drains SDL's queue into a buffer owned by this object; the reference
+    // stays valid until the next Poll.
+    const InputQueue& Poll();
+    // Blocks until an event is queued or timeout_ms passes, leaving the event
+    // for Poll. Returns whether one arrived.
+    bool WaitForEvent(Uint32 timeout_ms);
     void RumbleControllers(float strength, Uint32 duration_ms);
 
 private:
@@ -30,6 +35,7 @@ private:
 
     bool initialized_ = false;
     std::vector<ControllerEntry> controllers_;
+    InputQueue queue_;
 };
 
 }  // namespace match::platform
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace match::platform {
@@ -13,27 +20,84 @@ struct SaveSlotInfo {
     std::time_t modified_time = 0;
 };
 
+struct SaveCompletion {
+    std::string slot_name;
+    std::filesystem::path path;
+    std::uint64_t ticket = 0;
+    bool ok = false;
+};
+
+// Fills a save buffer on the save thread. The callable owns a snapshot of
+// whatever it serializes; it must not touch live game state.
+using SaveSerializer = std::function<void(std::vector<std::uint8_t>& out)>;
+
+// Every write goes to a temporary file that is flushed to disk and renamed
+// over the target, so a crash leaves either the old save or the new one.
 class SdlSaveService {
 public:
     explicit SdlSaveService(std::filesystem::path root);
+    ~SdlSaveService();
+
+    SdlSaveService(const SdlSaveService&) = delete;
+    SdlSaveService& operator=(const SdlSaveService&) = delete;
 
     bool Initialize();
+    // Points later calls at another directory. Queued saves keep the path
+    // they were queued with.
+    void SetRoot(std::filesystem::path root);
     std::vector<SaveSlotInfo> ListSlots() const;
     bool Save(const std::string& slot_name, const std::vector<std::uint8_t>& payload);
     bool Load(const std::string& slot_name, std::vector<std::uint8_t>& out_payload) const;
+    // Reads at most max_bytes from the start of the slot, without waiting for
+    // queued writes; enough for a summary when the format puts it first.
+    bool LoadPrefix(const std::string& slot_name,
+                    std::size_t max_bytes,
+                    std::vector<std::uint8_t>& out_payload) const;
     bool Delete(const std::string& slot_name);
 
     bool AutoSave(const std::vector<std::uint8_t>& payload);
     bool LoadAutoSave(std::vector<std::uint8_t>& out_payload) const;
 
+    // Serializes and writes on the save thread. A request for a slot that is
+    // still waiting replaces the waiting one, so a burst of autosaves costs a
+    // single write. Returns the ticket its SaveCompletion will carry.
+    std::uint64_t QueueSave(const std::string& slot_name, SaveSerializer serialize);
+    // Takes the next finished queued save without blocking.
+    bool PollCompletion(SaveCompletion& out);
+    // Whether queued saves are waiting, being written, or unreported.
+    bool Busy() const;
+    // Blocks until every queued save has reached the disk.
+    void WaitIdle() const;
+
     const std::filesystem::path& root() const { return root_; }
 
 private:
+    struct Job {
+        std::string slot_name;
+        std::filesystem::path path;
+        std::filesystem::path root;
+        SaveSerializer serialize;
+        std::uint64_t ticket = 0;
+    };
+
     std::filesystem::path ResolvePath(const std::string& slot_name) const;
     bool EnsureRootExists() const;
+    void StopWriter();
+    void WriterLoop();
 
     std::filesystem::path root_;
     std::filesystem::path autosave_path_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    mutable std::condition_variable idle_;
+    std::deque<Job> jobs_;
+    std::deque<SaveCompletion> completions_;
+    std::uint64_t next_ticket_ = 1;
+    bool writing_ = false;
+    bool stopping_ = false;
+    // Started by the first QueueSave and declared last, after the state it uses.
+    std::thread writer_;
 };
 
 }  // namespace match::platform
@@ -6,6 +6,25 @@
 
 namespace match::platform {
 
+namespace {
+
+constexpr std::array<const char*, 12> kSoundFiles{
+    "intro.wav",
+    "swap.wav",
+    "match.wav",
+    "combo.wav",
+    "error.wav",
+    "bomb.wav",
+    "click.wav",
+    "next_turn.wav",
+    "next_round.wav",
+    "win.wav",
+    "countdown.wav",
+    "countdown_end.wav",
+};
+
+}  // namespace
+
 AudioSystem::~AudioSystem() {
     Shutdown();
 }
@@ -28,20 +47,11 @@ bool AudioSystem::Initialize() {
     Mix_Volume(-1, static_cast<int>(MIX_MAX_VOLUME * 0.8f));
     Mix_VolumeMusic(static_cast<int>(MIX_MAX_VOLUME * 0.6f));
 
-    swap_ = LoadChunk("swap.wav");
-    match_ = LoadChunk("match.wav");
-    combo_ = LoadChunk("combo.wav");
-    error_ = LoadChunk("error.wav");
-    bomb_ = LoadChunk("bomb.wav");
-    click_ = LoadChunk("click.wav");
-    next_turn_ = LoadChunk("next_turn.wav");
-    next_round_ = LoadChunk("next_round.wav");
-    win_ = LoadChunk("win.wav");
-    intro_ = LoadChunk("intro.wav");
-    countdown_tick_ = LoadChunk("countdown.wav");
-    countdown_final_ = LoadChunk("countdown_end.wav");
-    music_ = LoadMusic({"bg_loop.ogg", "Vovkinshteyn.wav"});
+    stop_loading_ = false;
+    intro_done_ = false;
+    music_requested_ = false;
     music_playing_ = false;
+    loader_ = std::thread([this] { LoaderLoop(); });
 
     initialized_ = true;
     return true;
@@ -51,19 +61,13 @@ void AudioSystem::Shutdown() {
     if (!initialized_) {
         return;
     }
+    StopLoader();
     StopMusic();
-    FreeChunk(swap_);
-    FreeChunk(match_);
-    FreeChunk(combo_);
-    FreeChunk(error_);
-    FreeChunk(bomb_);
-    FreeChunk(click_);
-    FreeChunk(next_turn_);
-    FreeChunk(next_round_);
-    FreeChunk(win_);
-    FreeChunk(intro_);
-    FreeChunk(countdown_tick_);
-    FreeChunk(countdown_final_);
+    for (auto& slot : sounds_) {
+        Mix_Chunk* chunk = slot.chunk.exchange(nullptr);
+        FreeChunk(chunk);
+        slot.duration_ms = 0.0f;
+    }
     if (music_) {
         Mix_FreeMusic(music_);
         music_ = nullptr;
@@ -73,60 +77,113 @@ void AudioSystem::Shutdown() {
     initialized_ = false;
 }
 
+void AudioSystem::StopLoader() {
+    stop_loading_ = true;
+    if (loader_.joinable()) {
+        loader_.join();
+    }
+}
+
+void AudioSystem::LoaderLoop() {
+    static_assert(kSoundFiles.size() == kSoundCount, "one file per Sound");
+    for (std::size_t i = 0; i < kSoundCount; ++i) {
+        if (stop_loading_) {
+            break;
+        }
+        Mix_Chunk* chunk = LoadChunk(kSoundFiles[i]);
+        sounds_[i].duration_ms = ChunkDurationMs(chunk);
+        sounds_[i].chunk.store(chunk, std::memory_order_release);
+        if (i == kIntro) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            intro_done_ = true;
+            intro_loaded_.notify_all();
+        }
+    }
+    {
+        // PlayIntro must not wait forever if loading was cut short.
+        std::lock_guard<std::mutex> lock(mutex_);
+        intro_done_ = true;
+        intro_loaded_.notify_all();
+    }
+    if (stop_loading_) {
+        return;
+    }
+
+    // Mix_Music decodes as it plays; opening it only parses the header, but
+    // that still touches the disk, so it happens here too.
+    Mix_Music* music = LoadMusic({"bg_loop.ogg", "Vovkinshteyn.wav"});
+    std::lock_guard<std::mutex> lock(mutex_);
+    music_ = music;
+    if (music_ && music_requested_ && !music_playing_ && Mix_PlayMusic(music_, -1) == 0) {
+        music_playing_ = true;
+    }
+}
+
+float AudioSystem::PlaySound(Sound sound) const {
+    const SoundSlot& slot = sounds_[sound];
+    Mix_Chunk* chunk = slot.chunk.load(std::memory_order_acquire);
+    Play(chunk);
+    return chunk ? slot.duration_ms : 0.0f;
+}
+
 void AudioSystem::PlaySwap() const {
-    Play(swap_);
+    PlaySound(kSwap);
 }
 
 void AudioSystem::PlayMatch(bool cascade) const {
-    if (cascade) {
-        Play(combo_);
-    } else {
-        Play(match_);
-    }
+    PlaySound(cascade ? kCombo : kMatch);
 }
 
 void AudioSystem::PlayBomb() const {
-    Play(bomb_);
+    PlaySound(kBomb);
 }
 
 void AudioSystem::PlayError() const {
-    Play(error_);
+    PlaySound(kError);
 }
 
 void AudioSystem::PlayClick() const {
-    Play(click_);
+    PlaySound(kClick);
 }
 
 float AudioSystem::PlayNextTurn() const {
-    Play(next_turn_);
-    return ChunkDurationMs(next_turn_);
+    return PlaySound(kNextTurn);
 }
 
 float AudioSystem::PlayNextRound() const {
-    Play(next_round_);
-    return ChunkDurationMs(next_round_);
+    return PlaySound(kNextRound);
 }
 
 float AudioSystem::PlayWin() const {
-    Play(win_);
-    return ChunkDurationMs(win_);
+    return PlaySound(kWin);
 }
 
 float AudioSystem::PlayIntro() const {
-    Play(intro_);
-    return ChunkDurationMs(intro_);
+    if (!initialized_) {
+        return 0.0f;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        intro_loaded_.wait(lock, [this] { return intro_done_; });
+    }
+    return PlaySound(kIntro);
 }
 
 void AudioSystem::PlayCountdownTick() const {
-    Play(countdown_tick_);
+    PlaySound(kCountdownTick);
 }
 
 void AudioSystem::PlayCountdownFinal() const {
-    Play(countdown_final_);
+    PlaySound(kCountdownFinal);
 }
 
 void AudioSystem::StartMusicLoop() {
-    if (!initialized_ || music_playing_ || !music_) {
+    if (!initialized_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    music_requested_ = true;
+    if (music_playing_ || !music_) {
         return;
     }
     if (Mix_PlayMusic(music_, -1) == 0) {
@@ -135,7 +192,12 @@ void AudioSystem::StartMusicLoop() {
 }
 
 void AudioSystem::StopMusic() {
-    if (!initialized_ || !music_playing_) {
+    if (!initialized_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    music_requested_ = false;
+    if (!music_playing_) {
         return;
     }
     Mix_HaltMusic();
@@ -157,20 +219,19 @@ void AudioSystem::Play(Mix_Chunk* chunk) {
 }
 
 Mix_Chunk* AudioSystem::LoadChunk(const std::string& filename) {
-    std::filesystem::path path = match::app::AssetPath(filename);
-    if (!match::app::FileExists(path)) {
-        return nullptr;
-    }
-    return Mix_LoadWAV(path.string().c_str());
+    SDL_RWops* stream = match::app::OpenAsset(filename);
+    return stream ? Mix_LoadWAV_RW(stream, 1) : nullptr;
 }
 
 Mix_Music* AudioSystem::LoadMusic(std::initializer_list<const char*> candidates) {
     for (const char* name : candidates) {
-        std::filesystem::path path = match::app::AssetPath(name);
-        if (!match::app::FileExists(path)) {
+        SDL_RWops* stream = match::app::OpenAsset(name);
+        if (!stream) {
             continue;
         }
-        Mix_Music* music = Mix_LoadMUS(path.string().c_str());
+        // Music streams while it plays; with freesrc the stream closes in
+        // Mix_FreeMusic, and packed bytes stay mapped for the whole run.
+        Mix_Music* music = Mix_LoadMUS_RW(stream, 1);
         if (music) {
             return music;
         }
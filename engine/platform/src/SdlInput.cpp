@@ -46,6 +46,10 @@ KeyCode ToKey(SDL_Keycode key) {
         case SDLK_RETURN:
         case SDLK_KP_ENTER:
             return KeyCode::Enter;
+        case SDLK_F3:
+            return KeyCode::F3;
+        case SDLK_F4:
+            return KeyCode::F4;
         default:
             return KeyCode::Unknown;
     }
@@ -164,71 +168,75 @@ void SdlInput::CloseController(SDL_JoystickID instance_id) {
     controllers_.erase(it);
 }
 
-std::vector<InputEvent> SdlInput::Poll() {
-    std::vector<InputEvent> events;
+const InputQueue& SdlInput::Poll() {
+    queue_.clear();
     SDL_Event sdl_event;
-    while (SDL_PollEvent(&sdl_event)) {
+    // Anything that does not fit stays in SDL's queue for the next frame.
+    while (!queue_.full() && SDL_PollEvent(&sdl_event)) {
         InputEvent evt;
+        evt.timestamp_ms = sdl_event.common.timestamp;
         switch (sdl_event.type) {
             case SDL_QUIT:
                 evt.type = InputEventType::Quit;
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_MOUSEMOTION:
                 evt.type = InputEventType::MouseMove;
                 evt.x = sdl_event.motion.x;
                 evt.y = sdl_event.motion.y;
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_MOUSEBUTTONDOWN:
                 evt.type = InputEventType::MouseButtonDown;
                 evt.x = sdl_event.button.x;
                 evt.y = sdl_event.button.y;
                 evt.mouse_button = ToMouseButton(sdl_event.button.button);
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_MOUSEBUTTONUP:
                 evt.type = InputEventType::MouseButtonUp;
                 evt.x = sdl_event.button.x;
                 evt.y = sdl_event.button.y;
                 evt.mouse_button = ToMouseButton(sdl_event.button.button);
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_MOUSEWHEEL:
                 evt.type = InputEventType::MouseWheel;
                 evt.wheel_y = sdl_event.wheel.y;
-                events.push_back(evt);
+                // Wheel events carry no position before SDL 2.26.
+                SDL_GetMouseState(&evt.x, &evt.y);
+                queue_.push(evt);
                 break;
             case SDL_KEYDOWN:
                 evt.type = InputEventType::KeyDown;
                 evt.key = ToKey(sdl_event.key.keysym.sym);
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_KEYUP:
                 evt.type = InputEventType::KeyUp;
                 evt.key = ToKey(sdl_event.key.keysym.sym);
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
             case SDL_CONTROLLERBUTTONDOWN:
                 evt.type = InputEventType::ControllerButtonDown;
                 evt.controller_button = ToControllerButton(sdl_event.cbutton.button);
-                events.push_back(evt);
+                queue_.push(evt);
                 break;
         case SDL_CONTROLLERBUTTONUP:
             evt.type = InputEventType::ControllerButtonUp;
             evt.controller_button = ToControllerButton(sdl_event.cbutton.button);
-            events.push_back(evt);
+            queue_.push(evt);
             break;
         case SDL_CONTROLLERAXISMOTION:
             evt.type = InputEventType::ControllerAxisMotion;
             evt.controller_axis = ToControllerAxis(sdl_event.caxis.axis);
             evt.axis_value = sdl_event.caxis.value;
-            events.push_back(evt);
+            queue_.push(evt);
             break;
         case SDL_TEXTINPUT:
             evt.type = InputEventType::TextInput;
-            evt.text = sdl_event.text.text ? sdl_event.text.text : "";
-            events.push_back(evt);
+            evt.text.assign(sdl_event.text.text);
+            queue_.push(evt);
             break;
         case SDL_CONTROLLERDEVICEADDED:
             OpenController(sdl_event.cdevice.which);
@@ -239,14 +247,23 @@ std::vector<InputEvent> SdlInput::Poll() {
             case SDL_WINDOWEVENT:
                 if (sdl_event.window.event == SDL_WINDOWEVENT_RESTORED) {
                     evt.type = InputEventType::WindowRestored;
-                    events.push_back(evt);
+                    queue_.push(evt);
                 }
                 break;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                evt.type = InputEventType::RenderTargetsReset;
+                queue_.push(evt);
+                break;
             default:
                 break;
         }
     }
-    return events;
+    return queue_;
+}
+
+bool SdlInput::WaitForEvent(Uint32 timeout_ms) {
+    return SDL_WaitEventTimeout(nullptr, static_cast<int>(timeout_ms)) == 1;
 }
 
 void SdlInput::RumbleControllers(float strength, Uint32 duration_ms) {
@@ -2,8 +2,24 @@
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace match::platform {
 
 namespace {
@@ -21,6 +37,100 @@ std::filesystem::path NormalizeFilename(const std::string& name) {
     return path.filename();
 }
 
+bool EnsureDirectory(const std::filesystem::path& dir) {
+    std::error_code ec;
+    if (std::filesystem::exists(dir, ec)) {
+        return true;
+    }
+    return std::filesystem::create_directories(dir, ec);
+}
+
+std::FILE* OpenForWrite(const std::filesystem::path& path) {
+#ifdef _WIN32
+    return _wfopen(path.c_str(), L"wb");
+#else
+    return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+bool SyncFile(std::FILE* file) {
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Replaces to with from. On Windows std::filesystem::rename does not ask
+// MoveFileEx for write-through, so it is called directly to make the rename
+// durable before it returns.
+bool MoveIntoPlace(const std::filesystem::path& from, const std::filesystem::path& to) {
+#ifdef _WIN32
+    return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    return !ec;
+#endif
+}
+
+// Makes the rename itself durable. Windows has no directory handle to sync;
+// MoveIntoPlace's write-through move covers it there.
+void SyncDirectory(const std::filesystem::path& dir) {
+#ifndef _WIN32
+    int fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)dir;
+#endif
+}
+
+// Writes next to the target, syncs, then renames over it.
+bool WriteFileAtomically(const std::filesystem::path& path, const std::vector<std::uint8_t>& payload) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::FILE* file = OpenForWrite(temp);
+    if (!file) {
+        return false;
+    }
+    bool ok = payload.empty() ||
+              std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    ok = std::fflush(file) == 0 && ok;
+    ok = SyncFile(file) && ok;
+    ok = std::fclose(file) == 0 && ok;
+    ok = ok && MoveIntoPlace(temp, path);
+    if (!ok) {
+        std::error_code ec;
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    SyncDirectory(path.parent_path());
+    return true;
+}
+
+bool ReadFile(const std::filesystem::path& path,
+              std::vector<std::uint8_t>& out_payload,
+              std::size_t max_bytes = static_cast<std::size_t>(-1)) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    if (size > 0 && static_cast<std::size_t>(size) > max_bytes) {
+        size = static_cast<std::streamsize>(max_bytes);
+    }
+    out_payload.resize(static_cast<std::size_t>(size));
+    if (size > 0) {
+        in.read(reinterpret_cast<char*>(out_payload.data()), size);
+    }
+    return in.good();
+}
+
 }  // namespace
 
 SdlSaveService::SdlSaveService(std::filesystem::path root)
@@ -28,16 +138,21 @@ SdlSaveService::SdlSaveService(std::filesystem::path root)
     autosave_path_ = root_ / "autosave.bin";
 }
 
+SdlSaveService::~SdlSaveService() {
+    StopWriter();
+}
+
 bool SdlSaveService::Initialize() {
     return EnsureRootExists();
 }
 
+void SdlSaveService::SetRoot(std::filesystem::path root) {
+    root_ = root.empty() ? DefaultSaveRoot() : std::move(root);
+    autosave_path_ = root_ / "autosave.bin";
+}
+
 bool SdlSaveService::EnsureRootExists() const {
-    std::error_code ec;
-    if (std::filesystem::exists(root_)) {
-        return true;
-    }
-    return std::filesystem::create_directories(root_, ec);
+    return EnsureDirectory(root_);
 }
 
 std::filesystem::path SdlSaveService::ResolvePath(const std::string& slot_name) const {
@@ -56,7 +171,7 @@ std::vector<SaveSlotInfo> SdlSaveService::ListSlots() const {
             continue;
         }
         auto path = entry.path();
-        if (path.filename() == autosave_path_.filename()) {
+        if (path.filename() == autosave_path_.filename() || path.extension() == ".tmp") {
             continue;
         }
         SaveSlotInfo info;
@@ -80,33 +195,23 @@ bool SdlSaveService::Save(const std::string& slot_name, const std::vector<std::u
     if (!EnsureRootExists()) {
         return false;
     }
-    std::filesystem::path path = ResolvePath(slot_name);
-    std::ofstream out(path, std::ios::binary | std::ios::trunc);
-    if (!out) {
-        return false;
-    }
-    out.write(reinterpret_cast<const char*>(payload.data()),
-              static_cast<std::streamsize>(payload.size()));
-    return out.good();
+    return WriteFileAtomically(ResolvePath(slot_name), payload);
 }
 
 bool SdlSaveService::Load(const std::string& slot_name, std::vector<std::uint8_t>& out_payload) const {
-    std::filesystem::path path = ResolvePath(slot_name);
-    std::ifstream in(path, std::ios::binary);
-    if (!in) {
-        return false;
-    }
-    in.seekg(0, std::ios::end);
-    std::streamsize size = in.tellg();
-    in.seekg(0, std::ios::beg);
-    out_payload.resize(static_cast<std::size_t>(size));
-    if (size > 0) {
-        in.read(reinterpret_cast<char*>(out_payload.data()), size);
-    }
-    return in.good();
+    // A queued write to this slot would otherwise land after the read.
+    WaitIdle();
+    return ReadFile(ResolvePath(slot_name), out_payload);
+}
+
+bool SdlSaveService::LoadPrefix(const std::string& slot_name,
+                                std::size_t max_bytes,
+                                std::vector<std::uint8_t>& out_payload) const {
+    return ReadFile(ResolvePath(slot_name), out_payload, max_bytes);
 }
 
 bool SdlSaveService::Delete(const std::string& slot_name) {
+    WaitIdle();
     std::filesystem::path path = ResolvePath(slot_name);
     std::error_code ec;
     return std::filesystem::remove(path, ec);
@@ -116,28 +221,96 @@ bool SdlSaveService::AutoSave(const std::vector<std::uint8_t>& payload) {
     if (!EnsureRootExists()) {
         return false;
     }
-    std::ofstream out(autosave_path_, std::ios::binary | std::ios::trunc);
-    if (!out) {
-        return false;
-    }
-    out.write(reinterpret_cast<const char*>(payload.data()),
-              static_cast<std::streamsize>(payload.size()));
-    return out.good();
+    return WriteFileAtomically(autosave_path_, payload);
 }
 
 bool SdlSaveService::LoadAutoSave(std::vector<std::uint8_t>& out_payload) const {
-    std::ifstream in(autosave_path_, std::ios::binary);
-    if (!in) {
+    return ReadFile(autosave_path_, out_payload);
+}
+
+std::uint64_t SdlSaveService::QueueSave(const std::string& slot_name, SaveSerializer serialize) {
+    Job job;
+    job.slot_name = slot_name;
+    job.path = ResolvePath(slot_name);
+    job.root = root_;
+    job.serialize = std::move(serialize);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    job.ticket = next_ticket_++;
+    const std::uint64_t ticket = job.ticket;
+    auto waiting = std::find_if(jobs_.begin(), jobs_.end(),
+                                [&](const Job& queued) { return queued.path == job.path; });
+    if (waiting != jobs_.end()) {
+        *waiting = std::move(job);
+    } else {
+        jobs_.push_back(std::move(job));
+    }
+    if (!writer_.joinable()) {
+        writer_ = std::thread([this] { WriterLoop(); });
+    }
+    wake_.notify_one();
+    return ticket;
+}
+
+bool SdlSaveService::PollCompletion(SaveCompletion& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completions_.empty()) {
         return false;
     }
-    in.seekg(0, std::ios::end);
-    std::streamsize size = in.tellg();
-    in.seekg(0, std::ios::beg);
-    out_payload.resize(static_cast<std::size_t>(size));
-    if (size > 0) {
-        in.read(reinterpret_cast<char*>(out_payload.data()), size);
+    out = std::move(completions_.front());
+    completions_.pop_front();
+    return true;
+}
+
+bool SdlSaveService::Busy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writing_ || !jobs_.empty() || !completions_.empty();
+}
+
+void SdlSaveService::WaitIdle() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !writing_ && jobs_.empty(); });
+}
+
+void SdlSaveService::StopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void SdlSaveService::WriterLoop() {
+    std::vector<std::uint8_t> buffer;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // Drains the queue before honouring stopping_, so saves queued
+            // just before exit still reach the disk.
+            wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            writing_ = true;
+        }
+
+        buffer.clear();
+        if (job.serialize) {
+            job.serialize(buffer);
+        }
+        const bool ok = EnsureDirectory(job.root) && WriteFileAtomically(job.path, buffer);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_ = false;
+        completions_.push_back({std::move(job.slot_name), std::move(job.path), job.ticket, ok});
+        idle_.notify_all();
     }
-    return in.good();
 }
 
 }  // namespace match::platform
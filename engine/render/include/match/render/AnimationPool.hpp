@@ -0,0 +1,124 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "match/core/Board.hpp"
+
+namespace match::render {
+
+struct Color {
+    Uint8 r{255};
+    Uint8 g{255};
+    Uint8 b{255};
+    Uint8 a{255};
+};
+
+// Description of one tween, as built by the Make*Animation helpers. The pool
+// copies it into its own arrays; the struct itself is never stored.
+struct Animation {
+    enum class Type { Swap, Pop, Fall, Spawn };
+    static constexpr std::size_t kTypeCount = 4;
+
+    Type type = Type::Pop;
+    float duration_ms = 0.0f;
+    float delay_ms = 0.0f;
+    float elapsed_ms = 0.0f;
+    float size_start = 1.0f;
+    float size_end = 1.0f;
+    float alpha_start = 255.0f;
+    float alpha_end = 255.0f;
+    float start_x = 0.0f;
+    float start_y = 0.0f;
+    float end_x = 0.0f;
+    float end_y = 0.0f;
+    Color color{};
+    std::optional<match::core::Cell> reveal_cell;
+
+    bool started() const;
+    bool finished() const;
+    float progress() const;
+    float ease() const;
+};
+
+// One flag per board cell, column-major like the board, marking tiles that an
+// animation draws in place of the board. Cells outside the size given to
+// reset() are ignored.
+class HiddenCells {
+public:
+    void reset(int cols, int rows);
+    void clear() noexcept;
+
+    void insert(const match::core::Cell& cell) noexcept;
+    void erase(const match::core::Cell& cell) noexcept;
+    bool contains(const match::core::Cell& cell) const noexcept;
+
+    bool empty() const noexcept { return count_ == 0; }
+    std::size_t size() const noexcept { return count_; }
+    int cols() const noexcept { return cols_; }
+    int rows() const noexcept { return rows_; }
+
+private:
+    bool inRange(const match::core::Cell& cell) const noexcept {
+        return cell.col >= 0 && cell.col < cols_ && cell.row >= 0 && cell.row < rows_;
+    }
+    std::size_t indexOf(const match::core::Cell& cell) const noexcept {
+        return static_cast<std::size_t>(cell.col) * static_cast<std::size_t>(rows_) +
+               static_cast<std::size_t>(cell.row);
+    }
+
+    std::vector<std::uint8_t> flags_;
+    int cols_ = 0;
+    int rows_ = 0;
+    std::size_t count_ = 0;
+};
+
+// In-flight tweens kept as parallel arrays, one group per Animation::Type, so
+// a frame's update and draw are straight loops over floats no matter how many
+// tiles a cascade moves. Groups are drawn in Type order; within a group,
+// tweens keep the order they were pushed in.
+class AnimationPool {
+public:
+    struct Group {
+        std::vector<float> elapsed_ms;
+        std::vector<float> delay_ms;
+        std::vector<float> duration_ms;
+        std::vector<float> start_x;
+        std::vector<float> start_y;
+        std::vector<float> end_x;
+        std::vector<float> end_y;
+        std::vector<float> size_start;
+        std::vector<float> size_end;
+        std::vector<float> alpha_start;
+        std::vector<float> alpha_end;
+        std::vector<Color> color;
+        // col < 0 when the tween reveals nothing.
+        std::vector<match::core::Cell> reveal;
+
+        std::size_t size() const noexcept { return elapsed_ms.size(); }
+    };
+
+    void push(const Animation& anim);
+    void clear() noexcept;
+
+    // Advances every tween by delta_ms. Finished tweens are dropped and their
+    // reveal cell is erased from hidden.
+    void update(float delta_ms, HiddenCells& hidden);
+
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+    const Group& group(Animation::Type type) const noexcept {
+        return groups_[static_cast<std::size_t>(type)];
+    }
+
+private:
+    std::array<Group, Animation::kTypeCount> groups_{};
+    std::size_t size_ = 0;
+};
+
+}  // namespace match::render
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "match/render/SceneRenderer.hpp"
+
+namespace match::render {
+
+inline constexpr int kHeadingFontPt = 30;
+inline constexpr int kBodyFontPt = 22;
+inline constexpr int kSmallFontPt = 18;
+
+// Font files tried in order by FontLibrary::open.
+const std::vector<std::filesystem::path>& FontSearchPaths();
+int ScaledFontSize(int base_size, float scale);
+
+// The UI font read from disk once and opened at UI scales quantised to
+// kScaleStep. Buckets open on a worker thread, so a resize or fullscreen
+// toggle only has to wait for a bucket that nobody asked for ahead of time.
+// Opened buckets stay open until shutdown(), which keeps their font pointers,
+// and with them the shared TextCache entries, valid across switches.
+class FontLibrary {
+public:
+    static constexpr float kScaleStep = 0.1f;
+
+    FontLibrary();
+    ~FontLibrary();
+
+    FontLibrary(const FontLibrary&) = delete;
+    FontLibrary& operator=(const FontLibrary&) = delete;
+
+    static int BucketIndex(float scale);
+    static float BucketScale(int index) { return static_cast<float>(index) * kScaleStep; }
+
+    // Takes the first usable font in FontSearchPaths, from the mounted asset
+    // archive when it has one. Call after TTF_Init.
+    bool open();
+
+    // Fonts for the bucket, opened on the calling thread unless the worker
+    // already has it in hand. A bucket that failed to open yields null fonts.
+    Fonts acquire(int bucket);
+    // The bucket's fonts if they are open; otherwise queues it and returns
+    // nothing, leaving the caller on the fonts it already has.
+    std::optional<Fonts> tryAcquire(int bucket);
+    void prefetch(int bucket);
+    // Whether the worker has buckets queued or in progress.
+    bool pending() const;
+
+    // Stops the worker and closes every bucket. Call before TTF_Quit.
+    void shutdown();
+
+private:
+    bool adopt(std::vector<unsigned char> bytes);
+    Fonts openBucket(int bucket);
+    void closeFonts(Fonts& fonts);
+    bool inFlightLocked(int bucket) const;
+    void workerLoop();
+
+    std::vector<unsigned char> data_;
+    // Serialises opening and closing faces, which FreeType does not allow
+    // concurrently on one library.
+    std::mutex ttf_mutex_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::map<int, Fonts> buckets_;
+    std::deque<int> queue_;
+    // Buckets being opened right now, by the worker or inside acquire().
+    std::vector<int> opening_;
+    bool stopping_ = false;
+    // Declared last so the state above exists before the worker starts.
+    std::thread thread_;
+};
+
+}  // namespace match::render
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace match::render {
+
+// Solid-colour quads gathered over a frame and submitted with a single
+// SDL_RenderGeometry call. Quads are drawn in the order they were added, and
+// the renderer's draw blend mode applies as it would to SDL_RenderFillRectF.
+class GeometryBatch {
+public:
+    void clear() noexcept;
+    void reserveQuads(std::size_t quads);
+
+    void addRect(const SDL_FRect& rect, SDL_Color color);
+    // Four thickness-wide edges inside rect, matching SDL_RenderDrawRectF for
+    // a thickness of one pixel.
+    void addOutline(const SDL_FRect& rect, SDL_Color color, float thickness = 1.0f);
+
+    std::size_t quadCount() const noexcept { return vertices_.size() / 4; }
+
+    // Draws everything added since the last flush and empties the batch,
+    // keeping its buffers for the next frame.
+    void flush(SDL_Renderer* renderer);
+
+private:
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
+
+}  // namespace match::render
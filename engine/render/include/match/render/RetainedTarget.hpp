@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include <string>
+
+namespace match::render {
+
+// FNV-1a over the inputs a retained region is drawn from. Feed every value
+// that can change what ends up on screen; equal keys mean the cached pixels
+// are still correct.
+class ContentKey {
+public:
+    ContentKey& add(std::uint64_t value) noexcept;
+    ContentKey& add(int value) noexcept { return add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+    ContentKey& add(bool value) noexcept { return add(std::uint64_t{value ? 1u : 0u}); }
+    ContentKey& add(float value) noexcept;
+    ContentKey& add(const void* pointer) noexcept { return add(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer))); }
+    ContentKey& add(const std::string& text) noexcept;
+
+    std::uint64_t value() const noexcept { return hash_; }
+
+private:
+    std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+// An SDL_TEXTUREACCESS_TARGET texture holding a screen region drawn on an
+// earlier frame. Usage:
+//
+//     if (target.begin(renderer, region, key)) {
+//         ... draw, with window coordinates shifted by -target.origin() ...
+//     }
+//     target.end(renderer);
+//
+// begin() returns false while key matches the last redraw, and end() then
+// only copies the texture. If the renderer has no target support (or the
+// texture cannot be created) begin() always returns true with a zero origin
+// and drawing goes straight to the window.
+class RetainedTarget {
+public:
+    RetainedTarget() = default;
+    ~RetainedTarget();
+
+    RetainedTarget(const RetainedTarget&) = delete;
+    RetainedTarget& operator=(const RetainedTarget&) = delete;
+
+    bool begin(SDL_Renderer* renderer, const SDL_Rect& region, std::uint64_t key);
+    void end(SDL_Renderer* renderer);
+
+    SDL_Point origin() const noexcept { return direct_ ? SDL_Point{0, 0} : SDL_Point{region_.x, region_.y}; }
+
+    // Forces the next begin() to redraw, e.g. after SDL_RENDER_TARGETS_RESET.
+    void invalidate() noexcept { valid_ = false; }
+    void release();
+
+private:
+    SDL_Texture* texture_ = nullptr;
+    SDL_Renderer* owner_ = nullptr;
+    SDL_Rect region_{};
+    int texture_w_ = 0;
+    int texture_h_ = 0;
+    std::uint64_t key_ = 0;
+    bool valid_ = false;
+    bool direct_ = false;
+    bool drawing_ = false;
+};
+
+}  // namespace match::render
@@ -4,11 +4,11 @@
 #include <SDL2/SDL_ttf.h>
 
 #include <optional>
-#include <set>
 #include <string>
 #include <vector>
 
 #include "match/core/Board.hpp"
+#include "match/render/AnimationPool.hpp"
 
 namespace match::render {
 
@@ -22,37 +22,33 @@ struct Layout {
     float panel_top{};
     float panel_width{};
     float panel_wrap{};
+    // On-screen rectangle the board is shown in. Without zoom it is the whole
+    // board; zoomed in, the board extends past it and drawing is clipped to
+    // it.
+    float view_left{};
+    float view_top{};
+    float view_width{};
+    float view_height{};
+    bool zoomed{false};
 };
 
-struct Color {
-    Uint8 r{255};
-    Uint8 g{255};
-    Uint8 b{255};
-    Uint8 a{255};
+// Pan and zoom over boards too large to show whole. zoom 1 fits the board
+// to the window as before; center is the board point, in cells, shown in the
+// middle of the view.
+struct Camera {
+    float zoom = 1.0f;
+    float center_col = 0.0f;
+    float center_row = 0.0f;
 };
 
-struct Animation {
-    enum class Type { Swap, Pop, Fall, Spawn };
-
-    Type type = Type::Pop;
-    float duration_ms = 0.0f;
-    float delay_ms = 0.0f;
-    float elapsed_ms = 0.0f;
-    float size_start = 1.0f;
-    float size_end = 1.0f;
-    float alpha_start = 255.0f;
-    float alpha_end = 255.0f;
-    float start_x = 0.0f;
-    float start_y = 0.0f;
-    float end_x = 0.0f;
-    float end_y = 0.0f;
-    Color color{};
-    std::optional<match::core::Cell> reveal_cell;
-
-    bool started() const;
-    bool finished() const;
-    float progress() const;
-    float ease() const;
+// Columns [col_begin, col_end) and rows [row_begin, row_end) that overlap
+// the view; drawing only those keeps a zoomed-in frame's cost independent
+// of the board size.
+struct CellRange {
+    int col_begin = 0;
+    int col_end = 0;
+    int row_begin = 0;
+    int row_end = 0;
 };
 
 struct Fonts {
@@ -63,7 +59,7 @@ struct Fonts {
 
 struct BoardRenderData {
     const match::core::Board& board;
-    const std::set<match::core::Cell>& hidden_cells;
+    const HiddenCells& hidden_cells;
     std::optional<match::core::Cell> selected;
     std::optional<match::core::Cell> hover;
     std::optional<match::core::Cell> controller_cursor;
@@ -103,10 +99,20 @@ Layout ComputeLayout(int window_w,
                      int cols,
                      int rows,
                      int panel_width_px = 420,
-                     int margin_px = 60);
+                     int margin_px = 60,
+                     const Camera& camera = {});
 
-Fonts LoadFonts(float scale);
-void DestroyFonts(Fonts& fonts);
+// Keeps zoom within [1, the level where a cell is max_cell_px wide] and the
+// center where the view stays on the board. fitted is the layout at zoom 1.
+void ClampCamera(Camera& camera, const Layout& fitted, int cols, int rows, float max_cell_px = 96.0f);
+// Moves the camera by a drag of dx, dy pixels in layout.
+void PanCamera(Camera& camera, const Layout& layout, float dx, float dy);
+// Multiplies the zoom by factor, keeping the board point under (x, y) still.
+void ZoomCamera(Camera& camera, const Layout& layout, float factor, float x, float y);
+// Recenters just enough to bring cell fully into view.
+void RevealCell(Camera& camera, const Layout& layout, const match::core::Cell& cell);
+
+CellRange VisibleCells(const Layout& layout, int cols, int rows);
 
 Animation MakeSwapAnimation(const Layout& layout,
                             const match::core::Cell& from,
@@ -128,19 +134,31 @@ Animation MakeSpawnAnimation(const Layout& layout,
                              int distance_cells,
                              float duration_ms);
 
-void UpdateAnimations(std::vector<Animation>& animations,
-                      std::set<match::core::Cell>& hidden_cells,
+void UpdateAnimations(AnimationPool& animations,
+                      HiddenCells& hidden_cells,
                       float delta_ms);
 
 void DrawBoard(SDL_Renderer* renderer,
                const BoardRenderData& board_data,
                const Layout& layout);
 void DrawAnimations(SDL_Renderer* renderer,
-                    const std::vector<Animation>& animations,
+                    const AnimationPool& animations,
+                    const Layout& layout);
+// Grid, tiles, highlights and in-flight animations in one alpha-blended
+// geometry submission, drawn in the same order as DrawBoard followed by
+// DrawAnimations.
+void DrawBoardScene(SDL_Renderer* renderer,
+                    const BoardRenderData& board_data,
+                    const AnimationPool& animations,
                     const Layout& layout);
+// Redrawn into a retained render target only when something the panel shows
+// has changed; otherwise a single texture copy.
 void DrawPanel(SDL_Renderer* renderer,
                const Layout& layout,
                const Fonts& fonts,
                const PanelInfo& panel);
+// Frees the panel's retained texture. Call before destroying the renderer and
+// after SDL reports that render targets were reset.
+void ReleasePanelCache();
 
 }  // namespace match::render
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace match::render {
+
+struct TextTexture {
+    SDL_Texture* texture = nullptr;
+    int w = 0;
+    int h = 0;
+};
+
+inline constexpr std::size_t kDefaultTextCacheBytes = std::size_t{16} << 20;
+
+// Rasterised strings keyed by (renderer, font, text, colour, wrap width).
+// Entries are evicted least-recently-used first once their RGBA footprint
+// passes the byte budget, so steady UI text is rendered by TTF once and then
+// only copied. Font pointers can be reused after TTF_CloseFont, so the cache
+// must be cleared whenever fonts are closed; FontLibrary::shutdown does this
+// for the shared cache.
+class TextCache {
+public:
+    explicit TextCache(std::size_t byte_budget = kDefaultTextCacheBytes);
+    ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // A wrap_width of 0 renders a single line. The texture stays owned by the
+    // cache and is valid until the next get() or clear(); a null texture
+    // means TTF or SDL failed.
+    TextTexture get(SDL_Renderer* renderer,
+                    TTF_Font* font,
+                    const std::string& text,
+                    SDL_Color color,
+                    int wrap_width = 0);
+
+    void clear();
+    void setByteBudget(std::size_t bytes);
+
+    std::size_t byteBudget() const noexcept { return byte_budget_; }
+    std::size_t bytesUsed() const noexcept { return bytes_used_; }
+    std::size_t entryCount() const noexcept { return entries_.size(); }
+
+private:
+    struct Key {
+        SDL_Renderer* renderer = nullptr;
+        TTF_Font* font = nullptr;
+        std::uint32_t color = 0;
+        int wrap_width = 0;
+        std::string text;
+
+        bool operator==(const Key& other) const noexcept;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct Entry {
+        Key key;
+        TextTexture value;
+        std::size_t bytes = 0;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void evictToBudget();
+
+    std::size_t byte_budget_;
+    std::size_t bytes_used_{0};
+    // Most recently used first.
+    EntryList entries_;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+};
+
+// Cache used by every text helper in render, ui and the app.
+TextCache& SharedTextCache();
+
+}  // namespace match::render
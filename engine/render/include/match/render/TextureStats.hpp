@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+
+namespace match::render {
+
+// Counting wrappers around SDL's texture calls. Everything in the engine
+// creates and destroys textures through these, so live() going up between
+// two quiet frames means something leaks them.
+SDL_Texture* CreateTexture(SDL_Renderer* renderer, Uint32 format, int access, int w, int h);
+SDL_Texture* CreateTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface);
+// Null is ignored, as with SDL_DestroyTexture.
+void DestroyTexture(SDL_Texture* texture);
+
+struct TextureCounts {
+    std::int64_t live = 0;
+    std::uint64_t created = 0;
+};
+
+TextureCounts TextureStats() noexcept;
+
+}  // namespace match::render
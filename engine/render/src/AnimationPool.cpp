@@ -0,0 +1,176 @@
+#include "match/render/AnimationPool.hpp"
+
+#include <algorithm>
+
+#include "match/core/AllocTracker.hpp"
+
+namespace match::render {
+
+namespace {
+
+template <typename T>
+void CompactField(std::vector<T>& field, const std::vector<std::uint8_t>& keep) {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < field.size(); ++i) {
+        if (keep[i] != 0) {
+            field[out++] = field[i];
+        }
+    }
+    field.resize(out);
+}
+
+}  // namespace
+
+bool Animation::started() const {
+    return elapsed_ms >= delay_ms;
+}
+
+bool Animation::finished() const {
+    return elapsed_ms >= delay_ms + duration_ms;
+}
+
+float Animation::progress() const {
+    if (!started()) {
+        return 0.0f;
+    }
+    if (duration_ms <= 0.0f) {
+        return 1.0f;
+    }
+    const float t = (elapsed_ms - delay_ms) / duration_ms;
+    return std::clamp(t, 0.0f, 1.0f);
+}
+
+float Animation::ease() const {
+    const float t = progress();
+    return t * t * (3.0f - 2.0f * t);
+}
+
+void HiddenCells::reset(int cols, int rows) {
+    cols_ = std::max(0, cols);
+    rows_ = std::max(0, rows);
+    flags_.assign(static_cast<std::size_t>(cols_) * static_cast<std::size_t>(rows_), 0);
+    count_ = 0;
+}
+
+void HiddenCells::clear() noexcept {
+    if (count_ != 0) {
+        std::fill(flags_.begin(), flags_.end(), std::uint8_t{0});
+        count_ = 0;
+    }
+}
+
+void HiddenCells::insert(const match::core::Cell& cell) noexcept {
+    if (!inRange(cell)) {
+        return;
+    }
+    std::uint8_t& flag = flags_[indexOf(cell)];
+    if (flag == 0) {
+        flag = 1;
+        ++count_;
+    }
+}
+
+void HiddenCells::erase(const match::core::Cell& cell) noexcept {
+    if (!inRange(cell)) {
+        return;
+    }
+    std::uint8_t& flag = flags_[indexOf(cell)];
+    if (flag != 0) {
+        flag = 0;
+        --count_;
+    }
+}
+
+bool HiddenCells::contains(const match::core::Cell& cell) const noexcept {
+    return inRange(cell) && flags_[indexOf(cell)] != 0;
+}
+
+void AnimationPool::push(const Animation& anim) {
+    MATCH_ALLOC_SCOPE(Render);
+    Group& group = groups_[static_cast<std::size_t>(anim.type)];
+    group.elapsed_ms.push_back(anim.elapsed_ms);
+    group.delay_ms.push_back(anim.delay_ms);
+    group.duration_ms.push_back(anim.duration_ms);
+    group.start_x.push_back(anim.start_x);
+    group.start_y.push_back(anim.start_y);
+    group.end_x.push_back(anim.end_x);
+    group.end_y.push_back(anim.end_y);
+    group.size_start.push_back(anim.size_start);
+    group.size_end.push_back(anim.size_end);
+    group.alpha_start.push_back(anim.alpha_start);
+    group.alpha_end.push_back(anim.alpha_end);
+    group.color.push_back(anim.color);
+    group.reveal.push_back(anim.reveal_cell.value_or(match::core::Cell{-1, -1}));
+    ++size_;
+}
+
+void AnimationPool::clear() noexcept {
+    for (Group& group : groups_) {
+        group.elapsed_ms.clear();
+        group.delay_ms.clear();
+        group.duration_ms.clear();
+        group.start_x.clear();
+        group.start_y.clear();
+        group.end_x.clear();
+        group.end_y.clear();
+        group.size_start.clear();
+        group.size_end.clear();
+        group.alpha_start.clear();
+        group.alpha_end.clear();
+        group.color.clear();
+        group.reveal.clear();
+    }
+    size_ = 0;
+}
+
+void AnimationPool::update(float delta_ms, HiddenCells& hidden) {
+    // Scratch for the keep flags; sized to the largest group seen.
+    static thread_local std::vector<std::uint8_t> keep;
+
+    for (Group& group : groups_) {
+        const std::size_t count = group.size();
+        if (count == 0) {
+            continue;
+        }
+
+        float* elapsed = group.elapsed_ms.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            elapsed[i] += delta_ms;
+        }
+
+        keep.resize(count);
+        const float* delay = group.delay_ms.data();
+        const float* duration = group.duration_ms.data();
+        std::size_t finished = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const bool done = elapsed[i] >= delay[i] + duration[i];
+            keep[i] = done ? 0 : 1;
+            finished += done ? 1 : 0;
+        }
+        if (finished == 0) {
+            continue;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (keep[i] == 0 && group.reveal[i].col >= 0) {
+                hidden.erase(group.reveal[i]);
+            }
+        }
+        CompactField(group.elapsed_ms, keep);
+        CompactField(group.delay_ms, keep);
+        CompactField(group.duration_ms, keep);
+        CompactField(group.start_x, keep);
+        CompactField(group.start_y, keep);
+        CompactField(group.end_x, keep);
+        CompactField(group.end_y, keep);
+        CompactField(group.size_start, keep);
+        CompactField(group.size_end, keep);
+        CompactField(group.alpha_start, keep);
+        CompactField(group.alpha_end, keep);
+        CompactField(group.color, keep);
+        CompactField(group.reveal, keep);
+        size_ -= finished;
+    }
+}
+
+}  // namespace match::render
@@ -0,0 +1,232 @@
+#include "match/render/FontLibrary.hpp"
+
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+#include "match/app/AssetFS.hpp"
+#include "match/render/TextCache.hpp"
+
+namespace match::render {
+
+const std::vector<std::filesystem::path>& FontSearchPaths() {
+    static const std::vector<std::filesystem::path> paths = {
+        "assets_common/fonts/SourceCodePro-Regular.ttf",
+        "assets_common/fonts/RobotoMono-Regular.ttf",
+        "assets_common/fonts/IBMPlexMono-Regular.ttf",
+        "C:/Windows/Fonts/consola.ttf",
+        "C:/Windows/Fonts/seguiemj.ttf",
+        "C:/Windows/Fonts/segoeui.ttf",
+    };
+    return paths;
+}
+
+int ScaledFontSize(int base_size, float scale) {
+    int scaled = static_cast<int>(std::lround(static_cast<double>(base_size) * scale));
+    if (scaled <= 0) {
+        scaled = base_size;
+    }
+    return std::max(12, scaled);
+}
+
+FontLibrary::FontLibrary() : thread_([this] { workerLoop(); }) {}
+
+FontLibrary::~FontLibrary() {
+    shutdown();
+}
+
+int FontLibrary::BucketIndex(float scale) {
+    return std::max(1, static_cast<int>(std::lround(scale / kScaleStep)));
+}
+
+bool FontLibrary::open() {
+    for (const auto& candidate : FontSearchPaths()) {
+        if (candidate.is_relative()) {
+            // Packed fonts live under fonts/ in the archive, as in assets_common.
+            const std::string packed_name = "fonts/" + candidate.filename().string();
+            if (match::app::AssetBlob blob = match::app::FindPackedAsset(packed_name)) {
+                if (adopt(std::vector<unsigned char>(blob.data, blob.data + blob.size))) {
+                    return true;
+                }
+            }
+        }
+        if (!match::app::FileExists(candidate)) {
+            continue;
+        }
+        std::ifstream file(candidate, std::ios::binary);
+        if (!file) {
+            continue;
+        }
+        std::vector<unsigned char> bytes{std::istreambuf_iterator<char>(file),
+                                         std::istreambuf_iterator<char>()};
+        if (adopt(std::move(bytes))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FontLibrary::adopt(std::vector<unsigned char> bytes) {
+    if (bytes.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> ttf_lock(ttf_mutex_);
+    TTF_Font* probe = TTF_OpenFontRW(SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size())), 1,
+                                     kSmallFontPt);
+    if (!probe) {
+        return false;
+    }
+    TTF_CloseFont(probe);
+    data_ = std::move(bytes);
+    return true;
+}
+
+Fonts FontLibrary::openBucket(int bucket) {
+    Fonts fonts;
+    if (data_.empty()) {
+        return fonts;
+    }
+    const float scale = BucketScale(bucket);
+    auto open_size = [this](int point_size) -> TTF_Font* {
+        // freesrc=1 frees only the RWops wrapper; data_ outlives every face.
+        TTF_Font* font =
+            TTF_OpenFontRW(SDL_RWFromConstMem(data_.data(), static_cast<int>(data_.size())), 1, point_size);
+        if (font) {
+            TTF_SetFontHinting(font, TTF_HINTING_LIGHT);
+        }
+        return font;
+    };
+    {
+        std::lock_guard<std::mutex> ttf_lock(ttf_mutex_);
+        fonts.heading = open_size(ScaledFontSize(kHeadingFontPt, scale));
+        fonts.body = open_size(ScaledFontSize(kBodyFontPt, scale));
+        fonts.small = open_size(ScaledFontSize(kSmallFontPt, scale));
+    }
+    if (!fonts.heading || !fonts.body || !fonts.small) {
+        closeFonts(fonts);
+    }
+    return fonts;
+}
+
+void FontLibrary::closeFonts(Fonts& fonts) {
+    std::lock_guard<std::mutex> ttf_lock(ttf_mutex_);
+    for (TTF_Font** font : {&fonts.heading, &fonts.body, &fonts.small}) {
+        if (*font) {
+            TTF_CloseFont(*font);
+            *font = nullptr;
+        }
+    }
+}
+
+bool FontLibrary::inFlightLocked(int bucket) const {
+    return std::find(queue_.begin(), queue_.end(), bucket) != queue_.end() ||
+           std::find(opening_.begin(), opening_.end(), bucket) != opening_.end();
+}
+
+Fonts FontLibrary::acquire(int bucket) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        auto found = buckets_.find(bucket);
+        if (found != buckets_.end()) {
+            return found->second;
+        }
+        if (stopping_) {
+            return {};
+        }
+        if (std::find(opening_.begin(), opening_.end(), bucket) != opening_.end()) {
+            done_.wait(lock);
+            continue;
+        }
+        break;
+    }
+    // Still queued for the worker: take it over rather than wait in line.
+    queue_.erase(std::remove(queue_.begin(), queue_.end(), bucket), queue_.end());
+    opening_.push_back(bucket);
+    lock.unlock();
+
+    Fonts fonts = openBucket(bucket);
+
+    lock.lock();
+    opening_.erase(std::find(opening_.begin(), opening_.end(), bucket));
+    buckets_[bucket] = fonts;
+    done_.notify_all();
+    return fonts;
+}
+
+std::optional<Fonts> FontLibrary::tryAcquire(int bucket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = buckets_.find(bucket);
+    if (found != buckets_.end()) {
+        return found->second;
+    }
+    if (!stopping_ && !inFlightLocked(bucket)) {
+        // Ahead of any prefetches: this one is on screen next.
+        queue_.push_front(bucket);
+        wake_.notify_one();
+    }
+    return std::nullopt;
+}
+
+void FontLibrary::prefetch(int bucket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ || buckets_.count(bucket) != 0 || inFlightLocked(bucket)) {
+        return;
+    }
+    queue_.push_back(bucket);
+    wake_.notify_one();
+}
+
+bool FontLibrary::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !queue_.empty() || !opening_.empty();
+}
+
+void FontLibrary::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // Cached text is keyed by font pointer, which TTF may hand out again.
+    SharedTextCache().clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [bucket, fonts] : buckets_) {
+        closeFonts(fonts);
+    }
+    buckets_.clear();
+    data_.clear();
+    data_.shrink_to_fit();
+}
+
+void FontLibrary::workerLoop() {
+    while (true) {
+        int bucket = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            bucket = queue_.front();
+            queue_.pop_front();
+            opening_.push_back(bucket);
+        }
+
+        Fonts fonts = openBucket(bucket);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        opening_.erase(std::find(opening_.begin(), opening_.end(), bucket));
+        buckets_[bucket] = fonts;
+        done_.notify_all();
+    }
+}
+
+}  // namespace match::render
@@ -0,0 +1,50 @@
+#include "match/render/GeometryBatch.hpp"
+
+#include <algorithm>
+
+namespace match::render {
+
+void GeometryBatch::clear() noexcept {
+    vertices_.clear();
+    indices_.clear();
+}
+
+void GeometryBatch::reserveQuads(std::size_t quads) {
+    vertices_.reserve(quads * 4);
+    indices_.reserve(quads * 6);
+}
+
+void GeometryBatch::addRect(const SDL_FRect& rect, SDL_Color color) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f) {
+        return;
+    }
+    const int base = static_cast<int>(vertices_.size());
+    const float right = rect.x + rect.w;
+    const float bottom = rect.y + rect.h;
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{rect.x, rect.y}, color, SDL_FPoint{0.0f, 0.0f}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{right, rect.y}, color, SDL_FPoint{0.0f, 0.0f}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{right, bottom}, color, SDL_FPoint{0.0f, 0.0f}});
+    vertices_.push_back(SDL_Vertex{SDL_FPoint{rect.x, bottom}, color, SDL_FPoint{0.0f, 0.0f}});
+    indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+void GeometryBatch::addOutline(const SDL_FRect& rect, SDL_Color color, float thickness) {
+    const float t = std::min(thickness, std::min(rect.w, rect.h) * 0.5f);
+    if (t <= 0.0f) {
+        return;
+    }
+    addRect(SDL_FRect{rect.x, rect.y, rect.w, t}, color);
+    addRect(SDL_FRect{rect.x, rect.y + rect.h - t, rect.w, t}, color);
+    addRect(SDL_FRect{rect.x, rect.y + t, t, rect.h - 2.0f * t}, color);
+    addRect(SDL_FRect{rect.x + rect.w - t, rect.y + t, t, rect.h - 2.0f * t}, color);
+}
+
+void GeometryBatch::flush(SDL_Renderer* renderer) {
+    if (renderer && !indices_.empty()) {
+        SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+    }
+    clear();
+}
+
+}  // namespace match::render
@@ -0,0 +1,119 @@
+#include "match/render/RetainedTarget.hpp"
+
+#include <cstring>
+
+#include "match/render/TextureStats.hpp"
+
+namespace match::render {
+
+namespace {
+
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+// Contents are drawn with normal alpha blending onto a transparent clear, which
+// leaves colour premultiplied by alpha; composite accordingly.
+SDL_BlendMode PremultipliedBlend() {
+    static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    return mode;
+}
+
+}  // namespace
+
+ContentKey& ContentKey::add(std::uint64_t value) noexcept {
+    for (int shift = 0; shift < 64; shift += 8) {
+        hash_ ^= (value >> shift) & 0xFFu;
+        hash_ *= kFnvPrime;
+    }
+    return *this;
+}
+
+ContentKey& ContentKey::add(float value) noexcept {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return add(std::uint64_t{bits});
+}
+
+ContentKey& ContentKey::add(const std::string& text) noexcept {
+    for (unsigned char ch : text) {
+        hash_ ^= ch;
+        hash_ *= kFnvPrime;
+    }
+    // Length terminates the string so ("ab", "c") and ("a", "bc") differ.
+    return add(static_cast<std::uint64_t>(text.size()));
+}
+
+RetainedTarget::~RetainedTarget() {
+    release();
+}
+
+void RetainedTarget::release() {
+    if (texture_) {
+        DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    owner_ = nullptr;
+    texture_w_ = 0;
+    texture_h_ = 0;
+    valid_ = false;
+}
+
+bool RetainedTarget::begin(SDL_Renderer* renderer, const SDL_Rect& region, std::uint64_t key) {
+    drawing_ = false;
+    direct_ = false;
+    region_ = region;
+    if (!renderer || region.w <= 0 || region.h <= 0) {
+        valid_ = false;
+        return false;
+    }
+    if (SDL_RenderTargetSupported(renderer) != SDL_TRUE) {
+        direct_ = true;
+        return true;
+    }
+
+    if (renderer != owner_ || region.w != texture_w_ || region.h != texture_h_) {
+        release();
+        texture_ = CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                 region.w, region.h);
+        if (!texture_) {
+            direct_ = true;
+            return true;
+        }
+        SDL_SetTextureBlendMode(texture_, PremultipliedBlend());
+        owner_ = renderer;
+        texture_w_ = region.w;
+        texture_h_ = region.h;
+    }
+
+    if (valid_ && key == key_) {
+        return false;
+    }
+
+    if (SDL_SetRenderTarget(renderer, texture_) != 0) {
+        release();
+        direct_ = true;
+        return true;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    drawing_ = true;
+    key_ = key;
+    valid_ = true;
+    return true;
+}
+
+void RetainedTarget::end(SDL_Renderer* renderer) {
+    if (direct_ || !renderer) {
+        return;
+    }
+    if (drawing_) {
+        SDL_SetRenderTarget(renderer, nullptr);
+        drawing_ = false;
+    }
+    if (texture_ && valid_) {
+        SDL_RenderCopy(renderer, texture_, nullptr, &region_);
+    }
+}
+
+}  // namespace match::render
@@ -3,30 +3,19 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
-#include <filesystem>
 
-#include "match/app/AssetFS.hpp"
+#include "match/core/AllocTracker.hpp"
+#include "match/core/Profiler.hpp"
+#include "match/render/GeometryBatch.hpp"
+#include "match/render/RetainedTarget.hpp"
+#include "match/render/TextCache.hpp"
 
 namespace match::render {
 
 namespace {
 
-TTF_Font* LoadFontFromCandidates(const std::vector<std::filesystem::path>& candidates,
-                                 int point_size) {
-    for (const auto& candidate : candidates) {
-        if (!match::app::FileExists(candidate)) {
-            continue;
-        }
-        TTF_Font* font = TTF_OpenFont(candidate.string().c_str(), point_size);
-        if (font) {
-            TTF_SetFontHinting(font, TTF_HINTING_LIGHT);
-            return font;
-        }
-    }
-    return nullptr;
-}
-
 const std::array<Color, 6> kTileColors{{
     Color{62, 191, 238, 255},
     Color{238, 84, 76, 255},
@@ -70,26 +59,15 @@ int RenderTextLine(SDL_Renderer* renderer,
     if (!font || text.empty()) {
         return 0;
     }
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surface) {
-        return 0;
-    }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        int h = surface->h;
-        SDL_FreeSurface(surface);
-        return h;
-    }
-    SDL_Rect dst{x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-
-    if (out_width) {
-        *out_width = surface->w;
+    const TextTexture line = SharedTextCache().get(renderer, font, text, color);
+    if (line.texture) {
+        SDL_Rect dst{x, y, line.w, line.h};
+        SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
+        if (out_width) {
+            *out_width = line.w;
+        }
     }
-    int height = surface->h;
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
-    return height;
+    return line.h;
 }
 
 int RenderWrappedText(SDL_Renderer* renderer,
@@ -102,23 +80,12 @@ int RenderWrappedText(SDL_Renderer* renderer,
     if (!font || text.empty()) {
         return 0;
     }
-    SDL_Surface* surface =
-        TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), color, wrap_width);
-    if (!surface) {
-        return 0;
-    }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        int h = surface->h;
-        SDL_FreeSurface(surface);
-        return h;
+    const TextTexture block = SharedTextCache().get(renderer, font, text, color, wrap_width);
+    if (block.texture) {
+        SDL_Rect dst{x, y, block.w, block.h};
+        SDL_RenderCopy(renderer, block.texture, nullptr, &dst);
     }
-    SDL_Rect dst{x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    int height = surface->h;
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
-    return height;
+    return block.h;
 }
 
 std::pair<int, int> MeasureText(TTF_Font* font, const std::string& text) {
@@ -147,36 +114,13 @@ std::string FormatTimerString(float ms) {
 
 }  // namespace
 
-bool Animation::started() const {
-    return elapsed_ms >= delay_ms;
-}
-
-bool Animation::finished() const {
-    return elapsed_ms >= delay_ms + duration_ms;
-}
-
-float Animation::progress() const {
-    if (!started()) {
-        return 0.0f;
-    }
-    if (duration_ms <= 0.0f) {
-        return 1.0f;
-    }
-    const float t = (elapsed_ms - delay_ms) / duration_ms;
-    return std::clamp(t, 0.0f, 1.0f);
-}
-
-float Animation::ease() const {
-    const float t = progress();
-    return t * t * (3.0f - 2.0f * t);
-}
-
 Layout ComputeLayout(int window_w,
                      int window_h,
                      int cols,
                      int rows,
                      int panel_width_px,
-                     int margin_px) {
+                     int margin_px,
+                     const Camera& camera) {
     float width = static_cast<float>(window_w);
     float height = static_cast<float>(window_h);
 
@@ -206,54 +150,280 @@ Layout ComputeLayout(int window_w,
     layout.panel_top = panel_top;
     layout.panel_width = panel_width;
     layout.panel_wrap = panel_width - std::max(32.0f, panel_width * 0.08f);
+    layout.view_left = board_left;
+    layout.view_top = board_top;
+    layout.view_width = board_width;
+    layout.view_height = board_height;
+
+    if (camera.zoom > 1.0f && cell_size > 0.0f) {
+        // The view keeps the fitted board's place on screen; the board grows
+        // behind it and slides so the camera center sits mid-view, never
+        // showing past an edge.
+        const float zoomed_cell = cell_size * camera.zoom;
+        const float left = layout.view_left + 0.5f * layout.view_width - camera.center_col * zoomed_cell;
+        const float top = layout.view_top + 0.5f * layout.view_height - camera.center_row * zoomed_cell;
+        layout.board_left =
+            std::clamp(left, layout.view_left + layout.view_width - zoomed_cell * cols, layout.view_left);
+        layout.board_top =
+            std::clamp(top, layout.view_top + layout.view_height - zoomed_cell * rows, layout.view_top);
+        layout.cell_size = zoomed_cell;
+        layout.cell_inset = std::max(1.0f, zoomed_cell * 0.04f);
+        layout.zoomed = true;
+    }
     return layout;
 }
 
-namespace {
+void ClampCamera(Camera& camera, const Layout& fitted, int cols, int rows, float max_cell_px) {
+    const float max_zoom = fitted.cell_size > 0.0f ? std::max(1.0f, max_cell_px / fitted.cell_size) : 1.0f;
+    camera.zoom = std::clamp(camera.zoom, 1.0f, max_zoom);
+    const float half_cols = 0.5f * static_cast<float>(cols) / camera.zoom;
+    const float half_rows = 0.5f * static_cast<float>(rows) / camera.zoom;
+    camera.center_col = std::clamp(camera.center_col, half_cols, static_cast<float>(cols) - half_cols);
+    camera.center_row = std::clamp(camera.center_row, half_rows, static_cast<float>(rows) - half_rows);
+}
 
-int ScaledFontSize(int base_size, float scale) {
-    int scaled = static_cast<int>(std::lround(static_cast<double>(base_size) * scale));
-    if (scaled <= 0) {
-        scaled = base_size;
+void PanCamera(Camera& camera, const Layout& layout, float dx, float dy) {
+    if (!layout.zoomed || layout.cell_size <= 0.0f) {
+        return;
     }
-    return std::max(12, scaled);
+    const float center_x = layout.view_left + 0.5f * layout.view_width;
+    const float center_y = layout.view_top + 0.5f * layout.view_height;
+    camera.center_col = (center_x - dx - layout.board_left) / layout.cell_size;
+    camera.center_row = (center_y - dy - layout.board_top) / layout.cell_size;
 }
 
-}  // namespace
+void ZoomCamera(Camera& camera, const Layout& layout, float factor, float x, float y) {
+    if (layout.cell_size <= 0.0f || factor <= 0.0f) {
+        return;
+    }
+    const float anchor_col = (x - layout.board_left) / layout.cell_size;
+    const float anchor_row = (y - layout.board_top) / layout.cell_size;
+    const float zoom = std::max(1.0f, camera.zoom * factor);
+    const float cell = layout.cell_size * zoom / camera.zoom;
+    camera.zoom = zoom;
+    camera.center_col = anchor_col + (layout.view_left + 0.5f * layout.view_width - x) / cell;
+    camera.center_row = anchor_row + (layout.view_top + 0.5f * layout.view_height - y) / cell;
+}
+
+void RevealCell(Camera& camera, const Layout& layout, const match::core::Cell& cell) {
+    if (!layout.zoomed || layout.cell_size <= 0.0f) {
+        return;
+    }
+    const float left = (layout.view_left - layout.board_left) / layout.cell_size;
+    const float top = (layout.view_top - layout.board_top) / layout.cell_size;
+    const float width = layout.view_width / layout.cell_size;
+    const float height = layout.view_height / layout.cell_size;
+    float shift_col = 0.0f;
+    float shift_row = 0.0f;
+    if (cell.col < left) {
+        shift_col = cell.col - left;
+    } else if (cell.col + 1 > left + width) {
+        shift_col = cell.col + 1 - (left + width);
+    }
+    if (cell.row < top) {
+        shift_row = cell.row - top;
+    } else if (cell.row + 1 > top + height) {
+        shift_row = cell.row + 1 - (top + height);
+    }
+    camera.center_col = left + 0.5f * width + shift_col;
+    camera.center_row = top + 0.5f * height + shift_row;
+}
 
-Fonts LoadFonts(float scale) {
-    std::vector<std::filesystem::path> search_paths = {
-        "assets_common/fonts/SourceCodePro-Regular.ttf",
-        "assets_common/fonts/RobotoMono-Regular.ttf",
-        "assets_common/fonts/IBMPlexMono-Regular.ttf",
-        "C:/Windows/Fonts/consola.ttf",
-        "C:/Windows/Fonts/seguiemj.ttf",
-        "C:/Windows/Fonts/segoeui.ttf",
+CellRange VisibleCells(const Layout& layout, int cols, int rows) {
+    CellRange range;
+    if (layout.cell_size <= 0.0f) {
+        return range;
+    }
+    auto span = [&](float view_start, float view_extent, float board_start, int count, int& begin, int& end) {
+        const float first = (view_start - board_start) / layout.cell_size;
+        const float last = (view_start + view_extent - board_start) / layout.cell_size;
+        begin = std::clamp(static_cast<int>(std::floor(first)), 0, count);
+        end = std::clamp(static_cast<int>(std::ceil(last)), begin, count);
     };
+    span(layout.view_left, layout.view_width, layout.board_left, cols, range.col_begin, range.col_end);
+    span(layout.view_top, layout.view_height, layout.board_top, rows, range.row_begin, range.row_end);
+    return range;
+}
 
-    Fonts fonts;
-    fonts.heading =
-        LoadFontFromCandidates(search_paths, ScaledFontSize(30, scale));
-    fonts.body = LoadFontFromCandidates(search_paths, ScaledFontSize(22, scale));
-    fonts.small = LoadFontFromCandidates(search_paths, ScaledFontSize(18, scale));
-    return fonts;
+namespace {
+
+// Reused every frame so the vertex and index buffers stop growing once the
+// largest board has been drawn.
+GeometryBatch& FrameBatch() {
+    static GeometryBatch batch;
+    return batch;
 }
 
-void DestroyFonts(Fonts& fonts) {
-    if (fonts.heading) {
-        TTF_CloseFont(fonts.heading);
-        fonts.heading = nullptr;
+// Zoomed-in boards overhang the view; clip what the batch draws to it.
+void FlushToView(GeometryBatch& batch, SDL_Renderer* renderer, const Layout& layout) {
+    if (!layout.zoomed) {
+        batch.flush(renderer);
+        return;
     }
-    if (fonts.body) {
-        TTF_CloseFont(fonts.body);
-        fonts.body = nullptr;
+    const SDL_Rect clip{static_cast<int>(layout.view_left), static_cast<int>(layout.view_top),
+                        static_cast<int>(std::ceil(layout.view_width)) + 1,
+                        static_cast<int>(std::ceil(layout.view_height)) + 1};
+    SDL_RenderSetClipRect(renderer, &clip);
+    batch.flush(renderer);
+    SDL_RenderSetClipRect(renderer, nullptr);
+}
+
+void AppendBoard(GeometryBatch& batch, const BoardRenderData& board_data, const Layout& layout) {
+    const int cols = board_data.board.cols();
+    const int rows = board_data.board.rows();
+    const CellRange visible = VisibleCells(layout, cols, rows);
+    const int visible_cols = visible.col_end - visible.col_begin;
+    const int visible_rows = visible.row_end - visible.row_begin;
+    const std::size_t cell_count =
+        static_cast<std::size_t>(visible_cols) * static_cast<std::size_t>(visible_rows);
+    batch.reserveQuads(batch.quadCount() + cell_count +
+                       static_cast<std::size_t>(visible_cols + visible_rows + 2) + 8);
+
+    const HiddenCells& hidden = board_data.hidden_cells;
+    struct HighlightTile {
+        SDL_FPoint center;
+        SDL_Color color;
+        float scale;
+        bool draw_outline;
+    };
+    std::vector<HighlightTile> highlight_tiles;
+    highlight_tiles.reserve(8);
+
+    // One-pixel lines as quads covering the same pixels SDL_RenderDrawLine
+    // would, end points included.
+    const SDL_Color grid_color{255, 255, 255, static_cast<Uint8>(layout.grid_line_alpha)};
+    const float grid_top = static_cast<float>(static_cast<int>(layout.board_top));
+    const float grid_left = static_cast<float>(static_cast<int>(layout.board_left));
+    const float grid_bottom = static_cast<float>(static_cast<int>(layout.board_top + layout.cell_size * rows));
+    const float grid_right = static_cast<float>(static_cast<int>(layout.board_left + layout.cell_size * cols));
+    for (int c = visible.col_begin; c <= visible.col_end; ++c) {
+        const float x = static_cast<float>(static_cast<int>(layout.board_left + c * layout.cell_size));
+        batch.addRect(SDL_FRect{x, grid_top, 1.0f, grid_bottom - grid_top + 1.0f}, grid_color);
     }
-    if (fonts.small) {
-        TTF_CloseFont(fonts.small);
-        fonts.small = nullptr;
+    for (int r = visible.row_begin; r <= visible.row_end; ++r) {
+        const float y = static_cast<float>(static_cast<int>(layout.board_top + r * layout.cell_size));
+        batch.addRect(SDL_FRect{grid_left, y, grid_right - grid_left + 1.0f, 1.0f}, grid_color);
+    }
+
+    for (int c = visible.col_begin; c < visible.col_end; ++c) {
+        for (int r = visible.row_begin; r < visible.row_end; ++r) {
+            match::core::Cell cell{c, r};
+            if (hidden.contains(cell)) {
+                continue;
+            }
+            const int tile = board_data.board.get(c, r);
+            if (tile == match::core::kEmptyCell) {
+                continue;
+            }
+
+            const bool is_selected = board_data.selected && *board_data.selected == cell;
+            const bool is_hover =
+                !is_selected && board_data.hover && *board_data.hover == cell;
+            const bool is_controller =
+                !is_selected && board_data.controller_cursor &&
+                *board_data.controller_cursor == cell;
+
+            const float scale = (is_hover || is_controller) ? 1.2f : 1.0f;
+            const SDL_FPoint center = CellCenter(layout, cell);
+            const float base = layout.cell_size - 2.0f * layout.cell_inset;
+            float half = 0.5f * base * scale;
+
+            const float left_limit = layout.board_left + layout.cell_inset;
+            const float right_limit =
+                layout.board_left + cols * layout.cell_size - layout.cell_inset;
+            const float top_limit = layout.board_top + layout.cell_inset;
+            const float bottom_limit =
+                layout.board_top + rows * layout.cell_size - layout.cell_inset;
+
+            float max_half_x =
+                std::min(center.x - left_limit, right_limit - center.x);
+            float max_half_y =
+                std::min(center.y - top_limit, bottom_limit - center.y);
+            float allowed_half =
+                std::max(0.0f, std::min(half, std::min(max_half_x, max_half_y)));
+            if (allowed_half <= 0.0f) {
+                continue;
+            }
+
+            SDL_Color color = SDLColorConverter::Convert(TileColor(tile));
+            color.a = 255;
+            const bool highlight = is_selected || is_hover || is_controller;
+            if (highlight) {
+                highlight_tiles.push_back(HighlightTile{center, color, scale, true});
+                continue;
+            }
+
+            batch.addRect(MakeRect(center.x, center.y, allowed_half), color);
+        }
+    }
+
+    if (!highlight_tiles.empty()) {
+        const float board_left = layout.board_left;
+        const float board_top = layout.board_top;
+        const float board_right = layout.board_left + cols * layout.cell_size;
+        const float board_bottom = layout.board_top + rows * layout.cell_size;
+        const float base = layout.cell_size - 2.0f * layout.cell_inset;
+
+        for (const auto& highlight : highlight_tiles) {
+            float half = 0.5f * base * highlight.scale;
+            float max_half_x =
+                std::min(highlight.center.x - board_left, board_right - highlight.center.x);
+            float max_half_y =
+                std::min(highlight.center.y - board_top, board_bottom - highlight.center.y);
+            float allowed_half =
+                std::max(0.0f, std::min(half, std::min(max_half_x, max_half_y)));
+            if (allowed_half <= 0.0f) {
+                continue;
+            }
+
+            SDL_FRect rect =
+                MakeRect(highlight.center.x, highlight.center.y, allowed_half);
+            batch.addRect(rect, highlight.color);
+
+            if (highlight.draw_outline) {
+                batch.addOutline(rect, SDL_Color{255, 255, 255, 200});
+            }
+        }
+    }
+}
+
+void AppendAnimations(GeometryBatch& batch,
+                      const AnimationPool& animations,
+                      const Layout& layout) {
+    const float base = layout.cell_size - 2.0f * layout.cell_inset;
+    batch.reserveQuads(batch.quadCount() + animations.size());
+
+    for (std::size_t type = 0; type < Animation::kTypeCount; ++type) {
+        const AnimationPool::Group& group = animations.group(static_cast<Animation::Type>(type));
+        const std::size_t count = group.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const float local = group.elapsed_ms[i] - group.delay_ms[i];
+            if (local < 0.0f) {
+                continue;
+            }
+            const float duration = group.duration_ms[i];
+            const float t = duration <= 0.0f ? 1.0f : std::clamp(local / duration, 0.0f, 1.0f);
+            const float ease = t * t * (3.0f - 2.0f * t);
+            const float x = group.start_x[i] + (group.end_x[i] - group.start_x[i]) * ease;
+            const float y = group.start_y[i] + (group.end_y[i] - group.start_y[i]) * ease;
+            const float size = group.size_start[i] + (group.size_end[i] - group.size_start[i]) * ease;
+            const float alpha_f =
+                group.alpha_start[i] + (group.alpha_end[i] - group.alpha_start[i]) * ease;
+            const float half = 0.5f * base * size;
+            if (layout.zoomed &&
+                (x + half < layout.view_left || x - half > layout.view_left + layout.view_width ||
+                 y + half < layout.view_top || y - half > layout.view_top + layout.view_height)) {
+                continue;
+            }
+            SDL_Color color = SDLColorConverter::Convert(group.color[i]);
+            color.a = static_cast<Uint8>(std::clamp(alpha_f, 0.0f, 255.0f));
+            batch.addRect(MakeRect(x, y, half), color);
+        }
     }
 }
 
+}  // namespace
+
 Animation MakeSwapAnimation(const Layout& layout,
                             const match::core::Cell& from,
                             const match::core::Cell& to,
@@ -341,171 +511,48 @@ Animation MakeSpawnAnimation(const Layout& layout,
     return anim;
 }
 
-void UpdateAnimations(std::vector<Animation>& animations,
-                      std::set<match::core::Cell>& hidden_cells,
+void UpdateAnimations(AnimationPool& animations,
+                      HiddenCells& hidden_cells,
                       float delta_ms) {
-    for (auto& anim : animations) {
-        anim.elapsed_ms += delta_ms;
-    }
-
-    auto it = animations.begin();
-    while (it != animations.end()) {
-        if (it->finished()) {
-            if (it->reveal_cell) {
-                hidden_cells.erase(*it->reveal_cell);
-            }
-            it = animations.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    animations.update(delta_ms, hidden_cells);
 }
 
 void DrawBoard(SDL_Renderer* renderer,
                const BoardRenderData& board_data,
                const Layout& layout) {
-    const int cols = board_data.board.cols();
-    const int rows = board_data.board.rows();
-
-    struct HighlightTile {
-        SDL_FPoint center;
-        SDL_Color color;
-        float scale;
-        bool draw_outline;
-    };
-    std::vector<HighlightTile> highlight_tiles;
-    highlight_tiles.reserve(8);
-
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255,
-                           static_cast<Uint8>(layout.grid_line_alpha));
-    for (int c = 0; c <= cols; ++c) {
-        const int x = static_cast<int>(layout.board_left + c * layout.cell_size);
-        SDL_RenderDrawLine(renderer, x, static_cast<int>(layout.board_top),
-                           x, static_cast<int>(layout.board_top + layout.cell_size * rows));
-    }
-    for (int r = 0; r <= rows; ++r) {
-        const int y = static_cast<int>(layout.board_top + r * layout.cell_size);
-        SDL_RenderDrawLine(renderer, static_cast<int>(layout.board_left), y,
-                           static_cast<int>(layout.board_left + layout.cell_size * cols), y);
-    }
-
-    for (int c = 0; c < cols; ++c) {
-        for (int r = 0; r < rows; ++r) {
-            match::core::Cell cell{c, r};
-            if (board_data.hidden_cells.find(cell) != board_data.hidden_cells.end()) {
-                continue;
-            }
-            const int tile = board_data.board.get(c, r);
-            if (tile == match::core::kEmptyCell) {
-                continue;
-            }
-
-            const bool is_selected = board_data.selected && *board_data.selected == cell;
-            const bool is_hover =
-                !is_selected && board_data.hover && *board_data.hover == cell;
-            const bool is_controller =
-                !is_selected && board_data.controller_cursor &&
-                *board_data.controller_cursor == cell;
-
-            const float scale = (is_hover || is_controller) ? 1.2f : 1.0f;
-            const SDL_FPoint center = CellCenter(layout, cell);
-            const float base = layout.cell_size - 2.0f * layout.cell_inset;
-            float half = 0.5f * base * scale;
-
-            const float left_limit = layout.board_left + layout.cell_inset;
-            const float right_limit =
-                layout.board_left + cols * layout.cell_size - layout.cell_inset;
-            const float top_limit = layout.board_top + layout.cell_inset;
-            const float bottom_limit =
-                layout.board_top + rows * layout.cell_size - layout.cell_inset;
-
-            float max_half_x =
-                std::min(center.x - left_limit, right_limit - center.x);
-            float max_half_y =
-                std::min(center.y - top_limit, bottom_limit - center.y);
-            float allowed_half =
-                std::max(0.0f, std::min(half, std::min(max_half_x, max_half_y)));
-            if (allowed_half <= 0.0f) {
-                continue;
-            }
-
-            SDL_Color color = SDLColorConverter::Convert(TileColor(tile));
-            const bool highlight = is_selected || is_hover || is_controller;
-            if (highlight) {
-                highlight_tiles.push_back(HighlightTile{center, color, scale, true});
-                continue;
-            }
-
-            SDL_FRect rect = MakeRect(center.x, center.y, allowed_half);
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
-            SDL_RenderFillRectF(renderer, &rect);
-        }
-    }
-
-    if (!highlight_tiles.empty()) {
-        const float board_left = layout.board_left;
-        const float board_top = layout.board_top;
-        const float board_right = layout.board_left + cols * layout.cell_size;
-        const float board_bottom = layout.board_top + rows * layout.cell_size;
-        const float base = layout.cell_size - 2.0f * layout.cell_inset;
-
-        for (const auto& highlight : highlight_tiles) {
-            float half = 0.5f * base * highlight.scale;
-            float max_half_x =
-                std::min(highlight.center.x - board_left, board_right - highlight.center.x);
-            float max_half_y =
-                std::min(highlight.center.y - board_top, board_bottom - highlight.center.y);
-            float allowed_half =
-                std::max(0.0f, std::min(half, std::min(max_half_x, max_half_y)));
-            if (allowed_half <= 0.0f) {
-                continue;
-            }
-
-            SDL_FRect rect =
-                MakeRect(highlight.center.x, highlight.center.y, allowed_half);
-            SDL_SetRenderDrawColor(renderer, highlight.color.r, highlight.color.g,
-                                   highlight.color.b, 255);
-            SDL_RenderFillRectF(renderer, &rect);
-
-            if (highlight.draw_outline) {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-                SDL_RenderDrawRectF(renderer, &rect);
-            }
-        }
-    }
+    GeometryBatch& batch = FrameBatch();
+    AppendBoard(batch, board_data, layout);
+    FlushToView(batch, renderer, layout);
 }
 
 void DrawAnimations(SDL_Renderer* renderer,
-                    const std::vector<Animation>& animations,
+                    const AnimationPool& animations,
                     const Layout& layout) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    GeometryBatch& batch = FrameBatch();
+    AppendAnimations(batch, animations, layout);
+    FlushToView(batch, renderer, layout);
+}
 
-    const float base = layout.cell_size - 2.0f * layout.cell_inset;
-
-    for (const auto& anim : animations) {
-        if (!anim.started()) {
-            continue;
-        }
-        const float ease = anim.ease();
-        const float x = anim.start_x + (anim.end_x - anim.start_x) * ease;
-        const float y = anim.start_y + (anim.end_y - anim.start_y) * ease;
-        const float size = anim.size_start + (anim.size_end - anim.size_start) * ease;
-        const float alpha_f =
-            anim.alpha_start + (anim.alpha_end - anim.alpha_start) * ease;
-        const float half = 0.5f * base * size;
-        SDL_FRect rect = MakeRect(x, y, half);
-        SDL_Color color = SDLColorConverter::Convert(anim.color);
-        color.a = static_cast<Uint8>(std::clamp(alpha_f, 0.0f, 255.0f));
-
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        SDL_RenderFillRectF(renderer, &rect);
-    }
+void DrawBoardScene(SDL_Renderer* renderer,
+                    const BoardRenderData& board_data,
+                    const AnimationPool& animations,
+                    const Layout& layout) {
+    MATCH_PROFILE_SCOPE("render.board");
+    MATCH_ALLOC_SCOPE(Render);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    GeometryBatch& batch = FrameBatch();
+    AppendBoard(batch, board_data, layout);
+    AppendAnimations(batch, animations, layout);
+    FlushToView(batch, renderer, layout);
 }
 
-void DrawPanel(SDL_Renderer* renderer,
-               const Layout& layout,
-               const Fonts& fonts,
-               const PanelInfo& panel) {
+namespace {
+
+void DrawPanelContents(SDL_Renderer* renderer,
+                       const Layout& layout,
+                       const Fonts& fonts,
+                       const PanelInfo& panel) {
     const SDL_Color heading_color{210, 215, 225, 255};
     const SDL_Color value_color{235, 240, 245, 255};
     const SDL_Color detail_color{170, 180, 190, 255};
@@ -600,5 +647,83 @@ void DrawPanel(SDL_Renderer* renderer,
     }
 }
 
+// Everything DrawPanelContents reads. The turn timer goes in as the string it
+// is shown as, so the panel is redrawn once a second rather than every frame.
+std::uint64_t PanelContentKey(const Layout& layout, const Fonts& fonts, const PanelInfo& panel) {
+    ContentKey key;
+    key.add(static_cast<const void*>(fonts.heading))
+        .add(static_cast<const void*>(fonts.body))
+        .add(static_cast<const void*>(fonts.small))
+        .add(layout.panel_left)
+        .add(layout.panel_top)
+        .add(layout.panel_wrap)
+        .add(panel.mode)
+        .add(panel.round)
+        .add(panel.order)
+        .add(panel.bombs_enabled)
+        .add(panel.color_blast_enabled)
+        .add(panel.moves_left)
+        .add(panel.status)
+        .add(panel.show_turn_timer)
+        .add(panel.show_turn_timer ? FormatTimerString(panel.turn_timer_ms) : std::string{})
+        .add(panel.show_pre_turn)
+        .add(panel.show_pre_turn ? panel.pre_turn_seconds : 0);
+    key.add(static_cast<int>(panel.players.size()));
+    for (const auto& entry : panel.players) {
+        key.add(entry.name).add(entry.score).add(entry.active).add(entry.moves_left);
+    }
+    key.add(static_cast<int>(panel.controls.size()));
+    for (const auto& line : panel.controls) {
+        key.add(line);
+    }
+    return key.value();
+}
+
+RetainedTarget& PanelTarget() {
+    static RetainedTarget target;
+    return target;
+}
+
+// Slack around the panel origin for the active-player outline, which is
+// drawn a few pixels left of and above its text.
+constexpr int kPanelTargetMargin = 16;
+
+}  // namespace
+
+void DrawPanel(SDL_Renderer* renderer,
+               const Layout& layout,
+               const Fonts& fonts,
+               const PanelInfo& panel) {
+    MATCH_PROFILE_SCOPE("render.panel");
+    MATCH_ALLOC_SCOPE(Render);
+    int output_w = 0;
+    int output_h = 0;
+    if (SDL_GetRendererOutputSize(renderer, &output_w, &output_h) != 0) {
+        DrawPanelContents(renderer, layout, fonts, panel);
+        return;
+    }
+    SDL_Rect region{std::max(0, static_cast<int>(layout.panel_left) - kPanelTargetMargin),
+                    std::max(0, static_cast<int>(layout.panel_top) - kPanelTargetMargin),
+                    0,
+                    0};
+    region.w = output_w - region.x;
+    region.h = output_h - region.y;
+
+    RetainedTarget& target = PanelTarget();
+    if (target.begin(renderer, region, PanelContentKey(layout, fonts, panel))) {
+        const SDL_Point origin = target.origin();
+        Layout local = layout;
+        local.panel_left -= static_cast<float>(origin.x);
+        local.panel_top -= static_cast<float>(origin.y);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        DrawPanelContents(renderer, local, fonts, panel);
+    }
+    target.end(renderer);
+}
+
+void ReleasePanelCache() {
+    PanelTarget().release();
+}
+
 // Helper function defined above must be declared before use.
 }  // namespace match::render
@@ -0,0 +1,119 @@
+#include "match/render/TextCache.hpp"
+
+#include <functional>
+#include <utility>
+
+#include "match/core/AllocTracker.hpp"
+#include "match/core/Profiler.hpp"
+#include "match/render/TextureStats.hpp"
+
+namespace match::render {
+
+namespace {
+
+std::uint32_t PackColor(SDL_Color color) {
+    return (static_cast<std::uint32_t>(color.r) << 24) | (static_cast<std::uint32_t>(color.g) << 16) |
+           (static_cast<std::uint32_t>(color.b) << 8) | static_cast<std::uint32_t>(color.a);
+}
+
+}  // namespace
+
+bool TextCache::Key::operator==(const Key& other) const noexcept {
+    return renderer == other.renderer && font == other.font && color == other.color &&
+           wrap_width == other.wrap_width && text == other.text;
+}
+
+std::size_t TextCache::KeyHash::operator()(const Key& key) const noexcept {
+    std::size_t hash = std::hash<std::string>{}(key.text);
+    auto mix = [&hash](std::size_t value) {
+        hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    };
+    mix(std::hash<const void*>{}(key.renderer));
+    mix(std::hash<const void*>{}(key.font));
+    mix(key.color);
+    mix(static_cast<std::size_t>(key.wrap_width));
+    return hash;
+}
+
+TextCache::TextCache(std::size_t byte_budget) : byte_budget_(byte_budget) {}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+TextTexture TextCache::get(SDL_Renderer* renderer,
+                           TTF_Font* font,
+                           const std::string& text,
+                           SDL_Color color,
+                           int wrap_width) {
+    MATCH_ALLOC_SCOPE(Render);
+    if (!renderer || !font || text.empty()) {
+        return {};
+    }
+    Key key{renderer, font, PackColor(color), wrap_width > 0 ? wrap_width : 0, text};
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->value;
+    }
+
+    MATCH_PROFILE_SCOPE("render.text_raster");
+    SDL_Surface* surface = key.wrap_width > 0
+                               ? TTF_RenderUTF8_Blended_Wrapped(font, text.c_str(), color,
+                                                                static_cast<Uint32>(key.wrap_width))
+                               : TTF_RenderUTF8_Blended(font, text.c_str(), color);
+    if (!surface) {
+        return {};
+    }
+    TextTexture value;
+    value.w = surface->w;
+    value.h = surface->h;
+    value.texture = CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!value.texture) {
+        return value;
+    }
+
+    Entry entry;
+    entry.key = std::move(key);
+    entry.value = value;
+    entry.bytes = static_cast<std::size_t>(value.w) * static_cast<std::size_t>(value.h) * 4;
+    entries_.push_front(std::move(entry));
+    index_.emplace(entries_.front().key, entries_.begin());
+    bytes_used_ += entries_.front().bytes;
+    evictToBudget();
+    return value;
+}
+
+void TextCache::clear() {
+    for (auto& entry : entries_) {
+        DestroyTexture(entry.value.texture);
+    }
+    entries_.clear();
+    index_.clear();
+    bytes_used_ = 0;
+}
+
+void TextCache::setByteBudget(std::size_t bytes) {
+    byte_budget_ = bytes;
+    evictToBudget();
+}
+
+void TextCache::evictToBudget() {
+    // The newest entry always survives so the texture just handed out stays
+    // valid even when it alone is over budget.
+    while (bytes_used_ > byte_budget_ && entries_.size() > 1) {
+        Entry& oldest = entries_.back();
+        DestroyTexture(oldest.value.texture);
+        bytes_used_ -= oldest.bytes;
+        index_.erase(oldest.key);
+        entries_.pop_back();
+    }
+}
+
+TextCache& SharedTextCache() {
+    static TextCache cache;
+    return cache;
+}
+
+}  // namespace match::render
@@ -0,0 +1,45 @@
+#include "match/render/TextureStats.hpp"
+
+#include <atomic>
+
+namespace match::render {
+
+namespace {
+
+std::atomic<std::int64_t> g_live{0};
+std::atomic<std::uint64_t> g_created{0};
+
+SDL_Texture* Counted(SDL_Texture* texture) {
+    if (texture) {
+        g_live.fetch_add(1, std::memory_order_relaxed);
+        g_created.fetch_add(1, std::memory_order_relaxed);
+    }
+    return texture;
+}
+
+}  // namespace
+
+SDL_Texture* CreateTexture(SDL_Renderer* renderer, Uint32 format, int access, int w, int h) {
+    return Counted(SDL_CreateTexture(renderer, format, access, w, h));
+}
+
+SDL_Texture* CreateTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface) {
+    return Counted(SDL_CreateTextureFromSurface(renderer, surface));
+}
+
+void DestroyTexture(SDL_Texture* texture) {
+    if (!texture) {
+        return;
+    }
+    SDL_DestroyTexture(texture);
+    g_live.fetch_sub(1, std::memory_order_relaxed);
+}
+
+TextureCounts TextureStats() noexcept {
+    TextureCounts counts;
+    counts.live = g_live.load(std::memory_order_relaxed);
+    counts.created = g_created.load(std::memory_order_relaxed);
+    return counts;
+}
+
+}  // namespace match::render
@@ -16,6 +16,7 @@ namespace match::ui {
 enum class GameMode { PvC, PvP, Tournament };
 enum class TimeModeOption { Classic, Blitz };
 enum class TurnOrderOption { Consecutive, RoundRobin };
+enum class AiDifficultyOption { Easy, Normal, Hard };
 
 inline constexpr int kMinPlayers = 2;
 inline constexpr int kMinMovesPerRound = 1;
@@ -35,6 +36,7 @@ struct GameSettings {
     TimeModeOption time_mode = TimeModeOption::Classic;
     int blitz_turn_minutes = 2;
     int blitz_between_seconds = 10;
+    AiDifficultyOption ai_difficulty = AiDifficultyOption::Normal;
 
     void EnsureConstraints();
     bool player_is_cpu(int index) const;
@@ -119,6 +121,8 @@ struct SaveSummary {
     match::platform::SaveSlotInfo slot;
     bool is_new_entry = false;
     bool valid = true;
+    // Listed from directory metadata only; title and details not read yet.
+    bool pending = false;
     std::string error;
 };
 
@@ -203,6 +207,8 @@ struct SaveSetupState {
     std::vector<SaveSummary> summaries;
     int selected_index = 0;
     int first_visible = 0;
+    // Rows the last RenderSaveSetup had room for, including "new save".
+    int visible_count = 0;
     std::vector<SDL_Rect> entry_bounds;
     std::string error;
     int axis_vertical = 0;
@@ -255,6 +261,7 @@ struct SettingsState {
         TurnOrder,
         Bombs,
         ColorBlast,
+        CpuDifficulty,
         StartGame,
         Back
     };
@@ -395,5 +402,6 @@ void RenderTournamentBracket(SDL_Renderer* renderer,
                              bool using_controller);
 
 std::string ModeToString(GameMode mode);
+std::string DifficultyToString(AiDifficultyOption difficulty);
 
 }  // namespace match::ui
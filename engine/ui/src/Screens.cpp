@@ -11,6 +11,8 @@
 #include <utility>
 #include <vector>
 
+#include "match/render/TextCache.hpp"
+
 namespace match::ui {
 
 namespace {
@@ -178,18 +180,12 @@ void RenderText(SDL_Renderer* renderer,
     if (!renderer || !font || text.empty()) {
         return;
     }
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surface) {
-        return;
-    }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect dst{x, y, surface->w, surface->h};
-    SDL_FreeSurface(surface);
-    if (!texture) {
+    const auto line = match::render::SharedTextCache().get(renderer, font, text, color);
+    if (!line.texture) {
         return;
     }
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    SDL_DestroyTexture(texture);
+    SDL_Rect dst{x, y, line.w, line.h};
+    SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
 }
 
 void RenderFittedText(SDL_Renderer* renderer,
@@ -253,18 +249,13 @@ void RenderTextCenteredInRect(SDL_Renderer* renderer,
     if (!renderer || !font || text.empty()) {
         return;
     }
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surface) {
-        return;
-    }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        SDL_FreeSurface(surface);
+    const auto line = match::render::SharedTextCache().get(renderer, font, text, color);
+    if (!line.texture) {
         return;
     }
     SDL_Rect dst;
-    dst.w = surface->w;
-    dst.h = surface->h;
+    dst.w = line.w;
+    dst.h = line.h;
     dst.x = rect.x + (rect.w - dst.w) / 2;
     dst.y = rect.y + (rect.h - dst.h) / 2;
     if (dst.x < rect.x) {
@@ -279,14 +270,12 @@ void RenderTextCenteredInRect(SDL_Renderer* renderer,
         SDL_RenderGetClipRect(renderer, &prev_clip);
     }
     SDL_RenderSetClipRect(renderer, &rect);
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
+    SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
     if (had_clip) {
         SDL_RenderSetClipRect(renderer, &prev_clip);
     } else {
         SDL_RenderSetClipRect(renderer, nullptr);
     }
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
 }
 
 void RenderCenteredText(SDL_Renderer* renderer,
@@ -345,19 +334,14 @@ void DrawInfoBar(SDL_Renderer* renderer,
             w = 0;
             h = TTF_FontHeight(font);
         }
-        SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), kTextSecondary);
-        if (surface) {
-            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-            if (texture) {
-                SDL_Rect dst;
-                dst.w = std::min(bar.w - UiPx(metrics, 32.0f), surface->w);
-                dst.h = surface->h;
-                dst.x = bar.x + (bar.w - dst.w) / 2;
-                dst.y = bar.y + (bar.h - dst.h) / 2;
-                SDL_RenderCopy(renderer, texture, nullptr, &dst);
-                SDL_DestroyTexture(texture);
-            }
-            SDL_FreeSurface(surface);
+        const auto line = match::render::SharedTextCache().get(renderer, font, text, kTextSecondary);
+        if (line.texture) {
+            SDL_Rect dst;
+            dst.w = std::min(bar.w - UiPx(metrics, 32.0f), line.w);
+            dst.h = line.h;
+            dst.x = bar.x + (bar.w - dst.w) / 2;
+            dst.y = bar.y + (bar.h - dst.h) / 2;
+            SDL_RenderCopy(renderer, line.texture, nullptr, &dst);
         }
     }
 }
@@ -1127,6 +1111,7 @@ void RenderSaveSetup(SDL_Renderer* renderer,
     std::fill(state.entry_bounds.begin(), state.entry_bounds.end(), SDL_Rect{0, 0, 0, 0});
     const int visible_entries = ComputeSaveSetupVisibleCount(metrics);
     ClampSaveSetupScroll(state, visible_entries);
+    state.visible_count = visible_entries;
 
     int y = list_top;
     for (int offset = 0; offset < visible_entries && state.first_visible + offset < total_entries; ++offset) {
@@ -1762,6 +1747,9 @@ void SettingsState::RefreshEntries() {
     entries.push_back(Entry{EntryType::TurnOrder, -1});
     entries.push_back(Entry{EntryType::Bombs, -1});
     entries.push_back(Entry{EntryType::ColorBlast, -1});
+    if (settings.mode != GameMode::PvP) {
+        entries.push_back(Entry{EntryType::CpuDifficulty, -1});
+    }
     entries.push_back(Entry{EntryType::StartGame, -1});
     entries.push_back(Entry{EntryType::Back, -1});
     entry_bounds.assign(entries.size(), SDL_Rect{0, 0, 0, 0});
@@ -1836,6 +1824,15 @@ bool AdjustSetting(SettingsState& state, const SettingsState::Entry& entry, int
                 changed = true;
             }
             break;
+        case SettingsState::EntryType::CpuDifficulty:
+            if (delta != 0) {
+                constexpr int kLevels = 3;
+                const int current = static_cast<int>(state.settings.ai_difficulty);
+                const int next = ((current + (delta > 0 ? 1 : -1)) % kLevels + kLevels) % kLevels;
+                state.settings.ai_difficulty = static_cast<AiDifficultyOption>(next);
+                changed = true;
+            }
+            break;
         default:
             break;
     }
@@ -1858,6 +1855,7 @@ SettingsAction ActivateEntry(SettingsState& state, const SettingsState::Entry& e
         case SettingsState::EntryType::TurnOrder:
         case SettingsState::EntryType::Bombs:
         case SettingsState::EntryType::ColorBlast:
+        case SettingsState::EntryType::CpuDifficulty:
             AdjustSetting(state, entry, +1);
             return SettingsAction::None;
         case SettingsState::EntryType::StartGame:
@@ -1876,6 +1874,7 @@ bool EntryAcceptsAdjustment(const SettingsState::Entry& entry) {
         case SettingsState::EntryType::TurnOrder:
         case SettingsState::EntryType::Bombs:
         case SettingsState::EntryType::ColorBlast:
+        case SettingsState::EntryType::CpuDifficulty:
             return true;
         default:
             return false;
@@ -1905,6 +1904,8 @@ std::string DescribeSettingsEntry(const SettingsState& state, const SettingsStat
             return "Toggle bomb tiles in the match";
         case SettingsState::EntryType::ColorBlast:
             return "Toggle color blast power-ups";
+        case SettingsState::EntryType::CpuDifficulty:
+            return "How far ahead computer players plan their moves";
         case SettingsState::EntryType::StartGame:
             return "Begin the match with current settings";
         case SettingsState::EntryType::Back:
@@ -2201,6 +2202,9 @@ void RenderSettings(SDL_Renderer* renderer,
                 case SettingsState::EntryType::ColorBlast:
                     label = std::string("Color blast: ") + (mutable_state.settings.color_blast_enabled ? "On" : "Off");
                     break;
+                case SettingsState::EntryType::CpuDifficulty:
+                    label = "CPU difficulty: " + DifficultyToString(mutable_state.settings.ai_difficulty);
+                    break;
                 case SettingsState::EntryType::StartGame:
                     label = "START GAME";
                     break;
@@ -3478,6 +3482,18 @@ std::string ModeToString(GameMode mode) {
 
 }
 
+std::string DifficultyToString(AiDifficultyOption difficulty) {
+    switch (difficulty) {
+        case AiDifficultyOption::Easy:
+            return "Easy";
+        case AiDifficultyOption::Normal:
+            return "Normal";
+        case AiDifficultyOption::Hard:
+            return "Hard";
+    }
+    return "Normal";
+}
+
 
 
 }  // namespace match::ui
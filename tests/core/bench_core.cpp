@@ -0,0 +1,349 @@
+// Headless throughput benchmark for match::core. Every board and move comes
+// from fixed seeds, so the work done (and the printed checksum) is identical
+// from run to run; only the timings move.
+//
+//   g++ -std=c++17 -O2 -pthread -Iengine/core/include
+//       engine/core/src/*.cpp tests/core/bench_core.cpp -o bench_core
+//   ./bench_core [--quick] [--csv] [--alloc-gate]
+//
+// Built with -DMATCH_ALLOC_TRACKING=1 it also counts heap allocations made by
+// silent cascades once the scratch is warm; --alloc-gate then exits 1 if any
+// configuration made one.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "match/core/AI.hpp"
+#include "match/core/AllocTracker.hpp"
+#include "match/core/Board.hpp"
+#include "match/core/CascadeBatch.hpp"
+
+using namespace match::core;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    int cols = 8;
+    int rows = 8;
+    int tile_types = 6;
+    bool bombs = false;
+    bool color_chain = false;
+};
+
+struct Report {
+    Config config;
+    double cascades_per_sec = 0.0;
+    double silent_cascades_per_sec = 0.0;
+    // Allocations over every timed silent cascade; always 0 without tracking.
+    std::uint64_t silent_allocs = 0;
+    double batched_cascades_per_sec = 0.0;
+    double find_matches_per_sec = 0.0;
+    double legal_swap_per_sec = 0.0;
+    double legal_swap_local_per_sec = 0.0;
+    double any_legal_per_sec = 0.0;
+    double best_move_p50_ms = 0.0;
+    double best_move_p90_ms = 0.0;
+    double best_move_p99_ms = 0.0;
+    double best_move_max_ms = 0.0;
+    std::uint64_t checksum = 0;
+};
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double Rate(std::size_t calls, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(calls) / seconds : 0.0;
+}
+
+double Percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+}
+
+void Mix(std::uint64_t& hash, std::uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+}
+
+std::vector<Move> LegalMoves(const Board& board) {
+    std::vector<Move> moves;
+    for (int col = 0; col < board.cols(); ++col) {
+        for (int row = 0; row < board.rows(); ++row) {
+            for (const Move move : {Move{{col, row}, {col + 1, row}}, Move{{col, row}, {col, row + 1}}}) {
+                if (LegalSwapLocal(board, move)) {
+                    moves.push_back(move);
+                }
+            }
+        }
+    }
+    return moves;
+}
+
+Report RunConfig(const Config& config, int board_count) {
+    Report report;
+    report.config = config;
+
+    Board::Rules rules;
+    rules.cols = config.cols;
+    rules.rows = config.rows;
+    rules.tile_types = config.tile_types;
+    rules.bombs_enabled = config.bombs;
+    rules.color_chain_enabled = config.color_chain;
+
+    std::vector<Board> boards;
+    std::vector<std::vector<Move>> moves;
+    for (int i = 0; i < board_count; ++i) {
+        boards.push_back(NewBoard(rules, static_cast<std::uint32_t>(1000 + i)));
+        moves.push_back(LegalMoves(boards.back()));
+    }
+
+    // Swapped boards give FindAllMatches real groups to assemble.
+    std::vector<Board> swapped;
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        for (const auto& move : moves[i]) {
+            swapped.push_back(boards[i]);
+            swapped.back().swapCells(move);
+        }
+    }
+
+    std::uint64_t checksum = 0;
+    std::size_t calls = 0;
+
+    auto start = Clock::now();
+    Board sim_board;
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        for (const auto& move : moves[i]) {
+            sim_board = boards[i];
+            const auto result = SimulateFullChain(sim_board, move);
+            Mix(checksum, static_cast<std::uint64_t>(result.score));
+            Mix(checksum, result.fall_events.size());
+            ++calls;
+        }
+    }
+    report.cascades_per_sec = Rate(calls, SecondsSince(start));
+
+    // An untimed pass first grows the scratch to the largest cascade, so the
+    // timed pass shows the steady state.
+    SimulationScratch scratch;
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        for (const auto& move : moves[i]) {
+            sim_board = boards[i];
+            SimulateFullChain(sim_board, move, scratch, SimulationEvents::Skip);
+        }
+    }
+
+    calls = 0;
+    const std::uint64_t allocs_before = AllocTotals().allocations;
+    start = Clock::now();
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        for (const auto& move : moves[i]) {
+            sim_board = boards[i];
+            const auto result = SimulateFullChain(sim_board, move, scratch, SimulationEvents::Skip);
+            Mix(checksum, static_cast<std::uint64_t>(result.score));
+            ++calls;
+        }
+    }
+    report.silent_cascades_per_sec = Rate(calls, SecondsSince(start));
+    report.silent_allocs = AllocTotals().allocations - allocs_before;
+
+    calls = 0;
+    CascadeBatch batch;
+    start = Clock::now();
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        batch.clear();
+        for (const auto& move : moves[i]) {
+            batch.add(boards[i], move);
+        }
+        batch.run();
+        for (std::size_t m = 0; m < batch.size(); ++m) {
+            Mix(checksum, static_cast<std::uint64_t>(batch.totals(m).score()));
+            ++calls;
+        }
+    }
+    report.batched_cascades_per_sec = Rate(calls, SecondsSince(start));
+
+    calls = 0;
+    start = Clock::now();
+    for (int repeat = 0; repeat < 4; ++repeat) {
+        for (const auto& board : swapped) {
+            Mix(checksum, FindAllMatches(board).size());
+            ++calls;
+        }
+    }
+    report.find_matches_per_sec = Rate(calls, SecondsSince(start));
+
+    calls = 0;
+    start = Clock::now();
+    for (auto& board : boards) {
+        for (int col = 0; col < board.cols(); ++col) {
+            for (int row = 0; row < board.rows(); ++row) {
+                for (const Move move : {Move{{col, row}, {col + 1, row}}, Move{{col, row}, {col, row + 1}}}) {
+                    Mix(checksum, LegalSwap(board, move, scratch));
+                    ++calls;
+                }
+            }
+        }
+    }
+    report.legal_swap_per_sec = Rate(calls, SecondsSince(start));
+
+    calls = 0;
+    start = Clock::now();
+    for (int repeat = 0; repeat < 8; ++repeat) {
+        for (const auto& board : boards) {
+            for (int col = 0; col < board.cols(); ++col) {
+                for (int row = 0; row < board.rows(); ++row) {
+                    for (const Move move : {Move{{col, row}, {col + 1, row}}, Move{{col, row}, {col, row + 1}}}) {
+                        Mix(checksum, LegalSwapLocal(board, move));
+                        ++calls;
+                    }
+                }
+            }
+        }
+    }
+    report.legal_swap_local_per_sec = Rate(calls, SecondsSince(start));
+
+    calls = 0;
+    start = Clock::now();
+    for (int repeat = 0; repeat < 64; ++repeat) {
+        for (const auto& board : boards) {
+            Mix(checksum, AnyLegalMoves(board));
+            ++calls;
+        }
+    }
+    report.any_legal_per_sec = Rate(calls, SecondsSince(start));
+
+    std::vector<double> latencies;
+    latencies.reserve(boards.size());
+    for (const auto& board : boards) {
+        const auto begin = Clock::now();
+        const auto best = ai::BestMove(board);
+        latencies.push_back(SecondsSince(begin) * 1000.0);
+        if (best) {
+            Mix(checksum, static_cast<std::uint64_t>(best->score));
+        }
+    }
+    report.best_move_p50_ms = Percentile(latencies, 0.50);
+    report.best_move_p90_ms = Percentile(latencies, 0.90);
+    report.best_move_p99_ms = Percentile(latencies, 0.99);
+    report.best_move_max_ms = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+
+    report.checksum = checksum;
+    return report;
+}
+
+std::string RulesLabel(const Config& config) {
+    if (config.bombs && config.color_chain) {
+        return "bomb+color";
+    }
+    if (config.bombs) {
+        return "bomb";
+    }
+    if (config.color_chain) {
+        return "color";
+    }
+    return "plain";
+}
+
+void PrintTable(const std::vector<Report>& reports) {
+    std::printf("%-7s %-5s %-10s %11s %11s %7s %11s %11s %11s %11s %11s %8s %8s %8s %8s  %s\n", "board",
+                "tiles", "rules", "cascade/s", "silent/s", "allocs", "batched/s", "matches/s", "swap/s",
+                "local/s", "anylegal/s", "ai p50", "ai p90", "ai p99", "ai max", "checksum");
+    for (const auto& r : reports) {
+        const std::string size = std::to_string(r.config.cols) + "x" + std::to_string(r.config.rows);
+        const std::string allocs = kAllocTracking ? std::to_string(r.silent_allocs) : "-";
+        std::printf(
+            "%-7s %-5d %-10s %11.0f %11.0f %7s %11.0f %11.0f %11.0f %11.0f %11.0f %8.3f %8.3f %8.3f %8.3f  %016llx\n",
+            size.c_str(), r.config.tile_types, RulesLabel(r.config).c_str(), r.cascades_per_sec,
+            r.silent_cascades_per_sec, allocs.c_str(), r.batched_cascades_per_sec, r.find_matches_per_sec, r.legal_swap_per_sec,
+            r.legal_swap_local_per_sec, r.any_legal_per_sec, r.best_move_p50_ms, r.best_move_p90_ms,
+            r.best_move_p99_ms, r.best_move_max_ms, static_cast<unsigned long long>(r.checksum));
+    }
+}
+
+void PrintCsv(const std::vector<Report>& reports) {
+    std::printf("cols,rows,tiles,bombs,color_chain,cascades_per_sec,silent_cascades_per_sec,silent_allocs,"
+                "batched_cascades_per_sec,find_matches_per_sec,legal_swap_per_sec,legal_swap_local_per_sec,any_legal_per_sec,"
+                "best_move_p50_ms,best_move_p90_ms,best_move_p99_ms,best_move_max_ms,checksum\n");
+    for (const auto& r : reports) {
+        std::printf("%d,%d,%d,%d,%d,%.1f,%.1f,%llu,%.1f,%.1f,%.1f,%.1f,%.1f,%.4f,%.4f,%.4f,%.4f,%016llx\n",
+                    r.config.cols, r.config.rows, r.config.tile_types, r.config.bombs ? 1 : 0,
+                    r.config.color_chain ? 1 : 0, r.cascades_per_sec, r.silent_cascades_per_sec,
+                    static_cast<unsigned long long>(r.silent_allocs), r.batched_cascades_per_sec,
+                    r.find_matches_per_sec, r.legal_swap_per_sec,
+                    r.legal_swap_local_per_sec, r.any_legal_per_sec, r.best_move_p50_ms, r.best_move_p90_ms,
+                    r.best_move_p99_ms, r.best_move_max_ms, static_cast<unsigned long long>(r.checksum));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    bool csv = false;
+    bool alloc_gate = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (std::strcmp(argv[i], "--alloc-gate") == 0) {
+            alloc_gate = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick] [--csv] [--alloc-gate]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (alloc_gate && !kAllocTracking) {
+        std::fprintf(stderr, "--alloc-gate needs a build with -DMATCH_ALLOC_TRACKING=1\n");
+        return 2;
+    }
+
+    const std::vector<std::pair<int, int>> sizes =
+        quick ? std::vector<std::pair<int, int>>{{8, 8}, {20, 20}}
+              : std::vector<std::pair<int, int>>{{8, 8}, {12, 12}, {20, 20}, {32, 32}};
+    const std::vector<int> tile_counts = quick ? std::vector<int>{6} : std::vector<int>{4, 6};
+    const int board_count = quick ? 8 : 32;
+
+    std::vector<Report> reports;
+    for (const auto& [cols, rows] : sizes) {
+        for (const int tiles : tile_counts) {
+            for (int rules = 0; rules < 4; ++rules) {
+                Config config;
+                config.cols = cols;
+                config.rows = rows;
+                config.tile_types = tiles;
+                config.bombs = (rules & 1) != 0;
+                config.color_chain = (rules & 2) != 0;
+                reports.push_back(RunConfig(config, board_count));
+            }
+        }
+    }
+
+    if (csv) {
+        PrintCsv(reports);
+    } else {
+        PrintTable(reports);
+    }
+    if (alloc_gate) {
+        for (const auto& r : reports) {
+            if (r.silent_allocs != 0) {
+                std::fprintf(stderr, "alloc gate: %dx%d %s made %llu allocations in steady-state cascades\n",
+                             r.config.cols, r.config.rows, RulesLabel(r.config).c_str(),
+                             static_cast<unsigned long long>(r.silent_allocs));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -1,8 +1,36 @@
+// Core unit tests. Run both builds: the second swaps in the counting
+// operator new and delete, which only TestAllocScopesAndCounters exercises.
+//
+//   g++ -std=c++17 -O2 -pthread -Iengine/core/include
+//       engine/core/src/*.cpp tests/core/test_board.cpp -o test_core
+//   g++ -std=c++17 -O2 -pthread -DMATCH_ALLOC_TRACKING=1 -Iengine/core/include
+//       engine/core/src/*.cpp tests/core/test_board.cpp -o test_core_alloc
+
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "match/core/AI.hpp"
+#include "match/core/AllocTracker.hpp"
+#include "match/core/AsyncSearch.hpp"
 #include "match/core/Board.hpp"
+#include "match/core/BoardPool.hpp"
+#include "match/core/CascadeBatch.hpp"
+#include "match/core/Json.hpp"
+#include "match/core/LegalMoveIndex.hpp"
+#include "match/core/MatchSession.hpp"
+#include "match/core/Profiler.hpp"
+#include "match/core/Replay.hpp"
+#include "match/core/SaveGame.hpp"
+#include "match/core/SelfPlay.hpp"
+#include "match/core/WorkerPool.hpp"
 
 using namespace match::core;
 
@@ -21,6 +49,45 @@ void TestNewBoardNoInitialMatches() {
     }
 }
 
+void TestNewBoardAlwaysPlayable() {
+    for (int tiles = 4; tiles <= 7; ++tiles) {
+        for (int size = 4; size <= 16; size += 4) {
+            for (std::uint32_t seed = 0; seed < 40; ++seed) {
+                Board::Rules rules;
+                rules.cols = size;
+                rules.rows = size + static_cast<int>(seed % 3);
+                rules.tile_types = tiles;
+                rules.bombs_enabled = seed % 2 == 0;
+                rules.color_chain_enabled = seed % 4 == 0;
+                const Board board = NewBoard(rules, seed);
+                assert(FindAllMatches(board).empty());
+                assert(AnyLegalMoves(board));
+                for (int c = 0; rules.bombs_enabled && c + 1 < board.cols(); ++c) {
+                    for (int r = 0; r + 1 < board.rows(); ++r) {
+                        const int t = board.get(c, r);
+                        assert(!(board.get(c + 1, r) == t && board.get(c, r + 1) == t &&
+                                 board.get(c + 1, r + 1) == t));
+                    }
+                }
+            }
+        }
+    }
+
+    Board::Rules rules;
+    rules.cols = 8;
+    rules.rows = 8;
+    rules.bombs_enabled = true;
+    BoardPool pool(/*depth=*/2);
+    pool.prefill(rules);
+    for (int i = 0; i < 4; ++i) {
+        const BoardPool::Entry entry = pool.take(rules);
+        const Board rebuilt = NewBoard(rules, entry.seed);
+        assert(entry.board.cols() == 8 && entry.board.bombsEnabled());
+        assert(BoardDigest(entry.board) == BoardDigest(rebuilt));
+    }
+    assert(pool.ready(rules) <= 2);
+}
+
 Board MakeTestBoard() {
     Board::Rules rules;
     rules.cols = 3;
@@ -46,12 +113,123 @@ Board MakeTestBoard() {
     return board;
 }
 
+void TestTileStorageRange() {
+    auto board = MakeTestBoard();
+    board.set(0, 0, kMaxTileValue);
+    assert(board.get(0, 0) == kMaxTileValue);
+    board.set(0, 0, kMaxTileValue + 1);
+    assert(board.get(0, 0) == kEmptyCell);
+    board.set(0, 0, -7);
+    assert(board.get(0, 0) == kEmptyCell);
+}
+
 void TestFindAllMatches() {
     auto board = MakeTestBoard();
     auto matches = FindAllMatches(board);
     assert(matches.empty());
 }
 
+// The set-based merge FindAllMatches used before the bitboard planes; kept as
+// the oracle for group contents and ordering.
+std::vector<MatchGroup> ReferenceFindAllMatches(const Board& board) {
+    using CellSet = std::set<Cell>;
+    auto overlap = [](const CellSet& a, const CellSet& b) {
+        for (const auto& cell : a) {
+            if (b.count(cell) > 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+    std::vector<CellSet> groups;
+    for (int row = 0; row < board.rows(); ++row) {
+        for (int col = 0; col < board.cols();) {
+            const int tile = board.get(col, row);
+            int end = col;
+            while (end + 1 < board.cols() && board.get(end + 1, row) == tile) {
+                ++end;
+            }
+            if (tile != kEmptyCell && end - col + 1 >= 3) {
+                CellSet group;
+                for (int c = col; c <= end; ++c) {
+                    group.insert(Cell{c, row});
+                }
+                groups.push_back(group);
+            }
+            col = end + 1;
+        }
+    }
+    for (int col = 0; col < board.cols(); ++col) {
+        for (int row = 0; row < board.rows();) {
+            const int tile = board.get(col, row);
+            int end = row;
+            while (end + 1 < board.rows() && board.get(col, end + 1) == tile) {
+                ++end;
+            }
+            if (tile != kEmptyCell && end - row + 1 >= 3) {
+                CellSet group;
+                for (int r = row; r <= end; ++r) {
+                    group.insert(Cell{col, r});
+                }
+                groups.push_back(group);
+            }
+            row = end + 1;
+        }
+    }
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        std::vector<CellSet> out;
+        while (!groups.empty()) {
+            CellSet current = groups.back();
+            groups.pop_back();
+            bool expanded = true;
+            while (expanded) {
+                expanded = false;
+                for (auto it = groups.begin(); it != groups.end();) {
+                    if (overlap(current, *it)) {
+                        current.insert(it->begin(), it->end());
+                        it = groups.erase(it);
+                        expanded = merged = true;
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            out.push_back(current);
+        }
+        groups = out;
+    }
+    std::vector<MatchGroup> result;
+    for (const auto& set : groups) {
+        result.emplace_back(set.begin(), set.end());
+    }
+    return result;
+}
+
+void TestFindAllMatchesMatchesReference() {
+    std::mt19937 rng(2024);
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        Board::Rules rules;
+        rules.cols = 3 + static_cast<int>(rng() % 10);
+        rules.rows = 3 + static_cast<int>(rng() % 10);
+        rules.tile_types = 2 + static_cast<int>(rng() % 3);
+        Board board(rules, /*seed=*/iteration);
+        for (int c = 0; c < board.cols(); ++c) {
+            for (int r = 0; r < board.rows(); ++r) {
+                const bool hole = (rng() % 9) == 0;
+                board.set(c, r, hole ? kEmptyCell : static_cast<int>(rng() % rules.tile_types));
+            }
+        }
+        const auto expected = ReferenceFindAllMatches(board);
+        const auto actual = FindAllMatches(board);
+        assert(actual.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            assert(actual[i] == expected[i]);
+        }
+    }
+}
+
 void TestLegalSwapAndSimulate() {
     auto board = MakeTestBoard();
     Move move{{1, 2}, {0, 2}};  // Swap bottom cells in columns 1 and 0.
@@ -64,6 +242,639 @@ void TestLegalSwapAndSimulate() {
     assert(result.chains == 1);
 }
 
+void TestScratchSimulationMatchesRecorded() {
+    SimulationScratch scratch;
+    for (std::uint32_t seed = 0; seed < 60; ++seed) {
+        Board::Rules rules;
+        rules.cols = 6 + static_cast<int>(seed % 5);
+        rules.rows = 6 + static_cast<int>(seed % 3);
+        rules.tile_types = 4 + static_cast<int>(seed % 3);
+        rules.bombs_enabled = (seed % 2) == 0;
+        rules.color_chain_enabled = (seed % 3) == 0;
+        const Board board = NewBoard(rules, seed);
+        for (int c = 0; c + 1 < board.cols(); ++c) {
+            for (int r = 0; r < board.rows(); ++r) {
+                const Move move{{c, r}, {c + 1, r}};
+                Board legal_board = board;
+                if (!LegalSwap(legal_board, move, scratch)) {
+                    continue;
+                }
+                Board recorded_board = board;
+                Board skipped_board = board;
+                const auto recorded = SimulateFullChain(recorded_board, move);
+                const auto skipped =
+                    SimulateFullChain(skipped_board, move, scratch, SimulationEvents::Skip);
+                assert(skipped.score == recorded.score);
+                assert(skipped.total_cleared == recorded.total_cleared);
+                assert(skipped.chains == recorded.chains);
+                assert(skipped.bombs_triggered == recorded.bombs_triggered);
+                assert(skipped.color_chain_triggered == recorded.color_chain_triggered);
+                assert(skipped.chain_events.empty() && skipped.clear_events.empty());
+                assert(static_cast<int>(recorded.chain_events.size()) == recorded.chains);
+                for (int cc = 0; cc < board.cols(); ++cc) {
+                    for (int rr = 0; rr < board.rows(); ++rr) {
+                        assert(skipped_board.get(cc, rr) == recorded_board.get(cc, rr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void TestStepChainMatchesFullChain() {
+    SimulationScratch scratch;
+    for (std::uint32_t seed = 0; seed < 40; ++seed) {
+        Board::Rules rules;
+        rules.cols = 7 + static_cast<int>(seed % 4);
+        rules.rows = 7;
+        rules.tile_types = 4 + static_cast<int>(seed % 3);
+        rules.bombs_enabled = (seed % 2) == 1;
+        rules.color_chain_enabled = (seed % 4) == 0;
+        const Board board = NewBoard(rules, seed);
+        for (int c = 0; c < board.cols(); ++c) {
+            for (int r = 0; r + 1 < board.rows(); ++r) {
+                const Move move{{c, r}, {c, r + 1}};
+                if (!LegalSwapLocal(board, move)) {
+                    continue;
+                }
+                Board full_board = board;
+                const auto full = SimulateFullChain(full_board, move);
+
+                Board stepped_board = board;
+                stepped_board.swapCells(move);
+                CascadeTotals totals;
+                SimulationResult::ChainEvent chain;
+                std::size_t index = 0;
+                while (StepChain(stepped_board, scratch, totals, &chain)) {
+                    assert(index < full.chain_events.size());
+                    const auto& expected = full.chain_events[index++];
+                    assert(chain.clears.size() == expected.clears.size());
+                    // Reused ClearEvents must hold only this chain's cells.
+                    for (std::size_t i = 0; i < chain.clears.size(); ++i) {
+                        const auto& got = chain.clears[i];
+                        const auto& want = expected.clears[i];
+                        assert(got.via_bomb == want.via_bomb && got.via_color == want.via_color);
+                        assert(got.cells.size() == want.cells.size());
+                        for (std::size_t k = 0; k < got.cells.size(); ++k) {
+                            assert(got.cells[k].position == want.cells[k].position);
+                            assert(got.cells[k].tile == want.cells[k].tile);
+                        }
+                    }
+                    assert(chain.falls.size() == expected.falls.size());
+                    assert(chain.spawns.size() == expected.spawns.size());
+                    for (std::size_t i = 0; i < chain.spawns.size(); ++i) {
+                        assert(chain.spawns[i].tile == expected.spawns[i].tile);
+                    }
+                }
+                assert(index == full.chain_events.size());
+                assert(totals.chains == full.chains);
+                assert(totals.score() == full.score);
+                assert(totals.total_cleared == full.total_cleared);
+                for (int cc = 0; cc < board.cols(); ++cc) {
+                    for (int rr = 0; rr < board.rows(); ++rr) {
+                        assert(stepped_board.get(cc, rr) == full_board.get(cc, rr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void TestStepChainSkipsUntouchedColumns() {
+    Board::Rules rules;
+    rules.cols = 96;
+    rules.rows = 64;
+    rules.bombs_enabled = true;
+    Board board = NewBoard(rules, 2024);
+    LegalMoveIndex legal_moves(board);
+    SimulationScratch scratch;
+    for (int turn = 0; turn < 20 && legal_moves.any(); ++turn) {
+        board.swapCells(legal_moves.moves().front());
+        CascadeTotals totals;
+        SimulationResult::ChainEvent chain;
+        Board before = board;
+        while (StepChain(board, scratch, totals, &chain)) {
+            std::vector<bool> cleared(static_cast<std::size_t>(board.cols()), false);
+            for (const auto& clear : chain.clears) {
+                for (const auto& cell : clear.cells) {
+                    cleared[static_cast<std::size_t>(cell.position.col)] = true;
+                }
+            }
+            for (int c = 0; c < board.cols(); ++c) {
+                for (int r = 0; !cleared[static_cast<std::size_t>(c)] && r < board.rows(); ++r) {
+                    assert(board.get(c, r) == before.get(c, r));
+                }
+            }
+            before = board;
+        }
+        legal_moves.rebuild(board);
+    }
+
+    // A hole left by hand in a column nothing clears still gets filled.
+    Board holed = NewBoard(rules, 7);
+    holed.set(0, 10, kEmptyCell);
+    Move move{};
+    for (const Move& candidate : LegalMoveIndex(holed).moves()) {
+        if (candidate.a.col > 4 && candidate.b.col > 4) {
+            move = candidate;
+            break;
+        }
+    }
+    assert(move.a.col > 4);
+    holed.swapCells(move);
+    CascadeTotals totals;
+    while (StepChain(holed, scratch, totals)) {
+    }
+    for (int r = 0; r < holed.rows(); ++r) {
+        assert(holed.get(0, r) != kEmptyCell);
+    }
+}
+
+void TestCascadeBatchMatchesSimulateFullChain() {
+    SimulationScratch scratch;
+    CascadeBatch batch;
+    int cascades = 0;
+    for (std::uint32_t seed = 0; seed < 24; ++seed) {
+        Board::Rules rules;
+        rules.cols = 5 + static_cast<int>(seed % 5) * 2;
+        rules.rows = 6 + static_cast<int>(seed % 3) * 3;
+        rules.tile_types = 4 + static_cast<int>(seed % 3);
+        rules.bombs_enabled = (seed % 2) == 1;
+        rules.color_chain_enabled = (seed % 4) >= 2;
+        Board board = NewBoard(rules, 300 + seed);
+        if (seed % 6 == 5) {
+            // A hole and a tile outside the set, as hand-built boards have.
+            board.set(1, 2, kEmptyCell);
+            board.set(0, board.rows() - 1, rules.tile_types);
+        }
+
+        // Every swap either way, plus one between non-neighbours.
+        std::vector<Move> moves{Move{{0, 0}, {2, 0}}};
+        for (int c = 0; c < board.cols(); ++c) {
+            for (int r = 0; r < board.rows(); ++r) {
+                if (c + 1 < board.cols()) {
+                    moves.push_back(Move{{c, r}, {c + 1, r}});
+                    moves.push_back(Move{{c + 1, r}, {c, r}});
+                }
+                if (r + 1 < board.rows()) {
+                    moves.push_back(Move{{c, r}, {c, r + 1}});
+                }
+            }
+        }
+
+        // More rollouts than lanes, so settled lanes are refilled mid-run.
+        std::vector<std::mt19937> rngs;
+        std::vector<Board> results(moves.size(), board);
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            rngs.emplace_back(seed * 1000 + static_cast<std::uint32_t>(i));
+        }
+        batch.clear();
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            const std::mt19937* rng = (i % 3 == 0) ? &rngs[i] : nullptr;
+            assert(batch.add(board, moves[i], rng, &results[i]) == static_cast<int>(i));
+        }
+        batch.run();
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            Board expected = board;
+            if (i % 3 == 0) {
+                expected.rng() = rngs[i];
+            }
+            const auto result = SimulateFullChain(expected, moves[i], scratch, SimulationEvents::Skip);
+            const CascadeTotals& totals = batch.totals(i);
+            assert(totals.score() == result.score);
+            assert(totals.total_cleared == result.total_cleared);
+            assert(totals.chains == result.chains);
+            assert(totals.bombs_triggered == result.bombs_triggered);
+            assert(totals.color_chain_triggered == result.color_chain_triggered);
+            cascades += result.chains > 0;
+            for (int c = 0; c < board.cols(); ++c) {
+                for (int r = 0; r < board.rows(); ++r) {
+                    assert(results[i].get(c, r) == expected.get(c, r));
+                }
+            }
+            assert(results[i].rng() == expected.rng());
+        }
+    }
+    assert(cascades > 100);
+
+    // Lanes must share a shape and rule set.
+    Board::Rules other;
+    other.cols = 6;
+    other.rows = 6;
+    const Board plain = NewBoard(other, 1);
+    other.bombs_enabled = true;
+    const Board bombs = NewBoard(other, 2);
+    batch.clear();
+    assert(batch.add(plain, Move{{0, 0}, {1, 0}}) == 0);
+    assert(batch.add(bombs, Move{{0, 0}, {1, 0}}) == -1);
+}
+
+void TestLocalLegalSwapMatchesFullScan() {
+    for (std::uint32_t seed = 0; seed < 80; ++seed) {
+        Board::Rules rules;
+        rules.cols = 5 + static_cast<int>(seed % 7);
+        rules.rows = 5 + static_cast<int>(seed % 4);
+        rules.tile_types = 4 + static_cast<int>(seed % 3);
+        rules.bombs_enabled = (seed % 2) == 1;
+        rules.color_chain_enabled = (seed % 4) == 0;
+        Board board = NewBoard(rules, seed);
+        // A resolved cascade always leaves a settled board behind.
+        for (int c = 0; c + 1 < board.cols(); ++c) {
+            const Move opener{{c, 0}, {c + 1, 0}};
+            Board probe = board;
+            if (LegalSwap(probe, opener)) {
+                SimulateFullChain(board, opener);
+                break;
+            }
+        }
+        if (!FindAllMatches(board).empty()) {
+            continue;
+        }
+        for (int c = 0; c < board.cols(); ++c) {
+            for (int r = 0; r < board.rows(); ++r) {
+                for (const Move move : {Move{{c, r}, {c + 1, r}}, Move{{c, r}, {c, r + 1}}}) {
+                    Board full = board;
+                    assert(LegalSwapLocal(board, move) == LegalSwap(full, move));
+                }
+            }
+        }
+    }
+}
+
+void TestLegalMoveIndexTracksCascades() {
+    for (std::uint32_t seed = 0; seed < 12; ++seed) {
+        Board::Rules rules;
+        rules.cols = 7 + static_cast<int>(seed % 4);
+        rules.rows = 6 + static_cast<int>(seed % 5);
+        rules.tile_types = 5;
+        rules.bombs_enabled = (seed % 2) == 0;
+        rules.color_chain_enabled = (seed % 3) == 1;
+        Board board = NewBoard(rules, seed);
+        LegalMoveIndex index(board);
+        for (int turn = 0; turn < 15 && index.any(); ++turn) {
+            const auto candidates = index.moves();
+            const Move move = candidates[static_cast<std::size_t>(turn) % candidates.size()];
+            const auto result = SimulateFullChain(board, move);
+            index.update(board, result);
+
+            const LegalMoveIndex fresh(board);
+            assert(index.count() == fresh.count());
+            const auto expected = fresh.moves();
+            const auto actual = index.moves();
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                assert(actual[i].a == expected[i].a && actual[i].b == expected[i].b);
+            }
+            assert(index.any() == AnyLegalMoves(board));
+            const auto indexed_best = match::core::ai::BestMove(board, index);
+            const auto scanned_best = match::core::ai::BestMove(board);
+            assert(indexed_best.has_value() == scanned_best.has_value());
+            if (indexed_best) {
+                assert(indexed_best->move.a == scanned_best->move.a);
+                assert(indexed_best->move.b == scanned_best->move.b);
+                assert(indexed_best->score == scanned_best->score);
+            }
+        }
+    }
+}
+
+void TestSearchBestMove() {
+    Board::Rules rules;
+    rules.cols = 8;
+    rules.rows = 8;
+    rules.tile_types = 5;
+    rules.bombs_enabled = true;
+    const Board board = NewBoard(rules, /*seed=*/21);
+
+    const auto greedy = match::core::ai::BestMove(board);
+    const auto easy = match::core::ai::SearchBestMove(
+        board, match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Easy));
+    assert(greedy && easy);
+    assert(easy->move.a == greedy->move.a && easy->move.b == greedy->move.b);
+
+    auto options = match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Hard);
+    options.time_budget_ms = 1000;
+    const auto hard = match::core::ai::SearchBestMove(board, options);
+    assert(hard.has_value());
+    assert(LegalSwapLocal(board, hard->move));
+    Board replay = board;
+    assert(hard->score == SimulateFullChain(replay, hard->move).score);
+
+    // A spent budget still returns the greedy choice, with no deeper work.
+    options.time_budget_ms = 0;
+    const auto rushed = match::core::ai::SearchBestMove(board, options);
+    assert(rushed && rushed->move.a == greedy->move.a && rushed->move.b == greedy->move.b);
+}
+
+void TestAsyncMoveSearch() {
+    Board::Rules rules;
+    rules.cols = 9;
+    rules.rows = 9;
+    rules.tile_types = 5;
+    const Board board = NewBoard(rules, /*seed=*/5);
+    const auto options = match::core::ai::SearchOptionsFor(match::core::ai::Difficulty::Easy);
+
+    match::core::ai::AsyncMoveSearch search;
+    auto superseded = search.start(board, options);
+    auto latest = search.start(board, LegalMoveIndex(board), options);
+    const auto result = latest.get();
+    assert(!result.cancelled && result.best.has_value());
+    const auto expected = match::core::ai::SearchBestMove(board, options);
+    assert(result.best->move.a == expected->move.a && result.best->move.b == expected->move.b);
+    // The first request either finished before the second arrived or was
+    // cancelled by it; either way its future resolves.
+    superseded.wait();
+
+    auto cancelled = search.start(board, options);
+    search.cancel();
+    const auto outcome = cancelled.get();
+    assert(outcome.cancelled || outcome.best.has_value());
+}
+
+void TestSelfPlayBatch() {
+    match::core::SelfPlayBatch batch;
+    batch.rules.board.cols = 8;
+    batch.rules.board.rows = 8;
+    batch.rules.rounds = 2;
+    batch.rules.moves_per_round = 2;
+    batch.rules.turn_order = match::core::TurnOrder::RoundRobin;
+    batch.games = 6;
+    batch.first_seed = 40;
+
+    // A threaded batch hands games over in order, each identical to playing
+    // that seed on its own.
+    match::core::WorkerPool pool(2);
+    std::vector<match::core::SelfPlayGame> games;
+    match::core::RunSelfPlayBatch(batch, [&](const match::core::SelfPlayGame& game) { games.push_back(game); },
+                                  pool);
+    assert(games.size() == batch.games);
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        const auto solo = match::core::PlaySelfPlayGame(batch.rules, batch.seats, batch.first_seed + i);
+        assert(games[i].index == i);
+        assert(games[i].scores == solo.scores);
+        assert(games[i].winner == solo.winner);
+        if (!solo.stalled) {
+            assert(solo.moves == 8);
+            assert(solo.rounds_played == 2);
+        }
+    }
+}
+
+void TestSessionHost() {
+    match::core::MatchRules rules;
+    rules.board.cols = 8;
+    rules.board.rows = 8;
+    rules.players = 3;
+    rules.rounds = 2;
+    rules.moves_per_round = 2;
+
+    // Consecutive turns: a seat keeps the board until its moves run out, and
+    // a forfeit hands it on at once.
+    match::core::TurnState turns = match::core::StartTurns(rules);
+    match::core::EndTurn(rules, turns);
+    assert(turns.active_player == 0 && turns.moves_left[0] == 1);
+    match::core::EndTurn(rules, turns, true);
+    assert(turns.active_player == 1 && turns.moves_left[0] == 0);
+
+    match::core::WorkerPool pool(3);
+    match::core::SessionHost host(pool);
+    for (std::uint32_t seed = 10; seed < 40; ++seed) {
+        host.open(rules, seed);
+    }
+    match::core::SessionHost::Seat remote;
+    remote.remote = true;
+    const auto waiting = host.open(rules, 99, {remote});
+    host.runToCompletion();
+
+    for (std::uint32_t seed = 10; seed < 40; ++seed) {
+        const auto& session = host.session(seed - 10);
+        const auto solo = match::core::PlaySelfPlayGame(rules, {}, seed);
+        assert(session.gameOver() && session.scores() == solo.scores);
+        assert(match::core::PlayReplay(session.replay()).ok());
+    }
+
+    // The remote seat holds its session until a move arrives.
+    assert(!host.session(waiting).gameOver() && host.session(waiting).replay().moves.empty());
+    host.submit(waiting, {{0, 0}, {3, 3}});
+    host.submit(waiting, *host.session(waiting).legalMoves().hint());
+    host.advance();
+    assert(host.session(waiting).replay().moves.size() == 1);
+    assert(host.session(waiting).activePlayer() == 0);
+}
+
+void TestProfilerStatsAndTrace() {
+    auto& profiler = match::core::Profiler::Instance();
+    profiler.clear();
+    for (std::uint64_t i = 1; i <= 100; ++i) {
+        profiler.record("test.phase", i * 10, i * 1000);
+    }
+    const auto stats = profiler.phaseStats();
+    assert(stats.size() == 1);
+    assert(stats[0].name == "test.phase");
+    assert(stats[0].samples == 100);
+    assert(stats[0].average_ms > 50.4 && stats[0].average_ms < 50.6);
+    assert(stats[0].p99_ms > 98.9 && stats[0].p99_ms < 99.1);
+    assert(stats[0].last_ms > 99.9);
+
+    const std::string path = "profiler_trace_test.json";
+    assert(profiler.writeChromeTrace(path));
+    std::ifstream in(path);
+    const auto trace = match::core::Json::parse(in);
+    assert(trace["traceEvents"].size() == 100);
+    assert(trace["traceEvents"][0]["ph"] == "X");
+    in.close();
+    std::remove(path.c_str());
+    profiler.clear();
+}
+
+void TestAllocScopesAndCounters() {
+    assert(CurrentAllocDomain() == AllocDomain::Other);
+    {
+        AllocScope ai(AllocDomain::AI);
+        {
+            AllocScope save(AllocDomain::Save);
+            assert(CurrentAllocDomain() == AllocDomain::Save);
+        }
+        assert(CurrentAllocDomain() == AllocDomain::AI);
+
+        // Pool workers run each task in the caller's domain.
+        match::core::WorkerPool pool(2);
+        std::vector<int> domains(16, -1);
+        pool.parallelFor(domains.size(), [&](std::size_t index, unsigned) {
+            domains[index] = static_cast<int>(CurrentAllocDomain());
+        });
+        for (const int domain : domains) {
+            assert(domain == static_cast<int>(AllocDomain::AI));
+        }
+
+        const AllocCounters before = AllocStats(AllocDomain::AI);
+        // Direct operator new/delete calls, which -fallocation-dce may not
+        // remove the way it drops an unused new-expression pair at -O2.
+        void* block = ::operator new(256);
+        const AllocCounters during = AllocStats(AllocDomain::AI);
+        ::operator delete(block);
+        const AllocCounters after = AllocStats(AllocDomain::AI);
+        if (kAllocTracking) {
+            assert(during.allocations == before.allocations + 1);
+            assert(during.live_bytes == before.live_bytes + 256);
+            assert(after.frees == before.frees + 1);
+            assert(after.live_bytes == before.live_bytes);
+        } else {
+            assert(after.allocations == 0 && after.live_bytes == 0);
+        }
+    }
+    assert(CurrentAllocDomain() == AllocDomain::Other);
+    assert(std::string(AllocDomainName(AllocDomain::Render)) == "render");
+}
+
+void TestSaveGameRoundTrip() {
+    Board::Rules rules;
+    rules.cols = 9;
+    rules.rows = 7;
+    rules.bombs_enabled = true;
+    Board board = NewBoard(rules, 77);
+    board.set(0, 0, kEmptyCell);
+
+    SaveHeader header;
+    header.mode = "PvP";
+    header.timestamp = 1700000000;
+    header.players = {"Ann", "Bo"};
+    SaveSession session;
+    session.player_scores = {12, 30};
+    session.blitz_turn_remaining_ms = 1500.5f;
+    SaveTournament tournament;
+    tournament.rounds = {{{0, 1, 1}}};
+    tournament.base_settings.emplace().player_names = {"Ann", "Bo"};
+
+    std::vector<std::uint8_t> bytes;
+    EncodeSaveGame(header, board, session, &tournament, bytes);
+    assert(IsBinarySave(bytes.data(), bytes.size()));
+
+    SaveGame save;
+    assert(DecodeSaveGame(bytes, save));
+    assert(save.header.mode == "PvP" && save.header.timestamp == 1700000000);
+    assert(save.header.players == header.players);
+    assert(save.session.player_scores == session.player_scores);
+    assert(save.session.blitz_turn_remaining_ms == 1500.5f);
+    assert(save.tournament && save.tournament->rounds[0][0].winner == 1);
+    assert(save.tournament->base_settings->player_names.size() == 2);
+    assert(save.board.cols() == 9 && save.board.rows() == 7 && save.board.bombsEnabled());
+    for (int c = 0; c < board.cols(); ++c) {
+        for (int r = 0; r < board.rows(); ++r) {
+            assert(save.board.get(c, r) == board.get(c, r));
+        }
+    }
+    assert(save.has_rng && save.board.randomTile() == board.randomTile());
+
+    // The summary sections precede the board, so a prefix that ends inside
+    // the tiles still describes the slot. The board section is located by its
+    // tag; its tiles start after the tag, length, dimensions and flags.
+    const std::uint8_t board_tag[] = {'B', 'O', 'R', 'D'};
+    const auto board_at = std::search(bytes.begin(), bytes.end(), std::begin(board_tag), std::end(board_tag));
+    assert(board_at != bytes.end());
+    const std::size_t inside_tiles = static_cast<std::size_t>(board_at - bytes.begin()) + 8 + 6 + 10;
+    SaveGame summary;
+    assert(DecodeSaveSummary(bytes.data(), inside_tiles, summary) == SaveRead::Ok);
+    assert(summary.header.players == header.players && summary.session.player_scores[1] == 30);
+    assert(summary.tournament && summary.board.cols() == 0);
+    assert(DecodeSaveSummary(bytes.data(), 40, summary) == SaveRead::Truncated);
+
+    // A board section with no tile types is rejected, like an empty board.
+    const std::size_t tile_types_at = static_cast<std::size_t>(board_at - bytes.begin()) + 8 + 4;
+    std::vector<std::uint8_t> no_types = bytes;
+    no_types[tile_types_at] = 0;
+    assert(!DecodeSaveGame(no_types, save));
+
+    bytes.resize(bytes.size() - 3);
+    assert(!DecodeSaveGame(bytes, save));
+
+    // Version 1 saves are msgpack'd SavePayload JSON.
+    SavePayload payload;
+    payload.mode = "PvC";
+    payload.meta["players"] = {"Ann", "Computer"};
+    payload.data["board"] = {{"cols", 3}, {"rows", 2}, {"tile_types", 4},
+                             {"cells", {{0, 1, 2}, {3, 0, 1}}}};
+    payload.data["player_scores"] = {5, 6};
+    payload.data["round_current"] = "bad type";
+    const auto legacy = payload.SerializeBinary();
+    assert(!IsBinarySave(legacy.data(), legacy.size()));
+    assert(DecodeSaveSummary(legacy.data(), legacy.size(), save) == SaveRead::Unsupported);
+    assert(DecodeSaveGame(legacy, save));
+    assert(save.header.players.size() == 2 && save.session.player_scores[1] == 6);
+    assert(save.session.round_current == 1 && !save.has_rng && !save.tournament);
+    assert(save.board.get(2, 0) == 2 && save.board.get(0, 1) == 3);
+
+    // A mistyped envelope field is ignored rather than thrown on.
+    Json malformed = payload.ToJson();
+    malformed["version"] = "one";
+    malformed["mode"] = 7;
+    const auto malformed_bytes = Json::to_msgpack(malformed);
+    assert(DecodeSaveGame(malformed_bytes, save));
+    assert(save.header.version == 1 && save.header.mode.empty() && save.board.cols() == 3);
+    malformed["data"] = "no board";
+    assert(!DecodeSaveGame(Json::to_msgpack(malformed), save));
+}
+
+void TestReplayRoundTrip() {
+    MatchRules rules;
+    rules.board.cols = 10;
+    rules.board.rows = 9;
+    rules.board.bombs_enabled = true;
+
+    // Played the way the app does it, one StepChain per animation.
+    Board board = NewBoard(rules.board, 4242);
+    ReplayRecorder recorder;
+    recorder.start(4242, rules, "PvP", {"Ann", "Bo"});
+    std::vector<int> scores(2, 0);
+    SimulationScratch scratch;
+    for (int turn = 0; turn < 30; ++turn) {
+        const auto choice = ai::BestMove(board);
+        if (!choice) {
+            break;
+        }
+        board.swapCells(choice->move);
+        CascadeTotals totals;
+        while (StepChain(board, scratch, totals)) {
+        }
+        scores[static_cast<std::size_t>(turn % 2)] += totals.score();
+        recorder.record(choice->move, turn % 2);
+    }
+    recorder.finish(board);
+    assert(!recorder.recording() && recorder.replay().final_digest == BoardDigest(board));
+
+    std::vector<std::uint8_t> bytes;
+    EncodeReplay(recorder.replay(), bytes);
+    assert(bytes.size() < 64 + recorder.replay().moves.size() * 5);
+    Replay replay;
+    assert(DecodeReplay(bytes, replay));
+    assert(replay.seed == 4242 && replay.players.size() == 2 && replay.rules.board.bombs_enabled);
+    assert(replay.moves.size() == recorder.replay().moves.size());
+
+    Board replayed;
+    const ReplayResult result = PlayReplay(replay, &replayed);
+    assert(result.ok() && result.scores == scores);
+    assert(result.moves_played == static_cast<int>(replay.moves.size()));
+    assert(BoardDigest(replayed) == BoardDigest(board));
+
+    // A swap that does not match is reported where it happens.
+    Replay prefix = replay;
+    prefix.moves.resize(3);
+    prefix.final_digest = 0;
+    Board at_third;
+    PlayReplay(prefix, &at_third);
+    for (int c = 0; c + 1 < at_third.cols(); ++c) {
+        const Move swap{{c, 0}, {c + 1, 0}};
+        if (!LegalSwapLocal(at_third, swap)) {
+            replay.moves[3].move = swap;
+            break;
+        }
+    }
+    const ReplayResult broken = PlayReplay(replay);
+    assert(broken.diverged_at == 3 && !broken.digest_matches);
+
+    bytes.resize(bytes.size() - 2);
+    assert(!DecodeReplay(bytes, replay));
+}
+
 void TestAnyLegalMovesAndAI() {
     auto board = MakeTestBoard();
     assert(AnyLegalMoves(board));
@@ -80,8 +891,25 @@ void TestAnyLegalMovesAndAI() {
 
 int main() {
     TestNewBoardNoInitialMatches();
+    TestNewBoardAlwaysPlayable();
+    TestTileStorageRange();
     TestFindAllMatches();
+    TestFindAllMatchesMatchesReference();
     TestLegalSwapAndSimulate();
+    TestScratchSimulationMatchesRecorded();
+    TestStepChainMatchesFullChain();
+    TestStepChainSkipsUntouchedColumns();
+    TestCascadeBatchMatchesSimulateFullChain();
+    TestLocalLegalSwapMatchesFullScan();
+    TestLegalMoveIndexTracksCascades();
+    TestSearchBestMove();
+    TestAsyncMoveSearch();
+    TestSelfPlayBatch();
+    TestSessionHost();
+    TestProfilerStatsAndTrace();
+    TestAllocScopesAndCounters();
+    TestSaveGameRoundTrip();
+    TestReplayRoundTrip();
     TestAnyLegalMovesAndAI();
     std::cout << "All core tests passed.\n";
     return 0;